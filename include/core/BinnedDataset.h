@@ -0,0 +1,118 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_BINNEDDATASET_H
+#define MLCPP_BINNEDDATASET_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mlcpp {
+    /**
+     * @brief Feature matrix quantized to at most 256 bins per feature.
+     *
+     * Each feature column is discretized once into uint8 bin indices using quantile
+     * bin edges, and stored column by column. Tree learners then find splits with
+     * histograms over bins instead of sorting raw values, and a single binned copy
+     * can be shared by every tree of an ensemble.
+     *
+     * A sample falls in bin b of a feature when edge[b-1] < value <= edge[b], so
+     * "bin <= b" is equivalent to "value <= get_upper_edge(feature, b)".
+     */
+    class BinnedDataset {
+    public:
+        /**
+         * @brief Default constructor. Creates an empty binned dataset.
+         */
+        BinnedDataset() = default;
+
+        /**
+         * @brief Bins a feature matrix.
+         *
+         * Bin edges are the midpoints between distinct values when a feature has at
+         * most max_bins of them, and approximate quantiles otherwise (computed on an
+         * evenly spaced sample of at most 100,000 rows). Features are binned in parallel.
+         *
+         * @param features 2D vector where each row is a sample
+         * @param max_bins Maximum number of bins per feature, between 2 and 256 (default: 256)
+         *
+         * @throws std::invalid_argument If max_bins is not between 2 and 256
+         *
+         * @note Time complexity: O(n * d * log(max_bins)) plus sorting the sample
+         *
+         * Example usage:
+         * @code
+         * BinnedDataset binned(dataset.get_features(), 64);
+         * uint8_t b = binned.get_bin(0, 10);  // Bin of feature 0 for sample 10
+         * @endcode
+         */
+        explicit BinnedDataset(const std::vector<std::vector<double>>& features, int max_bins = 256);
+
+        /**
+         * @brief Gets the bin of a sample for one feature.
+         *
+         * @param feature Feature index
+         * @param row Sample index
+         * @return Bin index
+         */
+        uint8_t get_bin(size_t feature, size_t row) const { return bins_[feature * rows_ + row]; }
+
+        /**
+         * @brief Gets the bins of all samples for one feature (column-major storage).
+         *
+         * @param feature Feature index
+         * @return Pointer to size() bin indices
+         */
+        const uint8_t* column(size_t feature) const { return bins_.data() + feature * rows_; }
+
+        /**
+         * @brief Gets the number of bins used by a feature.
+         *
+         * @param feature Feature index
+         * @return Number of bins, between 1 and max_bins
+         */
+        int num_bins(size_t feature) const { return static_cast<int>(edges_[feature].size()) + 1; }
+
+        /**
+         * @brief Gets the largest raw value that falls in a bin or below it.
+         *
+         * @param feature Feature index
+         * @param bin Bin index, lower than num_bins(feature) - 1
+         * @return Upper edge of the bin
+         */
+        double get_upper_edge(size_t feature, int bin) const { return edges_[feature][bin]; }
+
+        /**
+         * @brief Maps a raw value to its bin for one feature.
+         *
+         * @param feature Feature index
+         * @param value Raw feature value
+         * @return Bin index
+         *
+         * @note Time complexity: O(log(max_bins))
+         */
+        uint8_t bin_value(size_t feature, double value) const;
+
+        /**
+         * @brief Gets the number of samples.
+         *
+         * @return Number of rows
+         */
+        size_t size() const { return rows_; }
+
+        /**
+         * @brief Gets the number of features.
+         *
+         * @return Number of columns
+         */
+        size_t num_features() const { return edges_.size(); }
+
+    private:
+        size_t rows_ = 0;                              ///< Number of samples
+        std::vector<uint8_t> bins_;                    ///< Bin indices [features][samples]
+        std::vector<std::vector<double>> edges_;       ///< Upper bin edges [features][bins - 1]
+    };
+}
+
+#endif //MLCPP_BINNEDDATASET_H
@@ -0,0 +1,119 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_BITMATRIX_H
+#define MLCPP_BITMATRIX_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mlcpp {
+    /**
+     * @brief Bit-packed matrix for binary features such as fingerprints.
+     *
+     * Each row stores one sample with 64 features per 64-bit word, so a binary
+     * feature costs one bit instead of the 64 bits of a double in Dataset. Rows are
+     * contiguous in a single buffer, which keeps similarity scans cache friendly.
+     * Bits past num_bits() in the last word of a row are always zero.
+     */
+    class BitMatrix {
+    public:
+        /**
+         * @brief Default constructor. Creates an empty matrix.
+         */
+        BitMatrix() = default;
+
+        /**
+         * @brief Constructs a matrix with all bits cleared.
+         *
+         * @param rows Number of samples
+         * @param n_bits Number of binary features per sample
+         */
+        BitMatrix(size_t rows, size_t n_bits);
+
+        /**
+         * @brief Packs a dense feature matrix, setting the bits of values above a threshold.
+         *
+         * @param features 2D vector where each row is a sample
+         * @param threshold Values strictly greater than this become 1 (default: 0.5)
+         * @return Bit-packed matrix with the same shape
+         *
+         * Example usage:
+         * @code
+         * BitMatrix fingerprints = BitMatrix::from_features(dataset.get_features());
+         * @endcode
+         */
+        static BitMatrix from_features(const std::vector<std::vector<double>>& features,
+                                       double threshold = 0.5);
+
+        /**
+         * @brief Sets or clears one bit.
+         *
+         * @param row Sample index
+         * @param bit Feature index
+         * @param value New value of the bit
+         */
+        void set(size_t row, size_t bit, bool value) {
+            uint64_t mask = uint64_t{1} << (bit % 64);
+            uint64_t& word = bits_[row * words_per_row_ + bit / 64];
+            word = value ? (word | mask) : (word & ~mask);
+        }
+
+        /**
+         * @brief Reads one bit.
+         *
+         * @param row Sample index
+         * @param bit Feature index
+         * @return Value of the bit
+         */
+        bool get(size_t row, size_t bit) const {
+            return (bits_[row * words_per_row_ + bit / 64] >> (bit % 64)) & 1;
+        }
+
+        /**
+         * @brief Gets a pointer to the packed words of a row (read-only).
+         *
+         * @param row Sample index
+         * @return Pointer to words_per_row() words
+         */
+        const uint64_t* row(size_t row) const { return bits_.data() + row * words_per_row_; }
+
+        /**
+         * @brief Gets a pointer to the packed words of a row.
+         *
+         * @param row Sample index
+         * @return Pointer to words_per_row() words
+         */
+        uint64_t* row(size_t row) { return bits_.data() + row * words_per_row_; }
+
+        /**
+         * @brief Gets the number of samples.
+         *
+         * @return Number of rows
+         */
+        size_t size() const { return rows_; }
+
+        /**
+         * @brief Gets the number of binary features per sample.
+         *
+         * @return Number of bits per row
+         */
+        size_t num_bits() const { return n_bits_; }
+
+        /**
+         * @brief Gets the number of 64-bit words used by each row.
+         *
+         * @return Words per row
+         */
+        size_t words_per_row() const { return words_per_row_; }
+
+    private:
+        size_t rows_ = 0;                 ///< Number of samples
+        size_t n_bits_ = 0;               ///< Binary features per sample
+        size_t words_per_row_ = 0;        ///< 64-bit words per row
+        std::vector<uint64_t> bits_;      ///< Packed bits [rows * words_per_row]
+    };
+}
+
+#endif //MLCPP_BITMATRIX_H
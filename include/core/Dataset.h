@@ -12,6 +12,7 @@
 #include <random>
 #include <algorithm>
 #include <map>
+#include <utility>
 
 namespace mlcpp {
     /**
@@ -117,6 +118,9 @@ namespace mlcpp {
          * This modifies the dataset in-place. Features with zero standard deviation
          * are left unchanged.
          *
+         * @return Pair {means, std_devs} of the transform applied to each feature
+         *         (0 and 1 for features left unchanged), e.g. for LinearRegression::fold_scaler
+         *
          * @note Use this when features have different scales and you care about distribution
          * @note Less sensitive to outliers than normalize()
          * @note Time complexity: O(n * d) where n = samples, d = features
@@ -129,7 +133,7 @@ namespace mlcpp {
          * // All features now have mean=0, std=1
          * @endcode
          */
-        void standardize();
+        std::pair<std::vector<double>, std::vector<double>> standardize();
 
         /**
          * @brief Gets the feature matrix (read-only).
@@ -0,0 +1,167 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_DENSEMATRIX_H
+#define MLCPP_DENSEMATRIX_H
+#include <cstddef>
+#include <vector>
+
+namespace mlcpp {
+    /**
+     * @brief Row-major feature matrix stored in one contiguous buffer.
+     *
+     * Unlike the vector-of-rows layout of Dataset, consecutive rows sit back to back
+     * in memory, so row scans stream through a single allocation. The row kernels
+     * (row_dot, row_axpy, row_squared_norm) and the matrix-vector products have the
+     * same signatures as in SparseMatrix, so linear solvers are written once for both
+     * storage formats.
+     *
+     * Example usage:
+     * @code
+     * DenseMatrix X = DenseMatrix::from_rows(dataset.get_features());
+     * vector<double> predictions = X.multiply(weights);
+     * @endcode
+     */
+    class DenseMatrix {
+    public:
+        /**
+         * @brief Default constructor. Creates an empty matrix.
+         */
+        DenseMatrix() = default;
+
+        /**
+         * @brief Constructs a matrix filled with zeros.
+         *
+         * @param rows Number of samples
+         * @param n_features Number of features per sample
+         */
+        DenseMatrix(size_t rows, size_t n_features);
+
+        /**
+         * @brief Copies a vector-of-rows feature matrix into contiguous storage.
+         *
+         * @param features 2D vector where each row is a sample
+         * @return Matrix with the same shape
+         *
+         * @throws std::invalid_argument If the rows have different lengths
+         */
+        static DenseMatrix from_rows(const std::vector<std::vector<double>>& features);
+
+        /**
+         * @brief Gets a pointer to the values of a row (read-only).
+         *
+         * @param row Sample index
+         * @return Pointer to num_features() values
+         */
+        const double* row(size_t row) const { return values_.data() + row * n_features_; }
+
+        /**
+         * @brief Gets a pointer to the values of a row.
+         *
+         * @param row Sample index
+         * @return Pointer to num_features() values
+         */
+        double* row(size_t row) { return values_.data() + row * n_features_; }
+
+        /**
+         * @brief Computes the dot product of a row with a dense vector.
+         *
+         * @param row Sample index
+         * @param w Pointer to num_features() values
+         * @return x_row · w
+         */
+        double row_dot(size_t row, const double* w) const {
+            const double* x = this->row(row);
+            double sum = 0.0;
+            for (size_t j = 0; j < n_features_; j++) {
+                sum += x[j] * w[j];
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Adds a scaled row to a dense vector: w += a * x_row.
+         *
+         * @param row Sample index
+         * @param a Scale factor
+         * @param w Pointer to num_features() values, updated in place
+         */
+        void row_axpy(size_t row, double a, double* w) const {
+            const double* x = this->row(row);
+            for (size_t j = 0; j < n_features_; j++) {
+                w[j] += a * x[j];
+            }
+        }
+
+        /**
+         * @brief Computes the squared Euclidean norm of a row.
+         *
+         * @param row Sample index
+         * @return ||x_row||²
+         */
+        double row_squared_norm(size_t row) const { return row_dot(row, this->row(row)); }
+
+        /**
+         * @brief Computes the matrix-vector product X * w.
+         *
+         * @param w Vector of num_features() values
+         * @return Vector of size() values
+         *
+         * @throws std::invalid_argument If w has the wrong size
+         *
+         * @note Rows are processed in parallel
+         */
+        std::vector<double> multiply(const std::vector<double>& w) const;
+
+        /**
+         * @brief Computes the transposed product X^T * y without forming X^T.
+         *
+         * @param y Vector of size() values
+         * @return Vector of num_features() values
+         *
+         * @throws std::invalid_argument If y has the wrong size
+         *
+         * @note Row chunks accumulate into per-thread vectors that are summed at the end
+         */
+        std::vector<double> multiply_transpose(const std::vector<double>& y) const;
+
+        /**
+         * @brief Computes the squared norm of every column (the diagonal of X^T * W * X).
+         *
+         * @param weights Weight of each row, or empty for unit weights
+         * @return Vector of num_features() values
+         *
+         * @note Time complexity: O(rows * features / threads)
+         */
+        std::vector<double> column_squared_norms(const std::vector<double>& weights = {}) const;
+
+        /**
+         * @brief Gets the number of samples.
+         *
+         * @return Number of rows
+         */
+        size_t size() const { return rows_; }
+
+        /**
+         * @brief Gets the number of features per sample.
+         *
+         * @return Number of columns
+         */
+        size_t num_features() const { return n_features_; }
+
+        /**
+         * @brief Gets the underlying row-major buffer.
+         *
+         * @return Values [rows * features]
+         */
+        const std::vector<double>& get_values() const { return values_; }
+
+    private:
+        size_t rows_ = 0;               ///< Number of samples
+        size_t n_features_ = 0;         ///< Features per sample
+        std::vector<double> values_;    ///< Row-major values [rows * features]
+    };
+}
+
+#endif //MLCPP_DENSEMATRIX_H
@@ -80,7 +80,7 @@ namespace mlcpp {
     inline double manhattan_distance(const std::vector<double>& a, const std::vector<double>& b) {
         double sum = 0.0;
         for (size_t i = 0; i < a.size(); i++) {
-            sum += abs(a[i] - b[i]);
+            sum += std::abs(a[i] - b[i]);
         }
         return sum;
     }
@@ -112,7 +112,7 @@ namespace mlcpp {
     inline double chebyshev_distance(const std::vector<double>& a, const std::vector<double>& b) {
         double max_diff = 0.0;
         for (size_t i = 0; i < a.size(); i++) {
-            double diff = abs(a[i] - b[i]);
+            double diff = std::abs(a[i] - b[i]);
             if (diff > max_diff) {
                 max_diff = diff;
             }
@@ -154,10 +154,97 @@ namespace mlcpp {
     inline double minkowski_distance(const std::vector<double>& a, const std::vector<double>& b, double p = 2.0) {
         double sum = 0.0;
         for (size_t i = 0; i < a.size(); i++) {
-            sum += pow(abs(a[i] - b[i]), p);
+            sum += pow(std::abs(a[i] - b[i]), p);
         }
         return pow(sum, 1.0 / p);
     }
+
+    /**
+     * @brief Calculates the dot (inner) product of two vectors.
+     *
+     * Formula: sum(a_i * b_i)
+     *
+     * @param a First feature vector
+     * @param b Second feature vector
+     * @return Inner product of a and b
+     *
+     * @note Both vectors must have the same dimensionality
+     * @note Time complexity: O(d) where d is the number of dimensions
+     */
+    inline double dot_product(const std::vector<double>& a, const std::vector<double>& b) {
+        double sum = 0.0;
+        for (size_t i = 0; i < a.size(); i++) {
+            sum += a[i] * b[i];
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Calculates the cosine distance between two vectors.
+     *
+     * The cosine distance is one minus the cosine of the angle between the vectors,
+     * so it only depends on their direction, not on their magnitude.
+     *
+     * Formula: 1 - sum(a_i * b_i) / (sqrt(sum(a_i^2)) * sqrt(sum(b_i^2)))
+     *
+     * @param a First feature vector
+     * @param b Second feature vector
+     * @return Cosine distance between a and b, in the range [0, 2]
+     *
+     * @note Both vectors must have the same dimensionality
+     * @note Returns 1.0 (orthogonal) if either vector has zero norm
+     * @note Well suited to embeddings and text features
+     * @note KNN caches the training norms at fit time, so each comparison costs one dot product
+     * @note Time complexity: O(d) where d is the number of dimensions
+     *
+     * Example usage:
+     * @code
+     * vector<double> point1 = {1.0, 0.0};
+     * vector<double> point2 = {0.0, 2.0};
+     * double dist = cosine_distance(point1, point2);  // Returns 1.0
+     * @endcode
+     */
+    inline double cosine_distance(const std::vector<double>& a, const std::vector<double>& b) {
+        double dot = 0.0;
+        double norm_a = 0.0;
+        double norm_b = 0.0;
+        for (size_t i = 0; i < a.size(); i++) {
+            dot += a[i] * b[i];
+            norm_a += a[i] * a[i];
+            norm_b += b[i] * b[i];
+        }
+        if (norm_a == 0.0 || norm_b == 0.0) {
+            return 1.0;
+        }
+        return 1.0 - dot / (sqrt(norm_a) * sqrt(norm_b));
+    }
+
+    /**
+     * @brief Calculates the negative inner product between two vectors.
+     *
+     * Ranking by this value gives maximum inner product search (MIPS): the "nearest"
+     * vectors are the ones with the largest dot product with the query.
+     *
+     * Formula: -sum(a_i * b_i)
+     *
+     * @param a First feature vector
+     * @param b Second feature vector
+     * @return Negative inner product of a and b
+     *
+     * @note Both vectors must have the same dimensionality
+     * @note This is not a true distance: it can be negative and d(a,a) is not 0
+     * @note Time complexity: O(d) where d is the number of dimensions
+     *
+     * Example usage:
+     * @code
+     * vector<double> point1 = {1.0, 2.0, 3.0};
+     * vector<double> point2 = {4.0, 5.0, 6.0};
+     * double dist = inner_product_distance(point1, point2);  // Returns -32.0
+     * @endcode
+     */
+    inline double inner_product_distance(const std::vector<double>& a, const std::vector<double>& b) {
+        return -dot_product(a, b);
+    }
 }
 
 
@@ -0,0 +1,179 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_FLOAT32MATRIX_H
+#define MLCPP_FLOAT32MATRIX_H
+#include <cstddef>
+#include <vector>
+
+namespace mlcpp {
+    /**
+     * @brief Row-major feature matrix stored as 32-bit floats, with double-precision kernels.
+     *
+     * Same layout and row kernels as DenseMatrix, at half the memory: scans over the
+     * data (the matrix-vector products of the iterative solvers, the gradient and Gram
+     * passes) are bandwidth bound, so they read twice as many values per byte. Every
+     * kernel widens the values to double and accumulates in double, so the only loss
+     * is the rounding of the stored features (relative error 2⁻²⁴ ≈ 6e-8 per value);
+     * a model fitted on it differs from the double fit by about cond(X) * 6e-8.
+     *
+     * row_dot() keeps four independent partial sums, so the compiler can vectorize the
+     * float-to-double conversion and the products without reassociating additions.
+     *
+     * Example usage:
+     * @code
+     * Float32Matrix X = Float32Matrix::from_rows(dataset.get_features());
+     * LinearRegression model(0.0, 200, "lsqr");
+     * model.fit(X, y);
+     * @endcode
+     */
+    class Float32Matrix {
+    public:
+        /**
+         * @brief Default constructor. Creates an empty matrix.
+         */
+        Float32Matrix() = default;
+
+        /**
+         * @brief Constructs a matrix filled with zeros.
+         *
+         * @param rows Number of samples
+         * @param n_features Number of features per sample
+         */
+        Float32Matrix(size_t rows, size_t n_features);
+
+        /**
+         * @brief Rounds a vector-of-rows feature matrix to float into contiguous storage.
+         *
+         * @param features 2D vector where each row is a sample
+         * @return Matrix with the same shape
+         *
+         * @throws std::invalid_argument If the rows have different lengths
+         */
+        static Float32Matrix from_rows(const std::vector<std::vector<double>>& features);
+
+        /**
+         * @brief Gets a pointer to the values of a row (read-only).
+         *
+         * @param row Sample index
+         * @return Pointer to num_features() values
+         */
+        const float* row(size_t row) const { return values_.data() + row * n_features_; }
+
+        /**
+         * @brief Gets a pointer to the values of a row.
+         *
+         * @param row Sample index
+         * @return Pointer to num_features() values
+         */
+        float* row(size_t row) { return values_.data() + row * n_features_; }
+
+        /**
+         * @brief Computes the dot product of a row with a dense vector, in double.
+         *
+         * @param row Sample index
+         * @param w Pointer to num_features() values
+         * @return x_row · w
+         */
+        double row_dot(size_t row, const double* w) const {
+            const float* x = this->row(row);
+            double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+            size_t j = 0;
+            for (; j + 4 <= n_features_; j += 4) {
+                s0 += static_cast<double>(x[j]) * w[j];
+                s1 += static_cast<double>(x[j + 1]) * w[j + 1];
+                s2 += static_cast<double>(x[j + 2]) * w[j + 2];
+                s3 += static_cast<double>(x[j + 3]) * w[j + 3];
+            }
+            for (; j < n_features_; j++) {
+                s0 += static_cast<double>(x[j]) * w[j];
+            }
+            return (s0 + s1) + (s2 + s3);
+        }
+
+        /**
+         * @brief Adds a scaled row to a dense vector: w += a * x_row.
+         *
+         * @param row Sample index
+         * @param a Scale factor
+         * @param w Pointer to num_features() values, updated in place
+         */
+        void row_axpy(size_t row, double a, double* w) const {
+            const float* x = this->row(row);
+            for (size_t j = 0; j < n_features_; j++) {
+                w[j] += a * static_cast<double>(x[j]);
+            }
+        }
+
+        /**
+         * @brief Computes the squared Euclidean norm of a row, in double.
+         *
+         * @param row Sample index
+         * @return ||x_row||²
+         */
+        double row_squared_norm(size_t row) const;
+
+        /**
+         * @brief Computes the matrix-vector product X * w.
+         *
+         * @param w Vector of num_features() values
+         * @return Vector of size() values
+         *
+         * @throws std::invalid_argument If w has the wrong size
+         *
+         * @note Rows are processed in parallel
+         */
+        std::vector<double> multiply(const std::vector<double>& w) const;
+
+        /**
+         * @brief Computes the transposed product X^T * y without forming X^T.
+         *
+         * @param y Vector of size() values
+         * @return Vector of num_features() values
+         *
+         * @throws std::invalid_argument If y has the wrong size
+         *
+         * @note Row chunks accumulate into per-thread double vectors that are summed at the end
+         */
+        std::vector<double> multiply_transpose(const std::vector<double>& y) const;
+
+        /**
+         * @brief Computes the squared norm of every column (the diagonal of X^T * W * X).
+         *
+         * @param weights Weight of each row, or empty for unit weights
+         * @return Vector of num_features() values
+         *
+         * @note Time complexity: O(rows * features / threads)
+         */
+        std::vector<double> column_squared_norms(const std::vector<double>& weights = {}) const;
+
+        /**
+         * @brief Gets the number of samples.
+         *
+         * @return Number of rows
+         */
+        size_t size() const { return rows_; }
+
+        /**
+         * @brief Gets the number of features per sample.
+         *
+         * @return Number of columns
+         */
+        size_t num_features() const { return n_features_; }
+
+        /**
+         * @brief Gets the underlying row-major buffer.
+         *
+         * @return Values [rows * features]
+         */
+        const std::vector<float>& get_values() const { return values_; }
+
+    private:
+        size_t rows_ = 0;               ///< Number of samples
+        size_t n_features_ = 0;         ///< Features per sample
+        std::vector<float> values_;     ///< Row-major values [rows * features]
+    };
+}
+
+#endif //MLCPP_FLOAT32MATRIX_H
@@ -0,0 +1,218 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_LINEARALGEBRA_H
+#define MLCPP_LINEARALGEBRA_H
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include "Float32Matrix.h"
+
+namespace mlcpp {
+    /**
+     * @brief Normal-equation system ZᵀZ θ = Zᵀy of one group of rows (see LinearAlgebra::augmented_gram).
+     */
+    struct GramBlock {
+        std::vector<std::vector<double>> gram;  ///< ZᵀZ [d + 1][d + 1], full symmetric
+        std::vector<double> rhs;                ///< Zᵀy [d + 1]
+    };
+
+    /**
+     * @brief Dense linear algebra kernels shared by the models.
+     *
+     * Matrices are stored the same way as Dataset features: a vector of rows
+     * ([rows][columns]). The kernels are blocked for cache reuse and split their
+     * work across threads with parallel_for().
+     */
+    class LinearAlgebra {
+    public:
+        /**
+         * @brief Computes the matrix product C = A * B.
+         *
+         * @param A Left matrix [n][m]
+         * @param B Right matrix [m][p]
+         * @return Product matrix [n][p]
+         *
+         * @throws std::invalid_argument If the inner dimensions do not match
+         *
+         * @note Rows of A are processed in parallel; B is walked in cache-sized blocks
+         * @note Time complexity: O(n * m * p)
+         */
+        static std::vector<std::vector<double>> matmul(const std::vector<std::vector<double>>& A,
+                                                       const std::vector<std::vector<double>>& B);
+
+        /**
+         * @brief Computes the matrix product C = A^T * B without forming A^T.
+         *
+         * Both matrices share the same (usually large) number of rows, which is reduced
+         * over in parallel with one partial result per thread.
+         *
+         * @param A Left matrix [n][m]
+         * @param B Right matrix [n][p]
+         * @return Product matrix [m][p]
+         *
+         * @throws std::invalid_argument If the row counts do not match
+         *
+         * @note Time complexity: O(n * m * p)
+         */
+        static std::vector<std::vector<double>> matmul_transpose_a(const std::vector<std::vector<double>>& A,
+                                                                   const std::vector<std::vector<double>>& B);
+
+        /**
+         * @brief Orthonormalizes the columns of a matrix in place.
+         *
+         * Uses classical Gram-Schmidt with re-orthogonalization (CGS2), which is as
+         * stable as modified Gram-Schmidt but lets every projection run as one parallel
+         * pass over the rows. Columns that are numerically dependent on previous ones
+         * are set to zero.
+         *
+         * @param Y Matrix [n][l] whose columns are orthonormalized
+         *
+         * @note Time complexity: O(n * l²)
+         */
+        static void orthonormalize_columns(std::vector<std::vector<double>>& Y);
+
+        /**
+         * @brief Computes the eigen decomposition of a small symmetric matrix.
+         *
+         * Uses the cyclic Jacobi method, which is accurate for the small dense matrices
+         * produced by the randomized solvers.
+         *
+         * @param S Symmetric matrix [l][l]
+         * @return Pair {eigenvalues, eigenvectors} sorted by decreasing eigenvalue, where
+         *         eigenvectors[i] is the unit eigenvector for eigenvalues[i]
+         *
+         * @note Time complexity: O(l³) per sweep
+         */
+        static std::pair<std::vector<double>, std::vector<std::vector<double>>> symmetric_eigen(
+            std::vector<std::vector<double>> S);
+
+        /**
+         * @brief Computes the Cholesky factorization A = L * L^T of a symmetric positive definite matrix.
+         *
+         * @param A Symmetric positive definite matrix [d][d] (only the lower triangle is read)
+         * @return Lower triangular factor L [d][d]
+         *
+         * @throws std::invalid_argument If A is not square or not positive definite
+         *
+         * @note Time complexity: O(d³ / 3)
+         */
+        static std::vector<std::vector<double>> cholesky(const std::vector<std::vector<double>>& A);
+
+        /**
+         * @brief Cholesky factorization that tolerates singular matrices.
+         *
+         * Adds a tiny ridge to the diagonal entries from index first on, growing it
+         * by 1000x per attempt, until the matrix is positive definite (e.g. collinear
+         * features). Starts from 1e-12 times the mean diagonal.
+         *
+         * @param A Symmetric positive semi-definite matrix [d][d]
+         * @param first First diagonal entry that may be regularized (e.g. 1 to skip an intercept)
+         * @return Lower triangular factor L [d][d]
+         *
+         * @throws std::invalid_argument If A stays indefinite after the largest ridge
+         */
+        static std::vector<std::vector<double>> cholesky_jittered(std::vector<std::vector<double>> A,
+                                                                  size_t first = 0);
+
+        /**
+         * @brief Accumulates the normal equations of the rows z = [1, x] per group, in one pass.
+         *
+         * Row i contributes w_i z zᵀ and w_i z y_i to the block of group groups[i]
+         * (w_i = 1 without weights, giving the weighted system ZᵀWZ θ = ZᵀWy). Threads
+         * keep their own blocks, merged at the end, so the data is read once however
+         * many groups there are (e.g. one per cross-validation fold).
+         *
+         * @param X Features [samples][features]
+         * @param y Targets [samples], or empty to accumulate ZᵀZ only (rhs stays zero)
+         * @param groups Group of each row in [0, n_groups), or empty for a single group
+         * @param n_groups Number of groups (default: 1)
+         * @param weights Weight of each row, or empty for unit weights
+         * @return One block per group
+         *
+         * @throws std::invalid_argument If sizes do not match or a group is out of range
+         *
+         * @note Time complexity: O(n * d² / threads + threads * n_groups * d²)
+         */
+        static std::vector<GramBlock> augmented_gram(const std::vector<std::vector<double>>& X,
+                                                     const std::vector<double>& y,
+                                                     const std::vector<int>& groups = {},
+                                                     size_t n_groups = 1,
+                                                     const std::vector<double>& weights = {});
+
+        /**
+         * @brief Accumulates the normal equations of float32 rows z = [1, x] (single group).
+         *
+         * Each row is widened to double before its rank-one update, so the system is
+         * accumulated in double precision while the data pass reads half the bytes.
+         *
+         * @param X Features stored as floats
+         * @param y Targets [samples], or empty to accumulate ZᵀZ only
+         * @param weights Weight of each row, or empty for unit weights
+         * @return Normal equations ZᵀWZ and ZᵀWy
+         *
+         * @throws std::invalid_argument If sizes do not match
+         *
+         * @note Time complexity: O(n * d² / threads + threads * d²)
+         */
+        static GramBlock augmented_gram(const Float32Matrix& X, const std::vector<double>& y,
+                                        const std::vector<double>& weights = {});
+
+        /**
+         * @brief Solves L * x = b by forward substitution.
+         *
+         * @param L Lower triangular matrix [d][d]
+         * @param b Right-hand side [d]
+         * @return Solution x [d]
+         *
+         * @note Time complexity: O(d²)
+         */
+        static std::vector<double> solve_lower(const std::vector<std::vector<double>>& L,
+                                               const std::vector<double>& b);
+
+        /**
+         * @brief Solves L^T * x = b by back substitution, reading only L.
+         *
+         * @param L Lower triangular matrix [d][d]
+         * @param b Right-hand side [d]
+         * @return Solution x [d]
+         *
+         * @note Time complexity: O(d²)
+         */
+        static std::vector<double> solve_lower_transposed(const std::vector<std::vector<double>>& L,
+                                                          const std::vector<double>& b);
+
+        /**
+         * @brief Solves A * x = b given the Cholesky factor L of A.
+         *
+         * @param L Cholesky factor returned by cholesky()
+         * @param b Right-hand side [d]
+         * @return Solution x [d]
+         *
+         * @note Time complexity: O(d²)
+         */
+        static std::vector<double> cholesky_solve(const std::vector<std::vector<double>>& L,
+                                                  const std::vector<double>& b);
+
+        /**
+         * @brief Solves A * X = B for every column of B, given the Cholesky factor of A.
+         *
+         * Blocked triangular solves: each row update is an axpy over a block of
+         * right-hand sides, and blocks of columns are solved in parallel, so one
+         * factorization serves many targets at close to GEMM speed.
+         *
+         * @param L Lower triangular factor of A [d][d]
+         * @param B Right-hand sides [d][t]
+         * @return Solutions [d][t]
+         *
+         * @throws std::invalid_argument If B does not have d rows of equal length
+         *
+         * @note Time complexity: O(d² * t)
+         */
+        static std::vector<std::vector<double>> cholesky_solve(const std::vector<std::vector<double>>& L,
+                                                               const std::vector<std::vector<double>>& B);
+    };
+}
+
+#endif //MLCPP_LINEARALGEBRA_H
@@ -4,9 +4,76 @@
 
 #ifndef MLCPP_METRICS_H
 #define MLCPP_METRICS_H
+#include <cstddef>
 #include <vector>
 
 namespace mlcpp {
+    /**
+     * @brief Fused single-pass accumulator of the regression metrics.
+     *
+     * One pass over (y_true, y_pred) pairs collects everything MSE, RMSE, MAE and R²
+     * need (the variance of y_true is tracked with Welford's update). Accumulators of
+     * disjoint chunks can be merged, so each thread of a parallel loop keeps its own.
+     *
+     * Example usage:
+     * @code
+     * RegressionAccumulator acc;
+     * for (size_t i = 0; i < y_true.size(); i++) acc.add(y_true[i], y_pred[i]);
+     * cout << acc.mse() << " " << acc.r2() << endl;
+     * @endcode
+     */
+    struct RegressionAccumulator {
+        size_t count = 0;                   ///< Number of pairs seen
+        double sum_squared_error = 0.0;     ///< Σ(y_true - y_pred)²
+        double sum_absolute_error = 0.0;    ///< Σ|y_true - y_pred|
+        double mean_true = 0.0;             ///< Running mean of y_true
+        double m2_true = 0.0;               ///< Σ(y_true - mean)², Welford's M2
+
+        /**
+         * @brief Adds one (true, predicted) pair.
+         */
+        void add(double y_true, double y_pred);
+
+        /**
+         * @brief Merges the statistics of a disjoint set of pairs (Chan et al.).
+         */
+        void merge(const RegressionAccumulator& other);
+
+        double mse() const;     ///< Mean squared error, 0 if empty
+        double rmse() const;    ///< Root mean squared error, 0 if empty
+        double mae() const;     ///< Mean absolute error, 0 if empty
+        double r2() const;      ///< R² score, 0 if y_true is constant
+    };
+
+    /**
+     * @brief Fused single-pass accumulator of the probabilistic classification metrics.
+     *
+     * Collects accuracy and log loss from predicted class probabilities in one pass.
+     * Mergeable like RegressionAccumulator.
+     */
+    struct ClassificationAccumulator {
+        size_t count = 0;               ///< Number of samples seen
+        size_t correct = 0;             ///< Samples whose most probable class is the true one
+        double sum_log_loss = 0.0;      ///< Σ -log(p_true), probabilities clipped to [1e-15, 1]
+
+        /**
+         * @brief Adds one sample.
+         *
+         * @param true_class Index of the true class in [0, n_classes)
+         * @param proba Pointer to n_classes predicted probabilities
+         * @param n_classes Number of classes
+         */
+        void add(int true_class, const double* proba, size_t n_classes);
+
+        /**
+         * @brief Merges the statistics of a disjoint set of samples.
+         */
+        void merge(const ClassificationAccumulator& other);
+
+        double accuracy() const;    ///< Fraction of correct predictions, 0 if empty
+        double log_loss() const;    ///< Mean log loss (cross-entropy), 0 if empty
+    };
+
     /**
      * @brief Collection of evaluation metrics for machine learning models.
      *
@@ -97,6 +164,20 @@ namespace mlcpp {
         static double r2_score(const std::vector<double>& y_true,
                               const std::vector<double>& y_pred);
 
+        /**
+         * @brief Accumulates all regression metrics in a single fused pass.
+         *
+         * @param y_true True target values
+         * @param y_pred Predicted target values
+         * @return Accumulator holding MSE, RMSE, MAE and R²
+         *
+         * @throws std::invalid_argument If the sizes do not match
+         *
+         * @note Time complexity: O(n), one pass over the data
+         */
+        static RegressionAccumulator regression_report(const std::vector<double>& y_true,
+                                                       const std::vector<double>& y_pred);
+
         // ==================== CLASSIFICATION METRICS ====================
 
         /**
@@ -196,6 +277,23 @@ namespace mlcpp {
                               const std::vector<int>& y_pred,
                               int target_class);
 
+        /**
+         * @brief Calculates the log loss (cross-entropy) of predicted probabilities.
+         *
+         * LogLoss = -(1/n) * Σ log(p[i][y_true[i]])
+         *
+         * @param y_true True class indices in [0, n_classes)
+         * @param proba Predicted probabilities [samples][n_classes]
+         * @return Mean log loss
+         *
+         * @throws std::invalid_argument If the sizes do not match
+         *
+         * @note Lower is better; probabilities are clipped to [1e-15, 1]
+         * @note Time complexity: O(n * n_classes)
+         */
+        static double log_loss(const std::vector<int>& y_true,
+                               const std::vector<std::vector<double>>& proba);
+
     private:
         /**
          * @brief Calculates the mean of a vector.
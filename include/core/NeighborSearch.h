@@ -0,0 +1,215 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_NEIGHBORSEARCH_H
+#define MLCPP_NEIGHBORSEARCH_H
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "Distance.h"
+
+namespace mlcpp {
+    /**
+     * @brief Neighbor: {distance, index of the reference row}.
+     */
+    using Neighbor = std::pair<double, size_t>;
+
+    /**
+     * @brief Offers a candidate to a max-heap holding the k lowest {score, index} pairs seen so far.
+     *
+     * Scanning n candidates this way needs O(k) memory and O(n log k) time; ties are
+     * broken by the lower index, as a sort of all the pairs would.
+     *
+     * @param heap Max-heap built by earlier calls (std::push_heap order)
+     * @param k Number of pairs to keep
+     * @param candidate Pair {score, index}
+     */
+    inline void offer_neighbor(std::vector<Neighbor>& heap, size_t k, Neighbor candidate) {
+        if (heap.size() < k) {
+            heap.push_back(candidate);
+            std::push_heap(heap.begin(), heap.end());
+        } else if (k > 0 && candidate < heap.front()) {
+            std::pop_heap(heap.begin(), heap.end());
+            heap.back() = candidate;
+            std::push_heap(heap.begin(), heap.end());
+        }
+    }
+
+    /**
+     * @brief Exact brute-force k-nearest-neighbor search over a reference set.
+     *
+     * Shared engine behind KNN and the neighbor-based anomaly detectors. For the
+     * euclidean, cosine and inner product metrics, reference norms are cached at fit
+     * time and distances come from dot products; batches of queries are scored against
+     * cache-sized tiles of the reference set. Other metrics are called as given.
+     *
+     * kneighbors_graph() searches the reference set against itself in a single
+     * parallel pass, excluding each row from its own neighbor list, so algorithms
+     * that need the neighbors of every reference point (LOF, leave-one-out scoring)
+     * get them in one search.
+     *
+     * Example usage:
+     * @code
+     * NeighborSearch search(cosine_distance);
+     * search.fit(reference_rows);
+     * vector<Neighbor> nearest = search.kneighbors(query, 10);
+     * auto graph = search.kneighbors_graph(10);   // Neighbors of every reference row
+     * @endcode
+     */
+    class NeighborSearch {
+    public:
+        /**
+         * @brief Metrics with a dedicated fast path based on dot products.
+         */
+        enum class MetricKind {
+            Generic,        ///< Any other metric, called through distance_
+            Euclidean,      ///< Ranked by squared distance |q|² + |x|² - 2 q·x
+            Cosine,         ///< Ranked by 1 - q·x / (|q| |x|)
+            InnerProduct    ///< Ranked by -q·x (maximum inner product search)
+        };
+
+        /**
+         * @brief Constructs a search engine for a distance metric.
+         *
+         * @param distance Distance metric function (default: euclidean_distance)
+         *
+         * @note euclidean_distance, cosine_distance and inner_product_distance are recognized
+         *       and use the fast path with cached norms
+         */
+        explicit NeighborSearch(DistanceMetric distance = euclidean_distance);
+
+        /**
+         * @brief Stores the reference rows and caches their norms.
+         *
+         * @param X Reference rows [samples][features]
+         *
+         * @note Time complexity: O(n * d)
+         */
+        void fit(std::vector<std::vector<double>> X);
+
+        /**
+         * @brief Finds the k nearest reference rows to one query.
+         *
+         * @param query Feature vector
+         * @param k Number of neighbors
+         * @return min(k, size()) neighbors, closest first
+         *
+         * @note Time complexity: O(n * d + n log k)
+         */
+        std::vector<Neighbor> kneighbors(const std::vector<double>& query, size_t k) const;
+
+        /**
+         * @brief Finds the k nearest reference rows to every query of a batch.
+         *
+         * @param queries Query rows [queries][features]
+         * @param k Number of neighbors
+         * @return One neighbor list per query, closest first
+         *
+         * @note Blocks of queries are processed in parallel
+         */
+        std::vector<std::vector<Neighbor>> kneighbors(const std::vector<std::vector<double>>& queries,
+                                                      size_t k) const;
+
+        /**
+         * @brief Finds the k nearest other reference rows of every reference row.
+         *
+         * @param k Number of neighbors
+         * @return min(k, size() - 1) neighbors per reference row, closest first, never the row itself
+         *
+         * @note One parallel pass over all pairs: O(n² * d / threads)
+         */
+        std::vector<std::vector<Neighbor>> kneighbors_graph(size_t k) const;
+
+        /**
+         * @brief Computes the distance between two rows with the configured metric.
+         *
+         * @param a First feature vector
+         * @param b Second feature vector
+         * @return Distance on the same scale as the neighbor distances
+         */
+        double distance(const std::vector<double>& a, const std::vector<double>& b) const { return distance_(a, b); }
+
+        /**
+         * @brief Gets the reference rows.
+         *
+         * @return Rows [samples][features]
+         */
+        const std::vector<std::vector<double>>& get_data() const { return X_; }
+
+        /**
+         * @brief Gets the number of reference rows.
+         *
+         * @return Number of samples
+         */
+        size_t size() const { return X_.size(); }
+
+        /**
+         * @brief Gets the fast path recognized for the metric.
+         *
+         * @return Metric kind (Generic for metrics without a dot-product form)
+         */
+        MetricKind get_metric_kind() const { return metric_kind_; }
+
+    private:
+        DistanceMetric distance_;               ///< Distance metric function
+        MetricKind metric_kind_;                ///< Fast path selected for distance_
+        std::vector<std::vector<double>> X_;    ///< Reference rows [samples][features]
+        std::vector<double> norms_;             ///< Cached squared norms (euclidean) or norms (cosine) [samples]
+
+        /**
+         * @brief Computes the norm term cached for one row by the active fast path.
+         *
+         * @param row Feature vector
+         * @return Squared norm for euclidean, norm for cosine, 0 otherwise
+         */
+        double norm_term(const std::vector<double>& row) const;
+
+        /**
+         * @brief Converts a dot product into the ranking score of the active fast path.
+         *
+         * @param dot Dot product between the query and a reference row
+         * @param query_norm Norm term of the query (see norm_term())
+         * @param index Index of the reference row
+         * @return Score where lower means closer
+         */
+        double score_from_dot(double dot, double query_norm, size_t index) const;
+
+        /**
+         * @brief Converts a ranking score back into the value of distance_.
+         */
+        double score_to_distance(double score) const;
+
+        /**
+         * @brief Batch search shared by kneighbors() and kneighbors_graph().
+         *
+         * @param queries Query rows
+         * @param k Number of neighbors
+         * @param exclude_self Whether query i is reference row i and must not be its own neighbor
+         *
+         * @note Each query keeps a max-heap of its k best candidates: O(n log k) time and O(k) memory per query
+         */
+        std::vector<std::vector<Neighbor>> search(const std::vector<std::vector<double>>& queries,
+                                                  size_t k, bool exclude_self) const;
+
+        /**
+         * @brief Keeps the k lowest scores and converts them to distances.
+         *
+         * @param scored Pairs {score, reference index}; reordered in place
+         * @param k Number of neighbors
+         * @return Neighbors, closest first
+         *
+         * @note Time complexity: O(n log k) using partial_sort
+         */
+        std::vector<Neighbor> select(std::vector<Neighbor>& scored, size_t k) const;
+
+        /**
+         * @brief Sorts a candidate heap closest first and converts its scores to distances.
+         *
+         * @param heap Max-heap of {score, reference index} pairs built by search(); replaced by the result
+         */
+        void finish(std::vector<Neighbor>& heap) const;
+    };
+}
+
+#endif //MLCPP_NEIGHBORSEARCH_H
@@ -0,0 +1,102 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_PARALLEL_H
+#define MLCPP_PARALLEL_H
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace mlcpp {
+    /**
+     * @brief Gets the number of worker threads used by parallel_for().
+     *
+     * @return Number of hardware threads, or 1 if it cannot be determined
+     */
+    inline size_t num_threads() {
+        unsigned int n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+
+    /**
+     * @brief Runs a function over the range [0, n) split into contiguous chunks, one per thread.
+     *
+     * The function receives a half-open sub-range [begin, end) and the index of the
+     * chunk, so callers can keep per-thread accumulators and merge them afterwards.
+     * Small ranges run on the calling thread to avoid the cost of spawning threads.
+     *
+     * @param n Size of the range
+     * @param fn Callable with signature void(size_t begin, size_t end, size_t chunk)
+     * @param min_chunk Minimum number of elements per chunk (default: 1024)
+     * @return Number of chunks used (chunk indices are in [0, return value))
+     *
+     * @note Chunks never overlap, so writes to disjoint output slots need no locking
+     * @note If fn throws, every chunk still runs to completion and all threads are joined
+     *       before the first exception (lowest chunk index) is rethrown to the caller
+     *
+     * Example usage:
+     * @code
+     * vector<double> partial(num_threads(), 0.0);
+     * parallel_for(values.size(), [&](size_t begin, size_t end, size_t chunk) {
+     *     for (size_t i = begin; i < end; i++) {
+     *         partial[chunk] += values[i];
+     *     }
+     * });
+     * @endcode
+     */
+    template<typename Fn>
+    size_t parallel_for(size_t n, Fn fn, size_t min_chunk = 1024) {
+        if (n == 0) {
+            return 0;
+        }
+        size_t max_chunks = (n + min_chunk - 1) / std::max<size_t>(min_chunk, 1);
+        size_t chunks = std::min(num_threads(), std::max<size_t>(max_chunks, 1));
+        if (chunks <= 1) {
+            fn(static_cast<size_t>(0), n, static_cast<size_t>(0));
+            return 1;
+        }
+
+        // An exception must not escape a worker (std::terminate) or skip the joins below
+        std::vector<std::exception_ptr> errors(chunks);
+        auto run = [&fn, &errors](size_t begin, size_t end, size_t chunk) {
+            try {
+                fn(begin, end, chunk);
+            } catch (...) {
+                errors[chunk] = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> workers;
+        workers.reserve(chunks - 1);
+        size_t step = (n + chunks - 1) / chunks;
+        for (size_t c = 1; c < chunks; c++) {
+            size_t begin = c * step;
+            size_t end = std::min(n, begin + step);
+            if (begin >= end) {
+                break;
+            }
+            try {
+                workers.emplace_back(run, begin, end, c);
+            } catch (const std::system_error &) {
+                run(begin, end, c);  // No thread available: run the chunk here
+            }
+        }
+        // The calling thread works on the first chunk
+        run(static_cast<size_t>(0), std::min(n, step), static_cast<size_t>(0));
+        for (auto &worker: workers) {
+            worker.join();
+        }
+        for (const std::exception_ptr &error: errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        return chunks;
+    }
+}
+
+#endif //MLCPP_PARALLEL_H
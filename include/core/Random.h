@@ -0,0 +1,121 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_RANDOM_H
+#define MLCPP_RANDOM_H
+#include <cstddef>
+#include <cstdint>
+
+namespace mlcpp {
+    /**
+     * @brief Counter-based random number generator.
+     *
+     * Every value is a pure function of (seed, counter), computed with the SplitMix64
+     * finalizer. Any position of the stream can be generated directly with at(), so
+     * large random matrices can be regenerated on demand instead of stored, and
+     * parallel workers can draw from disjoint counter ranges without sharing state.
+     * The whole generator state is the pair (seed, counter).
+     *
+     * Example usage:
+     * @code
+     * CounterRng rng(42);
+     * double u = rng.uniform();                   // Sequential use
+     * uint64_t r = CounterRng::at(42, 1000000);   // Random access to the same stream
+     * @endcode
+     */
+    class CounterRng {
+    public:
+        /**
+         * @brief Constructs a generator at a given position of a stream.
+         *
+         * @param seed Stream identifier (default: 41)
+         * @param counter Position in the stream (default: 0)
+         */
+        explicit CounterRng(uint64_t seed = 41, uint64_t counter = 0) : seed_(seed), counter_(counter) {}
+
+        /**
+         * @brief Generates the value at a given position of a stream.
+         *
+         * @param seed Stream identifier
+         * @param counter Position in the stream
+         * @return 64 uniformly distributed random bits
+         *
+         * @note Time complexity: O(1), independent of the position
+         */
+        static uint64_t at(uint64_t seed, uint64_t counter) {
+            return mix(seed ^ mix(counter + 0x9E3779B97F4A7C15ULL));
+        }
+
+        /**
+         * @brief Converts 64 random bits to a double uniformly distributed in [0, 1).
+         *
+         * @param bits Random bits
+         * @return Uniform value in [0, 1)
+         */
+        static double to_uniform(uint64_t bits) {
+            return static_cast<double>(bits >> 11) * 0x1.0p-53;
+        }
+
+        /**
+         * @brief Generates the next 64 random bits and advances the counter.
+         *
+         * @return 64 uniformly distributed random bits
+         */
+        uint64_t next() {
+            return at(seed_, counter_++);
+        }
+
+        /**
+         * @brief Generates the next double uniformly distributed in [0, 1).
+         *
+         * @return Uniform value in [0, 1)
+         */
+        double uniform() {
+            return to_uniform(next());
+        }
+
+        /**
+         * @brief Generates the next integer uniformly distributed in [0, n).
+         *
+         * @param n Upper bound (exclusive), must be positive
+         * @return Uniform index in [0, n)
+         */
+        size_t uniform_index(size_t n) {
+            // Modulo bias is negligible for n << 2^64
+            return static_cast<size_t>(next() % n);
+        }
+
+        /**
+         * @brief Gets the stream identifier.
+         *
+         * @return The seed value
+         */
+        uint64_t get_seed() const { return seed_; }
+
+        /**
+         * @brief Gets the current position in the stream.
+         *
+         * @return The counter value
+         */
+        uint64_t get_counter() const { return counter_; }
+
+    private:
+        uint64_t seed_;       ///< Stream identifier
+        uint64_t counter_;    ///< Position in the stream
+
+        /**
+         * @brief SplitMix64 finalizer: a bijective 64-bit mixing function.
+         *
+         * @param x Input bits
+         * @return Mixed bits
+         */
+        static uint64_t mix(uint64_t x) {
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+            return x ^ (x >> 31);
+        }
+    };
+}
+
+#endif //MLCPP_RANDOM_H
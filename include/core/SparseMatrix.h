@@ -0,0 +1,187 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_SPARSEMATRIX_H
+#define MLCPP_SPARSEMATRIX_H
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace mlcpp {
+    /**
+     * @brief Sparse feature matrix in compressed sparse row (CSR) format.
+     *
+     * Row r holds the pairs (indices[k], values[k]) for k in [indptr[r], indptr[r + 1]),
+     * so memory and row scans cost O(non-zeros) instead of O(rows * features). This
+     * suits bag-of-words, one-hot and hashed features with millions of rows.
+     *
+     * The row kernels (row_dot, row_axpy, row_squared_norm) and the matrix-vector
+     * products have the same signatures as in DenseMatrix, so linear solvers are
+     * written once for both storage formats.
+     *
+     * Example usage:
+     * @code
+     * SparseMatrix X(rows, n_features, indptr, indices, values);
+     * vector<double> scores = X.multiply(weights);
+     * @endcode
+     */
+    class SparseMatrix {
+    public:
+        /**
+         * @brief Default constructor. Creates an empty matrix.
+         */
+        SparseMatrix() = default;
+
+        /**
+         * @brief Constructs a matrix from CSR arrays.
+         *
+         * @param rows Number of samples
+         * @param n_features Number of features per sample
+         * @param indptr Row offsets [rows + 1], starting at 0 and non-decreasing
+         * @param indices Feature index of each stored value [non-zeros]
+         * @param values Stored values [non-zeros]
+         *
+         * @throws std::invalid_argument If the arrays are inconsistent or an index is out of range
+         */
+        SparseMatrix(size_t rows, size_t n_features, std::vector<size_t> indptr,
+                     std::vector<uint32_t> indices, std::vector<double> values);
+
+        /**
+         * @brief Compresses a dense feature matrix, keeping only the non-zero values.
+         *
+         * @param features 2D vector where each row is a sample
+         * @return Matrix with the same shape
+         *
+         * @throws std::invalid_argument If the rows have different lengths
+         */
+        static SparseMatrix from_dense(const std::vector<std::vector<double>>& features);
+
+        /**
+         * @brief Computes the dot product of a row with a dense vector.
+         *
+         * @param row Sample index
+         * @param w Pointer to num_features() values
+         * @return x_row · w
+         */
+        double row_dot(size_t row, const double* w) const {
+            double sum = 0.0;
+            for (size_t k = indptr_[row]; k < indptr_[row + 1]; k++) {
+                sum += values_[k] * w[indices_[k]];
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Adds a scaled row to a dense vector: w += a * x_row.
+         *
+         * @param row Sample index
+         * @param a Scale factor
+         * @param w Pointer to num_features() values, updated in place
+         */
+        void row_axpy(size_t row, double a, double* w) const {
+            for (size_t k = indptr_[row]; k < indptr_[row + 1]; k++) {
+                w[indices_[k]] += a * values_[k];
+            }
+        }
+
+        /**
+         * @brief Computes the squared Euclidean norm of a row.
+         *
+         * @param row Sample index
+         * @return ||x_row||²
+         */
+        double row_squared_norm(size_t row) const {
+            double sum = 0.0;
+            for (size_t k = indptr_[row]; k < indptr_[row + 1]; k++) {
+                sum += values_[k] * values_[k];
+            }
+            return sum;
+        }
+
+        /**
+         * @brief Computes the matrix-vector product X * w.
+         *
+         * @param w Vector of num_features() values
+         * @return Vector of size() values
+         *
+         * @throws std::invalid_argument If w has the wrong size
+         *
+         * @note Time complexity: O(non-zeros / threads)
+         */
+        std::vector<double> multiply(const std::vector<double>& w) const;
+
+        /**
+         * @brief Computes the transposed product X^T * y without forming X^T.
+         *
+         * @param y Vector of size() values
+         * @return Vector of num_features() values
+         *
+         * @throws std::invalid_argument If y has the wrong size
+         *
+         * @note Row chunks scatter into per-thread vectors that are summed at the end
+         */
+        std::vector<double> multiply_transpose(const std::vector<double>& y) const;
+
+        /**
+         * @brief Computes the squared norm of every column (the diagonal of X^T * W * X).
+         *
+         * @param weights Weight of each row, or empty for unit weights
+         * @return Vector of num_features() values
+         *
+         * @note Time complexity: O(non-zeros / threads)
+         */
+        std::vector<double> column_squared_norms(const std::vector<double>& weights = {}) const;
+
+        /**
+         * @brief Gets the number of samples.
+         *
+         * @return Number of rows
+         */
+        size_t size() const { return rows_; }
+
+        /**
+         * @brief Gets the number of features per sample.
+         *
+         * @return Number of columns
+         */
+        size_t num_features() const { return n_features_; }
+
+        /**
+         * @brief Gets the number of stored values.
+         *
+         * @return Non-zero count
+         */
+        size_t nnz() const { return values_.size(); }
+
+        /**
+         * @brief Gets the row offsets.
+         *
+         * @return indptr [rows + 1]
+         */
+        const std::vector<size_t>& get_indptr() const { return indptr_; }
+
+        /**
+         * @brief Gets the feature index of each stored value.
+         *
+         * @return indices [non-zeros]
+         */
+        const std::vector<uint32_t>& get_indices() const { return indices_; }
+
+        /**
+         * @brief Gets the stored values.
+         *
+         * @return values [non-zeros]
+         */
+        const std::vector<double>& get_values() const { return values_; }
+
+    private:
+        size_t rows_ = 0;                   ///< Number of samples
+        size_t n_features_ = 0;             ///< Features per sample
+        std::vector<size_t> indptr_ = {0};  ///< Row offsets [rows + 1]
+        std::vector<uint32_t> indices_;     ///< Feature indices [non-zeros]
+        std::vector<double> values_;        ///< Stored values [non-zeros]
+    };
+}
+
+#endif //MLCPP_SPARSEMATRIX_H
@@ -0,0 +1,119 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_CHECKPOINT_H
+#define MLCPP_CHECKPOINT_H
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace mlcpp {
+    /**
+     * @brief Snapshot of an iterative training run, enough to continue it after a restart.
+     */
+    struct TrainingState {
+        uint32_t model = 0;                 ///< Tag of the model that wrote the state
+        uint64_t epoch = 0;                 ///< Completed epochs
+        uint64_t rng_counter = 0;           ///< Position in the model's CounterRng stream (0 if unused)
+        std::vector<double> parameters;     ///< Model parameters, in a model-specific layout
+        std::vector<double> optimizer;      ///< Optimizer buffers such as momentum (empty if unused)
+    };
+
+    /**
+     * @brief Writes training checkpoints in the background.
+     *
+     * submit() only copies the state into a pending slot and returns, so the training
+     * loop never waits on the disk. A single writer thread saves the most recent
+     * submitted state; states submitted while a write is in progress replace each
+     * other, so a slow disk costs skipped snapshots rather than stalls.
+     *
+     * Files are compact native-endian binaries: a fixed header, both arrays and a
+     * checksum of everything before it. Each write goes to "<path>.tmp", is synced to
+     * disk and renamed over path, and the directory is synced after the rename, so a
+     * process killed or a machine crashing mid-write leaves the previous checkpoint intact.
+     *
+     * Example usage:
+     * @code
+     * CheckpointWriter writer("train.ckpt");
+     * for (uint64_t epoch = 0; epoch < epochs; epoch++) {
+     *     step();
+     *     if (epoch % 100 == 0) writer.submit({tag, epoch + 1, 0, parameters, {}});
+     * }
+     * writer.flush();
+     *
+     * std::optional<TrainingState> state = CheckpointWriter::read("train.ckpt");
+     * @endcode
+     */
+    class CheckpointWriter {
+    public:
+        /**
+         * @brief Creates a writer for a checkpoint file. No thread is started until the first submit().
+         *
+         * @param path Checkpoint file path
+         */
+        explicit CheckpointWriter(std::string path);
+
+        /**
+         * @brief Writes the pending state, if any, and stops the writer thread.
+         */
+        ~CheckpointWriter();
+
+        CheckpointWriter(const CheckpointWriter&) = delete;
+        CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+        /**
+         * @brief Queues a state for writing without waiting for the disk.
+         *
+         * @param state Snapshot to save; replaces any state not yet being written
+         *
+         * @note Time complexity: O(1) beyond moving the state
+         */
+        void submit(TrainingState state);
+
+        /**
+         * @brief Waits until every submitted state has been handled.
+         *
+         * @return true if the last write succeeded (or nothing was submitted)
+         */
+        bool flush();
+
+        /**
+         * @brief Writes a state synchronously (synced temporary file, rename, synced directory).
+         *
+         * @param state Snapshot to save
+         * @param path Checkpoint file path
+         * @return true on success
+         */
+        static bool write(const TrainingState& state, const std::string& path);
+
+        /**
+         * @brief Reads a checkpoint written by write() or a CheckpointWriter.
+         *
+         * @param path Checkpoint file path
+         * @return Optional state. Returns empty optional if the file is missing, truncated or corrupt.
+         */
+        static std::optional<TrainingState> read(const std::string& path);
+
+    private:
+        std::string path_;                      ///< Checkpoint file path
+        std::thread worker_;                    ///< Writer thread, started by the first submit()
+        std::mutex mutex_;                      ///< Guards the fields below
+        std::condition_variable changed_;       ///< Signals a new state, a finished write or stop
+        std::optional<TrainingState> pending_;  ///< Latest state not yet being written
+        bool writing_ = false;                  ///< Whether the worker is writing a state
+        bool stop_ = false;                     ///< Whether the worker should exit once idle
+        bool last_ok_ = true;                   ///< Result of the last write
+
+        /**
+         * @brief Writer thread loop: takes the pending state and writes it until stopped.
+         */
+        void run();
+    };
+}
+
+#endif //MLCPP_CHECKPOINT_H
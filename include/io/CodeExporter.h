@@ -0,0 +1,126 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_CODEEXPORTER_H
+#define MLCPP_CODEEXPORTER_H
+#include <string>
+#include "../supervised/DecisionTree.h"
+#include "../supervised/KNN.h"
+#include "../supervised/LinearRegression.h"
+
+namespace mlcpp {
+    /**
+     * @brief Exports trained models as self-contained C++ headers for inference without the library.
+     *
+     * Each export returns the text of a header that depends only on <cstddef> (and <cmath>
+     * for cosine KNN). The model lives in a namespace of the given name as constexpr
+     * arrays, and predict() takes a pointer to the raw feature values. Because the
+     * feature count and every parameter are compile-time constants, the compiler can
+     * inline and specialize the whole inference for the deployed model:
+     * - LinearRegression: weight array and a dot product with four independent partial
+     *   sums, so the loop vectorizes without reassociating floating-point additions;
+     * - DecisionTreeRegressor / DecisionTreeClassifier: the tree unrolled into nested
+     *   if/else branches, with no node array to walk;
+     * - KNN: the reference rows, their cached norms and labels as constexpr arrays, with
+     *   the same dot-product ranking and majority vote as NeighborSearch and KNN.
+     *
+     * Values are written with 17 significant digits, so the exported model predicts
+     * the same as the trained one up to the order of floating-point additions.
+     *
+     * Example usage:
+     * @code
+     * LinearRegression model;
+     * model.fit(X_train, y_train);
+     * CodeExporter::save(CodeExporter::export_model(model, "price_model"), "price_model.h");
+     *
+     * // On the device, without mlcpp:
+     * #include "price_model.h"
+     * double price = price_model::predict(features);
+     * @endcode
+     */
+    class CodeExporter {
+    public:
+        /**
+         * @brief Exports a linear regression model.
+         *
+         * Single-target models get `double predict(const double* x)`; multi-output models
+         * (fit with a target matrix) get `void predict(const double* x, double* out)`
+         * writing n_targets values.
+         *
+         * @param model Fitted model
+         * @param name Namespace of the generated code (a C++ identifier)
+         * @return Header source
+         *
+         * @throws std::logic_error If the model is not fitted
+         * @throws std::invalid_argument If name is not an identifier or a parameter is not finite
+         *
+         * @note Time complexity: O(d * targets)
+         */
+        static std::string export_model(const LinearRegression& model, const std::string& name);
+
+        /**
+         * @brief Exports a regression tree as nested branches returning the leaf values.
+         *
+         * Generates `double predict(const double* x)`.
+         *
+         * @param model Fitted tree
+         * @param name Namespace of the generated code (a C++ identifier)
+         * @return Header source
+         *
+         * @throws std::logic_error If the tree is not fitted
+         * @throws std::invalid_argument If name is not an identifier or a value is not finite
+         *
+         * @note Time complexity: O(nodes)
+         */
+        static std::string export_model(const DecisionTreeRegressor& model, const std::string& name);
+
+        /**
+         * @brief Exports a classification tree as nested branches selecting a leaf.
+         *
+         * Generates `const double* predict_proba(const double* x)` (n_classes values,
+         * ordered as classes[]) and `int predict(const double* x)`.
+         *
+         * @param model Fitted tree
+         * @param name Namespace of the generated code (a C++ identifier)
+         * @return Header source
+         *
+         * @throws std::logic_error If the tree is not fitted
+         * @throws std::invalid_argument If name is not an identifier or a value is not finite
+         *
+         * @note Time complexity: O(nodes + leaves * classes)
+         */
+        static std::string export_model(const DecisionTreeClassifier& model, const std::string& name);
+
+        /**
+         * @brief Exports a KNN classifier with its reference set.
+         *
+         * Generates `int predict(const double* x)`, a brute-force scan of the constexpr
+         * reference rows. Meant for small (e.g. prototype-reduced) reference sets, since
+         * the rows are compiled into the binary.
+         *
+         * @param model Fitted model using euclidean_distance, cosine_distance or
+         *              inner_product_distance on dense features
+         * @param name Namespace of the generated code (a C++ identifier)
+         * @return Header source
+         *
+         * @throws std::logic_error If the model is not fitted on dense features
+         * @throws std::invalid_argument If name is not an identifier, k < 1, the metric has
+         *                               no dot-product form, the model is Mahalanobis, or a value is not finite
+         *
+         * @note Time complexity: O(n * d)
+         */
+        static std::string export_model(const KNN& model, const std::string& name);
+
+        /**
+         * @brief Writes generated source to a file.
+         *
+         * @param source Header source returned by export_model()
+         * @param path Output file path
+         * @return true on success
+         */
+        static bool save(const std::string& source, const std::string& path);
+    };
+}
+
+#endif //MLCPP_CODEEXPORTER_H
@@ -0,0 +1,120 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_MAHALANOBISWHITENING_H
+#define MLCPP_MAHALANOBISWHITENING_H
+#include <vector>
+#include "../core/Dataset.h"
+
+namespace mlcpp {
+    /**
+     * @brief Whitening transform that turns Mahalanobis distance into Euclidean distance.
+     *
+     * Estimates the feature covariance S in a single parallel pass, factors it once
+     * as S = L * L^T (Cholesky) and maps each sample to z = L^-1 * (x - mean). Then
+     *
+     * mahalanobis(a, b)² = (a - b)^T * S^-1 * (a - b) = |z_a - z_b|²
+     *
+     * so every pairwise distance afterwards costs the same as a Euclidean one, instead
+     * of O(d²) with the inverse covariance.
+     */
+    class MahalanobisWhitening {
+    public:
+        /**
+         * @brief Constructs a whitening transform.
+         *
+         * @param regularization Ridge added to the covariance diagonal, relative to the
+         *                       average feature variance (default: 1e-9)
+         *
+         * @note Increase regularization when features are (nearly) collinear
+         */
+        explicit MahalanobisWhitening(double regularization = 1e-9);
+
+        /**
+         * @brief Estimates the mean and covariance and factors the covariance.
+         *
+         * Each thread accumulates the mean and co-moment matrix of its rows, and the
+         * partial results are merged with the pairwise update of Chan et al.
+         *
+         * @param X Training features [samples][features]
+         *
+         * @throws std::invalid_argument If X has fewer than 2 samples or the covariance
+         *                               is not positive definite after regularization
+         *
+         * @note Time complexity: O(n * d² + d³)
+         */
+        void fit(const std::vector<std::vector<double>>& X);
+
+        /**
+         * @brief Fits the transform on the features of a dataset.
+         *
+         * @param dataset Dataset whose features are used
+         */
+        void fit(const Dataset& dataset);
+
+        /**
+         * @brief Whitens a single sample.
+         *
+         * @param sample Feature vector
+         * @return Whitened vector L^-1 * (sample - mean)
+         *
+         * @throws std::invalid_argument If the sample has a different number of features than the training data
+         *
+         * @note Time complexity: O(d²)
+         */
+        std::vector<double> transform(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Whitens multiple samples in parallel.
+         *
+         * @param X Features [samples][features]
+         * @return Whitened features [samples][features]
+         *
+         * @throws std::invalid_argument If a sample has a different number of features than the training data
+         */
+        std::vector<std::vector<double>> transform(const std::vector<std::vector<double>>& X) const;
+
+        /**
+         * @brief Whitens the features of a dataset, keeping its labels.
+         *
+         * @param dataset Dataset to transform
+         * @return New dataset with whitened features
+         */
+        Dataset transform(const Dataset& dataset) const;
+
+        /**
+         * @brief Calculates the Mahalanobis distance between two raw samples.
+         *
+         * @param a First feature vector
+         * @param b Second feature vector
+         * @return Mahalanobis distance under the fitted covariance
+         *
+         * @throws std::invalid_argument If either sample has a different number of features than the training data
+         *
+         * @note O(d²) per call; whiten once and use euclidean_distance for repeated comparisons
+         */
+        double distance(const std::vector<double>& a, const std::vector<double>& b) const;
+
+        /**
+         * @brief Gets the per-feature mean.
+         *
+         * @return Mean vector [features]
+         */
+        const std::vector<double>& get_mean() const { return mean_; }
+
+        /**
+         * @brief Gets the Cholesky factor of the (regularized) covariance.
+         *
+         * @return Lower triangular matrix L [features][features]
+         */
+        const std::vector<std::vector<double>>& get_cholesky_factor() const { return cholesky_; }
+
+    private:
+        double regularization_;                        ///< Relative ridge on the covariance diagonal
+        std::vector<double> mean_;                     ///< Per-feature mean [features]
+        std::vector<std::vector<double>> cholesky_;    ///< Cholesky factor L of the covariance
+    };
+}
+
+#endif //MLCPP_MAHALANOBISWHITENING_H
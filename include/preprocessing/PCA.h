@@ -0,0 +1,204 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_PCA_H
+#define MLCPP_PCA_H
+#include <vector>
+#include "../core/Dataset.h"
+
+namespace mlcpp {
+    /**
+     * @brief Principal Component Analysis (PCA) transformer for dimensionality reduction.
+     *
+     * Projects samples onto the directions of maximum variance. The batch fit uses a
+     * randomized SVD: a random sketch of the data is refined with power iterations,
+     * so only a few passes over the (implicitly centered) data are needed and the
+     * expensive steps are blocked, parallel matrix products. partial_fit() offers an
+     * incremental variant for data that does not fit in memory.
+     *
+     * @note Projecting wide features to a few dozen components before KNN reduces the
+     *       cost of every distance computation proportionally
+     */
+    class PCA {
+    public:
+        /**
+         * @brief Constructs a PCA transformer with the given parameters.
+         *
+         * @param n_components Number of principal components to keep (default: 2)
+         * @param n_power_iterations Number of power iterations of the randomized solver (default: 4)
+         * @param n_oversamples Extra random directions sampled beyond n_components (default: 10)
+         * @param seed Random seed for reproducibility (default: 41)
+         *
+         * @note More power iterations give more accurate components when the spectrum decays slowly
+         *
+         * Example usage:
+         * @code
+         * PCA pca(32);                 // Keep 32 components
+         * PCA precise(32, 7, 20);      // More iterations and oversampling
+         * @endcode
+         */
+        explicit PCA(int n_components = 2,
+                     int n_power_iterations = 4,
+                     int n_oversamples = 10,
+                     int seed = 41);
+
+        /**
+         * @brief Fits the components using randomized SVD.
+         *
+         * Any previously fitted state (including partial_fit progress) is discarded.
+         *
+         * @param X Training features [samples][features]
+         *
+         * @throws std::invalid_argument If X is empty or n_components is not positive
+         *
+         * @note Time complexity: O(n * d * (n_components + n_oversamples) * n_power_iterations)
+         *
+         * Example usage:
+         * @code
+         * PCA pca(32);
+         * pca.fit(train.get_features());
+         * @endcode
+         */
+        void fit(const std::vector<std::vector<double>>& X);
+
+        /**
+         * @brief Fits the components on the features of a dataset.
+         *
+         * @param dataset Dataset whose features are used (labels are ignored)
+         */
+        void fit(const Dataset& dataset);
+
+        /**
+         * @brief Updates the components with a new batch of samples (incremental PCA).
+         *
+         * Merges the current components, scaled by their singular values, with the
+         * centered batch and a mean-correction row, and keeps the leading singular
+         * vectors of that small matrix. Memory use depends only on the batch size.
+         *
+         * @param X_batch Batch of samples [batch_size][features]
+         *
+         * @throws std::invalid_argument If the batch has a different number of features
+         *
+         * @note Batches should have at least n_components samples for good accuracy
+         * @note Time complexity: O((k + b)² * d) per batch, where b = batch size, k = n_components
+         *
+         * Example usage:
+         * @code
+         * PCA pca(32);
+         * for (const auto& batch : batches) {
+         *     pca.partial_fit(batch);
+         * }
+         * @endcode
+         */
+        void partial_fit(const std::vector<std::vector<double>>& X_batch);
+
+        /**
+         * @brief Projects a single sample onto the principal components.
+         *
+         * @param sample Feature vector
+         * @return Projected vector [n_components]
+         *
+         * @throws std::invalid_argument If the sample has a different number of features than the fitted data
+         */
+        std::vector<double> transform(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Projects multiple samples onto the principal components.
+         *
+         * @param X Features [samples][features]
+         * @return Projected features [samples][n_components]
+         *
+         * @throws std::invalid_argument If the samples have a different number of features than the fitted data
+         *
+         * @note Time complexity: O(n * d * n_components)
+         */
+        std::vector<std::vector<double>> transform(const std::vector<std::vector<double>>& X) const;
+
+        /**
+         * @brief Projects the features of a dataset, keeping its labels.
+         *
+         * @param dataset Dataset to transform
+         * @return New dataset with n_components features per sample
+         *
+         * Example usage:
+         * @code
+         * PCA pca(32);
+         * pca.fit(train);
+         * KNN model(5);
+         * Dataset reduced_train = pca.transform(train);
+         * model.fit(reduced_train);
+         * double accuracy = model.score(pca.transform(test));
+         * @endcode
+         */
+        Dataset transform(const Dataset& dataset) const;
+
+        /**
+         * @brief Fits the components and transforms the dataset.
+         *
+         * @param dataset Dataset to fit and transform
+         * @return New dataset with n_components features per sample
+         */
+        Dataset fit_transform(const Dataset& dataset);
+
+        /**
+         * @brief Gets the principal components.
+         *
+         * @return Components [n_components][features], sorted by decreasing variance
+         */
+        const std::vector<std::vector<double>>& get_components() const { return components_; }
+
+        /**
+         * @brief Gets the variance explained by each component.
+         *
+         * @return Explained variance [n_components]
+         */
+        std::vector<double> get_explained_variance() const;
+
+        /**
+         * @brief Gets the fraction of the total variance explained by each component.
+         *
+         * @return Explained variance ratio [n_components], each between 0.0 and 1.0
+         */
+        std::vector<double> get_explained_variance_ratio() const;
+
+        /**
+         * @brief Gets the per-feature mean subtracted before projecting.
+         *
+         * @return Mean vector [features]
+         */
+        const std::vector<double>& get_mean() const { return mean_; }
+
+        /**
+         * @brief Gets the number of components kept.
+         *
+         * @return The n_components value
+         */
+        int get_n_components() const { return n_components_; }
+
+    private:
+        int n_components_;                              ///< Number of components to keep
+        int n_power_iterations_;                        ///< Power iterations of the randomized solver
+        int n_oversamples_;                             ///< Extra sketch directions
+        int seed_;                                      ///< Random seed
+        size_t n_samples_seen_ = 0;                     ///< Samples used so far
+        std::vector<double> mean_;                      ///< Per-feature mean [features]
+        std::vector<double> squared_deviations_;        ///< Per-feature sum of squared deviations [features]
+        std::vector<std::vector<double>> components_;   ///< Principal axes [n_components][features]
+        std::vector<double> singular_values_;           ///< Singular values of the centered data [n_components]
+
+        /**
+         * @brief Keeps the top right singular vectors of a small row matrix.
+         *
+         * Computes the SVD of M through the eigen decomposition of M * M^T and stores
+         * the leading n_components right singular vectors and singular values.
+         *
+         * @param M Matrix [r][features] with few rows
+         *
+         * @note Time complexity: O(r² * d + r³)
+         */
+        void set_components_from_rows(const std::vector<std::vector<double>>& M);
+    };
+}
+
+#endif //MLCPP_PCA_H
@@ -0,0 +1,161 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_SPARSERANDOMPROJECTION_H
+#define MLCPP_SPARSERANDOMPROJECTION_H
+#include <utility>
+#include <vector>
+#include "../core/Dataset.h"
+
+namespace mlcpp {
+    /**
+     * @brief Sparse random projection transformer for fast dimensionality reduction.
+     *
+     * Projects samples with a sparse random matrix whose entries are
+     * +sqrt(1 / (density * n_components)), 0 or -sqrt(1 / (density * n_components)),
+     * which preserves pairwise distances up to a factor (1 ± eps) with high probability
+     * (Johnson-Lindenstrauss lemma; Li, Hastie & Church, 2006).
+     *
+     * The projection matrix is never stored: the non-zeros of each input feature are
+     * regenerated from the seed with a counter-based generator, once per block of rows,
+     * so fitting is O(1) and transforming is a single parallel pass over the data.
+     *
+     * @note A much cheaper alternative to PCA when only distances need to be preserved
+     */
+    class SparseRandomProjection {
+    public:
+        /**
+         * @brief Constructs a sparse random projection with the given parameters.
+         *
+         * @param n_components Target dimensionality, -1 to derive it from eps at fit time (default: -1)
+         * @param density Fraction of non-zero entries, -1 for 1/sqrt(features) (default: -1)
+         * @param eps Distortion allowed by the Johnson-Lindenstrauss bound (default: 0.1)
+         * @param seed Random seed; the same seed always gives the same projection (default: 41)
+         *
+         * Example usage:
+         * @code
+         * SparseRandomProjection projection1(64);             // 64 output features
+         * SparseRandomProjection projection2(-1, -1, 0.2);    // Size from the JL bound with eps = 0.2
+         * @endcode
+         */
+        explicit SparseRandomProjection(int n_components = -1,
+                                        double density = -1.0,
+                                        double eps = 0.1,
+                                        int seed = 41);
+
+        /**
+         * @brief Fixes the input and output dimensionality for the given data.
+         *
+         * Only the shape of X is used, so this is O(1).
+         *
+         * @param X Training features [samples][features]
+         *
+         * @throws std::invalid_argument If X is empty, density is not in (0, 1], or n_components
+         *                               is derived from eps and exceeds the number of features
+         */
+        void fit(const std::vector<std::vector<double>>& X);
+
+        /**
+         * @brief Fixes the input and output dimensionality for the given dataset.
+         *
+         * @param dataset Dataset whose shape is used
+         */
+        void fit(const Dataset& dataset);
+
+        /**
+         * @brief Projects a single sample.
+         *
+         * @param sample Feature vector
+         * @return Projected vector [n_components]
+         *
+         * @note Regenerates the whole projection; prefer the batch overloads for many samples
+         */
+        std::vector<double> transform(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Projects multiple samples in one parallel pass.
+         *
+         * @param X Features [samples][features]
+         * @return Projected features [samples][n_components]
+         *
+         * @note Time complexity: O(n * d * density * n_components)
+         */
+        std::vector<std::vector<double>> transform(const std::vector<std::vector<double>>& X) const;
+
+        /**
+         * @brief Projects the features of a dataset, keeping its labels.
+         *
+         * @param dataset Dataset to transform
+         * @return New dataset with n_components features per sample
+         *
+         * Example usage:
+         * @code
+         * SparseRandomProjection projection(64);
+         * projection.fit(train);
+         * KNN model(5);
+         * Dataset projected_train = projection.transform(train);
+         * model.fit(projected_train);
+         * double accuracy = model.score(projection.transform(test));
+         * @endcode
+         */
+        Dataset transform(const Dataset& dataset) const;
+
+        /**
+         * @brief Fits the projection and transforms the dataset.
+         *
+         * @param dataset Dataset to fit and transform
+         * @return New dataset with n_components features per sample
+         */
+        Dataset fit_transform(const Dataset& dataset);
+
+        /**
+         * @brief Computes the minimum safe number of components for the JL lemma.
+         *
+         * n_components >= 4 * ln(n_samples) / (eps² / 2 - eps³ / 3)
+         *
+         * @param n_samples Number of samples whose pairwise distances must be preserved
+         * @param eps Maximum relative distortion, between 0.0 and 1.0
+         * @return Minimum number of components
+         *
+         * @throws std::invalid_argument If eps is not between 0.0 and 1.0
+         */
+        static int johnson_lindenstrauss_min_dim(size_t n_samples, double eps = 0.1);
+
+        /**
+         * @brief Gets the output dimensionality.
+         *
+         * @return Number of components (valid after fit)
+         */
+        int get_n_components() const { return n_components_; }
+
+        /**
+         * @brief Gets the fraction of non-zero entries of the projection.
+         *
+         * @return Density (valid after fit)
+         */
+        double get_density() const { return density_; }
+
+    private:
+        int requested_components_;    ///< Components requested in the constructor (-1 = auto)
+        double requested_density_;    ///< Density requested in the constructor (-1 = auto)
+        double eps_;                  ///< Allowed distortion for the automatic size
+        int seed_;                    ///< Random seed
+        int n_components_ = 0;        ///< Output dimensionality
+        double density_ = 0.0;        ///< Fraction of non-zero entries
+        size_t n_features_ = 0;       ///< Input dimensionality
+
+        /**
+         * @brief Regenerates the non-zero entries of one row of the projection matrix.
+         *
+         * Positions are drawn by geometric skipping, so the cost is proportional to
+         * the number of non-zeros rather than to n_components.
+         *
+         * @param feature Input feature index (row of the projection matrix)
+         * @param entries Output {component, value} pairs, overwritten
+         */
+        void feature_entries(size_t feature, std::vector<std::pair<size_t, double>>& entries) const;
+    };
+}
+
+#endif //MLCPP_SPARSERANDOMPROJECTION_H
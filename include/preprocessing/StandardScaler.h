@@ -0,0 +1,101 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_STANDARDSCALER_H
+#define MLCPP_STANDARDSCALER_H
+#include <vector>
+#include "../core/Dataset.h"
+
+namespace mlcpp {
+    /**
+     * @brief Feature standardization z = (x - mean) / std fitted once and reused.
+     *
+     * Unlike Dataset::standardize(), which rewrites one dataset in place, the scaler
+     * keeps the statistics of the training data so the same transform can be applied
+     * to new samples, or folded into a linear model (LinearRegression::fold_scaler) so
+     * that serving needs no transform at all.
+     *
+     * The standard deviation is the sample one (n - 1), as in Dataset::standardize();
+     * features with zero standard deviation are only centered (scale 1).
+     *
+     * Example usage:
+     * @code
+     * StandardScaler scaler;
+     * scaler.fit(X_train);
+     * model.fit(scaler.transform(X_train), y_train);
+     * model.fold_scaler(scaler);          // model now takes raw features
+     * double y = model.predict(raw_sample);
+     * @endcode
+     */
+    class StandardScaler {
+    public:
+        /**
+         * @brief Estimates the per-feature mean and standard deviation.
+         *
+         * Each thread accumulates Welford moments of its rows, merged with the
+         * pairwise update of Chan et al., so the data is read once.
+         *
+         * @param X Training features [samples][features]
+         *
+         * @throws std::invalid_argument If X has fewer than 2 samples or rows differ in length
+         *
+         * @note Time complexity: O(n * d / threads)
+         */
+        void fit(const std::vector<std::vector<double>>& X);
+
+        /**
+         * @brief Fits the scaler on the features of a dataset.
+         *
+         * @param dataset Dataset whose features are used
+         */
+        void fit(const Dataset& dataset);
+
+        /**
+         * @brief Standardizes a single sample.
+         *
+         * @param sample Feature vector
+         * @return (sample - mean) / scale
+         *
+         * @throws std::logic_error If the scaler is not fitted
+         * @throws std::invalid_argument If the sample has the wrong number of features
+         */
+        std::vector<double> transform(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Standardizes multiple samples in parallel.
+         *
+         * @param X Features [samples][features]
+         * @return Standardized features [samples][features]
+         */
+        std::vector<std::vector<double>> transform(const std::vector<std::vector<double>>& X) const;
+
+        /**
+         * @brief Standardizes the features of a dataset, keeping its labels.
+         *
+         * @param dataset Dataset to transform
+         * @return New dataset with standardized features
+         */
+        Dataset transform(const Dataset& dataset) const;
+
+        /**
+         * @brief Gets the per-feature mean.
+         *
+         * @return Mean vector [features]
+         */
+        const std::vector<double>& get_mean() const { return mean_; }
+
+        /**
+         * @brief Gets the per-feature scale (standard deviation, 1 for constant features).
+         *
+         * @return Scale vector [features]
+         */
+        const std::vector<double>& get_scale() const { return scale_; }
+
+    private:
+        std::vector<double> mean_;     ///< Per-feature mean [features]
+        std::vector<double> scale_;    ///< Per-feature standard deviation [features]
+    };
+}
+
+#endif //MLCPP_STANDARDSCALER_H
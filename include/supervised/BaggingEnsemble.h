@@ -0,0 +1,322 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_BAGGINGENSEMBLE_H
+#define MLCPP_BAGGINGENSEMBLE_H
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "../core/Dataset.h"
+#include "../core/Parallel.h"
+#include "../core/Random.h"
+
+namespace mlcpp {
+    /**
+     * @brief Bagging wrapper that trains copies of any model on random samples of one dataset.
+     *
+     * Each estimator is drawn as a list of row indices (a bootstrap sample or a sample
+     * without replacement) and a sorted list of feature indices (random subspace),
+     * generated from its own counter-based stream so the result does not depend on
+     * the number of threads. Only the indices are drawn up front; a worker gathers
+     * its estimator's rows from the shared data right before calling fit() and frees
+     * them right after, so peak extra memory is one sample per thread, not one per
+     * estimator. Models that keep their training rows (KNN) still store their own
+     * sample.
+     *
+     * Estimators are trained in parallel. Batch prediction asks each estimator for
+     * its batch predictions (models parallelize those internally), then aggregates
+     * per sample in parallel: integer predictions are combined by majority vote over
+     * a dense [samples][classes] count table, floating-point predictions by averaging.
+     *
+     * Works with any model that is default-constructible through the factory and has
+     * - fit(Dataset&) for classification, or fit(X, y) with double targets for regression;
+     * - predict(const std::vector<std::vector<double>>&) returning std::vector<int> or std::vector<double>.
+     *
+     * Example usage:
+     * @code
+     * BaggingEnsemble<KNN> bagged([] { return KNN(5); }, 20, 0.5, 1.0, false);
+     * bagged.fit(train_dataset);
+     * vector<int> labels = bagged.predict(X_test);
+     *
+     * BaggingEnsemble<LinearRegression> regressors([] { return LinearRegression(); }, 50);
+     * regressors.fit(X_train, y_train);
+     * vector<double> values = regressors.predict(X_test);
+     * @endcode
+     */
+    template<typename Model>
+    class BaggingEnsemble {
+    public:
+        /**
+         * @brief Type returned by Model::predict for a batch (vector<int> or vector<double>).
+         */
+        using Prediction = decltype(std::declval<const Model&>().predict(
+            std::declval<const std::vector<std::vector<double>>&>()));
+
+        /**
+         * @brief Constructs a bagging ensemble.
+         *
+         * @param factory Creates one unfitted estimator (e.g. [] { return KNN(5); })
+         * @param n_estimators Number of estimators (default: 10)
+         * @param max_samples Rows per estimator as a fraction of the dataset (default: 1.0)
+         * @param max_features Features per estimator as a fraction of all features (default: 1.0)
+         * @param bootstrap Draw rows with replacement (default: true)
+         * @param seed Random seed (default: 41)
+         *
+         * @throws std::invalid_argument If n_estimators < 1 or a fraction is not in (0, 1]
+         */
+        explicit BaggingEnsemble(std::function<Model()> factory,
+                                 int n_estimators = 10,
+                                 double max_samples = 1.0,
+                                 double max_features = 1.0,
+                                 bool bootstrap = true,
+                                 uint64_t seed = 41) {
+            if (n_estimators < 1) {
+                throw std::invalid_argument("n_estimators must be at least 1.");
+            }
+            if (max_samples <= 0.0 || max_samples > 1.0 || max_features <= 0.0 || max_features > 1.0) {
+                throw std::invalid_argument("max_samples and max_features must be in (0, 1].");
+            }
+            this->factory_ = std::move(factory);
+            this->n_estimators_ = n_estimators;
+            this->max_samples_ = max_samples;
+            this->max_features_ = max_features;
+            this->bootstrap_ = bootstrap;
+            this->seed_ = seed;
+        }
+
+        /**
+         * @brief Trains the estimators on samples of a labelled dataset (classification).
+         *
+         * @param dataset Training dataset, shared by all estimators
+         *
+         * @throws std::invalid_argument If the dataset is empty
+         *
+         * @note Estimators are trained in parallel, one per task
+         */
+        void fit(const Dataset& dataset) {
+            const std::vector<std::vector<double>>& X = dataset.get_features();
+            const std::vector<int>& labels = dataset.get_labels();
+            this->classes_ = labels;
+            std::sort(this->classes_.begin(), this->classes_.end());
+            this->classes_.erase(std::unique(this->classes_.begin(), this->classes_.end()), this->classes_.end());
+            train(X, [&](Model& model, const std::vector<size_t>& rows, const std::vector<size_t>& features) {
+                std::vector<int> sample_labels(rows.size());
+                for (size_t i = 0; i < rows.size(); i++) {
+                    sample_labels[i] = labels[rows[i]];
+                }
+                Dataset sample(gather(X, rows, features), std::move(sample_labels));
+                model.fit(sample);
+            });
+        }
+
+        /**
+         * @brief Trains the estimators on samples of a regression problem.
+         *
+         * @param X Training features [samples][features], shared by all estimators
+         * @param y Training targets [samples]
+         *
+         * @throws std::invalid_argument If X is empty or sizes do not match
+         */
+        void fit(const std::vector<std::vector<double>>& X, const std::vector<double>& y) {
+            if (X.size() != y.size()) {
+                throw std::invalid_argument("X and y must have the same size.");
+            }
+            this->classes_.clear();
+            train(X, [&](Model& model, const std::vector<size_t>& rows, const std::vector<size_t>& features) {
+                std::vector<double> sample_targets(rows.size());
+                for (size_t i = 0; i < rows.size(); i++) {
+                    sample_targets[i] = y[rows[i]];
+                }
+                model.fit(gather(X, rows, features), sample_targets);
+            });
+        }
+
+        /**
+         * @brief Predicts a batch by majority vote (integer predictions) or averaging.
+         *
+         * @param X Samples [samples][features]
+         * @return Aggregated predictions, same type as Model::predict
+         *
+         * @throws std::logic_error If the ensemble is not fitted
+         * @throws std::invalid_argument If a sample has a different number of features than the training data
+         *
+         * @note Ties in the vote go to the smallest label
+         */
+        Prediction predict(const std::vector<std::vector<double>>& X) const {
+            if (this->estimators_.empty()) {
+                throw std::logic_error("BaggingEnsemble must be fitted before predict.");
+            }
+            for (const std::vector<double>& row: X) {
+                if (row.size() != this->n_features_) {
+                    throw std::invalid_argument("Sample must have the same number of features as the training data.");
+                }
+            }
+            // 1. Batch predictions of every estimator (each parallel internally)
+            std::vector<Prediction> predictions(this->estimators_.size());
+            std::vector<size_t> all_rows(X.size());
+            for (size_t i = 0; i < X.size(); i++) {
+                all_rows[i] = i;
+            }
+            for (size_t e = 0; e < this->estimators_.size(); e++) {
+                const std::vector<size_t>& features = this->features_[e];
+                predictions[e] = features.size() == this->n_features_
+                                     ? this->estimators_[e].predict(X)
+                                     : this->estimators_[e].predict(gather(X, all_rows, features));
+            }
+
+            // 2. Aggregate per sample in parallel
+            Prediction result(X.size());
+            size_t n_estimators = predictions.size();
+            if constexpr (std::is_integral_v<typename Prediction::value_type>) {
+                size_t n_classes = this->classes_.size();
+                parallel_for(X.size(), [&](size_t begin, size_t end, size_t) {
+                    std::vector<size_t> votes(n_classes);
+                    for (size_t i = begin; i < end; i++) {
+                        std::fill(votes.begin(), votes.end(), 0);
+                        for (size_t e = 0; e < n_estimators; e++) {
+                            votes[std::lower_bound(this->classes_.begin(), this->classes_.end(),
+                                                   predictions[e][i]) - this->classes_.begin()]++;
+                        }
+                        result[i] = this->classes_[std::max_element(votes.begin(), votes.end()) - votes.begin()];
+                    }
+                });
+            } else {
+                parallel_for(X.size(), [&](size_t begin, size_t end, size_t) {
+                    for (size_t i = begin; i < end; i++) {
+                        double sum = 0.0;
+                        for (size_t e = 0; e < n_estimators; e++) {
+                            sum += predictions[e][i];
+                        }
+                        result[i] = sum / n_estimators;
+                    }
+                });
+            }
+            return result;
+        }
+
+        /**
+         * @brief Predicts a single sample.
+         *
+         * @param sample Feature vector
+         * @return Aggregated prediction
+         *
+         * @throws std::logic_error If the ensemble is not fitted
+         * @throws std::invalid_argument If the sample has a different number of features than the training data
+         */
+        typename Prediction::value_type predict(const std::vector<double>& sample) const {
+            return predict(std::vector<std::vector<double>>{sample})[0];
+        }
+
+        /**
+         * @brief Gets the fitted estimators.
+         *
+         * @return Estimators in training order
+         */
+        const std::vector<Model>& get_estimators() const { return estimators_; }
+
+        /**
+         * @brief Gets the features seen by each estimator.
+         *
+         * @return Sorted feature indices per estimator
+         */
+        const std::vector<std::vector<size_t>>& get_estimator_features() const { return features_; }
+
+    private:
+        std::function<Model()> factory_;                ///< Creates unfitted estimators
+        int n_estimators_;                              ///< Number of estimators
+        double max_samples_;                            ///< Fraction of rows per estimator
+        double max_features_;                           ///< Fraction of features per estimator
+        bool bootstrap_;                                ///< Rows drawn with replacement
+        uint64_t seed_;                                 ///< Random seed
+        size_t n_features_ = 0;                         ///< Features of the training data
+        std::vector<int> classes_;                      ///< Sorted labels (classification only)
+        std::vector<Model> estimators_;                 ///< Fitted estimators
+        std::vector<std::vector<size_t>> features_;     ///< Feature subset of each estimator
+
+        /**
+         * @brief Copies the selected rows and features of X.
+         */
+        static std::vector<std::vector<double>> gather(const std::vector<std::vector<double>>& X,
+                                                       const std::vector<size_t>& rows,
+                                                       const std::vector<size_t>& features) {
+            std::vector<std::vector<double>> sample(rows.size(), std::vector<double>(features.size()));
+            for (size_t i = 0; i < rows.size(); i++) {
+                const std::vector<double>& row = X[rows[i]];
+                for (size_t j = 0; j < features.size(); j++) {
+                    sample[i][j] = row[features[j]];
+                }
+            }
+            return sample;
+        }
+
+        /**
+         * @brief Draws every estimator's indices and trains the estimators in parallel.
+         *
+         * @param X Shared training features
+         * @param fit_one Callable(Model&, rows, features) that gathers the sample and fits
+         */
+        template<typename FitOne>
+        void train(const std::vector<std::vector<double>>& X, FitOne fit_one) {
+            if (X.empty()) {
+                throw std::invalid_argument("Cannot fit BaggingEnsemble on an empty dataset.");
+            }
+            size_t n = X.size();
+            this->n_features_ = X[0].size();
+            size_t n_rows = std::max<size_t>(1, static_cast<size_t>(this->max_samples_ * n));
+            size_t n_cols = std::max<size_t>(1, static_cast<size_t>(this->max_features_ * this->n_features_));
+
+            std::vector<Model> estimators;
+            estimators.reserve(this->n_estimators_);
+            for (int e = 0; e < this->n_estimators_; e++) {
+                estimators.push_back(this->factory_());
+            }
+            std::vector<std::vector<size_t>> features(this->n_estimators_);
+            parallel_for(static_cast<size_t>(this->n_estimators_), [&](size_t begin, size_t end, size_t) {
+                std::vector<size_t> pool;
+                for (size_t e = begin; e < end; e++) {
+                    CounterRng rng(CounterRng::at(this->seed_, e));
+
+                    // 1. Row indices: bootstrap draws or a partial shuffle
+                    std::vector<size_t> rows(n_rows);
+                    if (this->bootstrap_) {
+                        for (size_t& row: rows) {
+                            row = rng.uniform_index(n);
+                        }
+                    } else {
+                        pool.resize(n);
+                        for (size_t i = 0; i < n; i++) {
+                            pool[i] = i;
+                        }
+                        for (size_t i = 0; i < n_rows; i++) {
+                            std::swap(pool[i], pool[i + rng.uniform_index(n - i)]);
+                            rows[i] = pool[i];
+                        }
+                    }
+
+                    // 2. Feature subspace, kept sorted
+                    pool.resize(this->n_features_);
+                    for (size_t j = 0; j < this->n_features_; j++) {
+                        pool[j] = j;
+                    }
+                    for (size_t j = 0; j < n_cols; j++) {
+                        std::swap(pool[j], pool[j + rng.uniform_index(this->n_features_ - j)]);
+                    }
+                    features[e].assign(pool.begin(), pool.begin() + n_cols);
+                    std::sort(features[e].begin(), features[e].end());
+
+                    // 3. Gather the sample, fit, and let the copy go
+                    fit_one(estimators[e], rows, features[e]);
+                }
+            }, 1);
+            this->estimators_ = std::move(estimators);
+            this->features_ = std::move(features);
+        }
+    };
+}
+
+#endif //MLCPP_BAGGINGENSEMBLE_H
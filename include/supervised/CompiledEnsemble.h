@@ -0,0 +1,223 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_COMPILEDENSEMBLE_H
+#define MLCPP_COMPILEDENSEMBLE_H
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+#include "DecisionTree.h"
+#include "GradientBoosting.h"
+#include "RandomForest.h"
+
+namespace mlcpp {
+    /**
+     * @brief Transform applied to the summed tree outputs of a compiled ensemble.
+     */
+    enum class EnsembleTransform {
+        Identity,   ///< Raw sum (regression, averaged forest probabilities)
+        Sigmoid,    ///< Probability of the positive class (logistic boosting)
+        Softmax     ///< Class probabilities (softmax boosting)
+    };
+
+    /**
+     * @brief Read-only inference engine for tree ensembles in a flat struct-of-arrays layout.
+     *
+     * The ensemble is a handful of flat arrays shared by all trees: per-tree metadata
+     * (root, depth, output offset, leaf width), the nodes of every tree back to back,
+     * split by field (threshold, feature, child, leaf offset), and the leaf values.
+     * Each traversal step is branchless:
+     *
+     *     node = child[node] + !(x[feature[node]] <= threshold[node])
+     *
+     * and leaves loop back onto themselves (threshold NaN, child = self - 1), so rows
+     * that reach a leaf early simply stay put. Rows are evaluated in blocks: every tree
+     * is applied level by level to all rows of a block, which keeps independent loads
+     * in flight and lets the compiler vectorize the step across rows; a tree stops as
+     * soon as every row of the block sits on a leaf.
+     *
+     * The arrays are stored in one contiguous buffer that is also the file format:
+     * save() writes it as is and load() memory-maps it, so a model is ready to serve
+     * without parsing. Copies share the same buffer.
+     *
+     * Example usage:
+     * @code
+     * CompiledEnsemble engine = CompiledEnsemble::compile(boosted_model);
+     * engine.save("model.bin");
+     * auto served = CompiledEnsemble::load("model.bin");
+     * vector<double> probabilities = served->predict(X_test);
+     * @endcode
+     */
+    class CompiledEnsemble {
+    public:
+        /**
+         * @brief Default constructor. Creates an empty ensemble that predicts zeros.
+         */
+        CompiledEnsemble() = default;
+
+        /**
+         * @brief Compiles a list of trees.
+         *
+         * Tree t adds its leaf outputs to the outputs starting at
+         * (t % (n_outputs / tree.n_outputs)) * tree.n_outputs, so round-major boosting
+         * trees and multi-output forest trees are both supported.
+         *
+         * @param trees Trees to compile
+         * @param n_outputs Number of outputs per sample
+         * @param base_scores Initial value of each output (empty for zeros)
+         * @param scale Factor applied to every leaf value (e.g. 1 / n_trees to average)
+         * @param transform Transform applied to the summed outputs
+         * @return Compiled ensemble
+         *
+         * @throws std::invalid_argument If a tree does not fit the output layout or is deeper than 64 levels
+         *
+         * @note Time complexity: O(total nodes)
+         */
+        static CompiledEnsemble compile(const std::vector<FlatTree>& trees, int n_outputs,
+                                        const std::vector<double>& base_scores, double scale,
+                                        EnsembleTransform transform);
+
+        /**
+         * @brief Compiles a single fitted decision tree.
+         *
+         * @param tree Fitted classifier or regressor
+         * @return Ensemble predicting the leaf outputs (class probabilities or values)
+         *
+         * @throws std::invalid_argument If a tree is deeper than 64 levels
+         */
+        static CompiledEnsemble compile(const DecisionTree& tree);
+
+        /**
+         * @brief Compiles a fitted random forest.
+         *
+         * @param forest Fitted classifier or regressor
+         * @return Ensemble predicting the averaged class probabilities or values
+         *
+         * @throws std::invalid_argument If a tree is deeper than 64 levels
+         */
+        static CompiledEnsemble compile(const RandomForest& forest);
+
+        /**
+         * @brief Compiles a fitted gradient boosting model.
+         *
+         * @param model Fitted classifier or regressor
+         * @return Ensemble predicting values (squared loss), the positive class
+         *         probability (logistic loss) or class probabilities (softmax loss)
+         *
+         * @throws std::invalid_argument If a tree is deeper than 64 levels
+         */
+        static CompiledEnsemble compile(const GradientBoosting& model);
+
+        /**
+         * @brief Predicts the outputs of one sample (low-latency path).
+         *
+         * @param sample Pointer to the feature values (at least get_num_features())
+         * @param outputs Pointer to get_num_outputs() values, overwritten
+         *
+         * @note Time complexity: O(sum of tree depths), no allocation
+         */
+        void predict(const double* sample, double* outputs) const;
+
+        /**
+         * @brief Predicts the outputs of one sample.
+         *
+         * @param sample Feature vector
+         * @return get_num_outputs() values
+         *
+         * @throws std::invalid_argument If the sample has fewer than get_num_features() values
+         */
+        std::vector<double> predict(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Predicts the outputs of a batch of samples.
+         *
+         * @param X Samples [samples][features]
+         * @return Outputs [samples * get_num_outputs()]
+         *
+         * @throws std::invalid_argument If a sample has fewer than get_num_features() values
+         *
+         * @note Blocks of rows are evaluated in parallel, each block through all trees
+         */
+        std::vector<double> predict(const std::vector<std::vector<double>>& X) const;
+
+        /**
+         * @brief Writes the ensemble to a binary file (native endianness).
+         *
+         * @param path Output file path
+         * @return true on success
+         */
+        bool save(const std::string& path) const;
+
+        /**
+         * @brief Loads an ensemble written by save(), memory-mapping the file when possible.
+         *
+         * @param path Input file path
+         * @return Optional ensemble. Returns empty optional if the file is missing or invalid.
+         *
+         * @note The mapping is read-only and shared by all copies of the returned ensemble
+         */
+        static std::optional<CompiledEnsemble> load(const std::string& path);
+
+        /**
+         * @brief Gets the number of trees.
+         *
+         * @return Number of compiled trees
+         */
+        size_t get_num_trees() const { return n_trees_; }
+
+        /**
+         * @brief Gets the number of outputs per sample.
+         *
+         * @return Output count
+         */
+        size_t get_num_outputs() const { return n_outputs_; }
+
+        /**
+         * @brief Gets the number of features a sample must have.
+         *
+         * @return Largest split feature index plus one
+         */
+        size_t get_num_features() const { return n_features_; }
+
+    private:
+        std::shared_ptr<const void> storage_;   ///< Owned buffer or read-only file mapping
+        size_t n_trees_ = 0;                    ///< Number of trees
+        size_t n_outputs_ = 0;                  ///< Outputs per sample
+        size_t n_features_ = 0;                 ///< Features read by the trees
+        size_t size_bytes_ = 0;                 ///< Size of the storage buffer
+        EnsembleTransform transform_ = EnsembleTransform::Identity; ///< Output transform
+        double scale_ = 1.0;                    ///< Factor applied to leaf values
+        const double* base_scores_ = nullptr;   ///< Initial outputs [n_outputs]
+        const double* leaf_values_ = nullptr;   ///< Leaf outputs, width values per leaf
+        const int32_t* roots_ = nullptr;        ///< Root node of each tree [trees]
+        const int32_t* depths_ = nullptr;       ///< Traversal steps of each tree [trees]
+        const int32_t* output_offsets_ = nullptr;   ///< First output of each tree [trees]
+        const int32_t* widths_ = nullptr;       ///< Outputs per leaf of each tree [trees]
+        const double* thresholds_ = nullptr;    ///< Split thresholds [nodes], NaN for leaves
+        const int32_t* features_ = nullptr;     ///< Split feature [nodes], 0 for leaves
+        const int32_t* children_ = nullptr;     ///< Left child [nodes] (right is left + 1), self - 1 for leaves
+        const int32_t* leaves_ = nullptr;       ///< Offset in leaf_values_ [nodes]
+
+        /**
+         * @brief Points the arrays into a buffer in the file format.
+         *
+         * @return false if the buffer is not a valid ensemble
+         */
+        bool attach(std::shared_ptr<const void> storage, size_t size_bytes);
+
+        /**
+         * @brief Checks whether a node is a leaf (its child index points to itself minus one).
+         */
+        bool is_leaf(int32_t node) const { return children_[node] == node - 1; }
+
+        /**
+         * @brief Applies the output transform in place.
+         */
+        void finish(double* outputs) const;
+    };
+}
+
+#endif //MLCPP_COMPILEDENSEMBLE_H
@@ -0,0 +1,279 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_DECISIONTREE_H
+#define MLCPP_DECISIONTREE_H
+#include <cstdint>
+#include <vector>
+#include "../core/BinnedDataset.h"
+#include "../core/Dataset.h"
+
+namespace mlcpp {
+    /**
+     * @brief One node of a tree stored in a flat array.
+     *
+     * Internal nodes send a sample left when sample[feature] <= threshold (equivalently,
+     * when its bin is <= bin). Leaves have feature == -1 and point to their outputs.
+     */
+    struct TreeNode {
+        int feature = -1;           ///< Split feature, -1 for leaves
+        uint8_t bin = 0;            ///< Samples with bin <= this go left
+        double threshold = 0.0;     ///< Samples with value <= this go left
+        int left = -1;              ///< Index of the left child (the right child is left + 1)
+        int leaf = -1;              ///< Index of the leaf outputs, -1 for internal nodes
+    };
+
+    /**
+     * @brief Tree laid out as a flat, cache-friendly array of nodes.
+     *
+     * The two children of a node are always adjacent, so prediction walks a single
+     * contiguous array. Leaf outputs are stored contiguously, n_outputs per leaf
+     * (class probabilities for classification, one value for regression).
+     */
+    struct FlatTree {
+        std::vector<TreeNode> nodes;        ///< Nodes, root first
+        std::vector<double> leaf_values;    ///< Leaf outputs [leaves][n_outputs]
+        int n_outputs = 1;                  ///< Outputs per leaf
+
+        /**
+         * @brief Walks the tree for a sample and returns the outputs of its leaf.
+         *
+         * @param sample Raw feature vector
+         * @return Pointer to n_outputs values
+         *
+         * @note Time complexity: O(depth)
+         */
+        const double* predict_leaf(const std::vector<double>& sample) const {
+            const TreeNode* node = &nodes[0];
+            while (node->feature >= 0) {
+                node = &nodes[node->left + (sample[node->feature] <= node->threshold ? 0 : 1)];
+            }
+            return leaf_values.data() + static_cast<size_t>(node->leaf) * n_outputs;
+        }
+
+        /**
+         * @brief Computes the depth of the tree.
+         *
+         * @return Number of edges on the longest root-to-leaf path
+         */
+        int depth() const;
+    };
+
+    /**
+     * @brief Options of the tree growing engine (see DecisionTree::grow()).
+     */
+    struct TreeGrowOptions {
+        int max_depth = 8;                                      ///< Maximum depth of the tree
+        int min_samples_leaf = 1;                               ///< Minimum (weighted) samples in each leaf
+        int max_features = 0;                                   ///< Features sampled per node, 0 for all
+        const std::vector<uint32_t>* sample_weights = nullptr;  ///< Integer weight per sample (e.g. bootstrap counts), nullptr for all ones
+        uint64_t seed = 41;                                     ///< Seed of the feature sampling
+        bool parallel = true;                                   ///< Whether histograms may be built in parallel
+    };
+
+    /**
+     * @brief Histogram-based decision tree learner (shared engine).
+     *
+     * Every feature is pre-binned once into at most 256 uint8 bins (see BinnedDataset).
+     * Split search accumulates per-bin histograms of the node statistics instead of
+     * sorting, so each level costs O(rows * features). Only the smaller child of a
+     * split is scanned; the larger child's histogram is the parent's minus the
+     * sibling's (sibling subtraction). Nodes are stored in a FlatTree for prediction.
+     *
+     * Use DecisionTreeClassifier or DecisionTreeRegressor, or grow() directly on
+     * shared binned data (as RandomForest does).
+     */
+    class DecisionTree {
+    public:
+        /**
+         * @brief Grows a tree on pre-binned data.
+         *
+         * For classification, targets hold class indices in [0, n_classes) and splits
+         * maximize the Gini impurity decrease; leaves store class probabilities.
+         * For regression (n_classes == 0), splits maximize the variance decrease and
+         * leaves store the mean target.
+         *
+         * Samples with weight 0 are never scanned, so a bootstrap sample expressed as
+         * integer weights costs no copy of the data. When fewer than half of the
+         * features are sampled per node, each node histograms only its own features
+         * instead of using sibling subtraction.
+         *
+         * @param data Binned features, shared read-only
+         * @param targets Class index or target value per sample
+         * @param n_classes Number of classes, 0 for regression
+         * @param options Growth options
+         * @return Fitted flat tree
+         *
+         * @note Time complexity: O(n * d) per level plus O(d * bins) per node
+         */
+        static FlatTree grow(const BinnedDataset& data, const std::vector<double>& targets, int n_classes,
+                             const TreeGrowOptions& options);
+
+        /**
+         * @brief Gets the fitted tree.
+         *
+         * @return Flat node array and leaf outputs
+         */
+        const FlatTree& get_tree() const { return tree_; }
+
+        /**
+         * @brief Gets the maximum depth allowed during training.
+         *
+         * @return The max_depth value
+         */
+        int get_max_depth() const { return max_depth_; }
+
+    protected:
+        int max_depth_;             ///< Maximum depth of the tree
+        int min_samples_leaf_;      ///< Minimum number of samples in each leaf
+        int max_bins_;              ///< Maximum number of bins per feature
+        FlatTree tree_;             ///< Fitted tree
+
+        /**
+         * @brief Stores the common hyperparameters.
+         *
+         * @param max_depth Maximum depth of the tree
+         * @param min_samples_leaf Minimum number of samples in each leaf
+         * @param max_bins Maximum number of bins per feature (at most 256)
+         */
+        DecisionTree(int max_depth, int min_samples_leaf, int max_bins);
+
+        /**
+         * @brief Gets the growth options matching the hyperparameters of this tree.
+         *
+         * @return Options with max_depth and min_samples_leaf set
+         */
+        TreeGrowOptions grow_options() const;
+    };
+
+    /**
+     * @brief Decision tree classifier trained with histogram-based split search.
+     *
+     * Example usage:
+     * @code
+     * DecisionTreeClassifier tree(6);
+     * tree.fit(train_dataset);
+     * double accuracy = tree.score(test_dataset);
+     * @endcode
+     */
+    class DecisionTreeClassifier : public DecisionTree {
+    public:
+        /**
+         * @brief Constructs a decision tree classifier.
+         *
+         * @param max_depth Maximum depth of the tree (default: 8)
+         * @param min_samples_leaf Minimum number of samples in each leaf (default: 1)
+         * @param max_bins Maximum number of bins per feature, at most 256 (default: 256)
+         */
+        explicit DecisionTreeClassifier(int max_depth = 8, int min_samples_leaf = 1, int max_bins = 256);
+
+        /**
+         * @brief Trains the tree on a dataset.
+         *
+         * @param dataset Training dataset containing features and integer labels
+         *
+         * @throws std::invalid_argument If the dataset is empty
+         *
+         * @note Time complexity: O(n * d * max_depth), no sorting of the samples
+         */
+        void fit(const Dataset& dataset);
+
+        /**
+         * @brief Predicts the class label for a single sample.
+         *
+         * @param sample Feature vector
+         * @return Predicted class label (integer)
+         *
+         * @note Time complexity: O(depth)
+         */
+        int predict(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Predicts class labels for multiple samples.
+         *
+         * @param samples 2D vector where each row is a sample to classify
+         * @return Vector of predicted labels
+         */
+        std::vector<int> predict(const std::vector<std::vector<double>>& samples) const;
+
+        /**
+         * @brief Predicts the class probabilities for a single sample.
+         *
+         * @param sample Feature vector
+         * @return Probability of each class, ordered as get_classes()
+         */
+        std::vector<double> predict_proba(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Calculates the accuracy of the model on a test dataset.
+         *
+         * @param test_dataset Dataset containing test samples and their true labels
+         * @return Accuracy as a value between 0.0 and 1.0
+         */
+        double score(const Dataset& test_dataset) const;
+
+        /**
+         * @brief Gets the class labels seen during training.
+         *
+         * @return Sorted distinct labels; output i of a leaf is the probability of classes[i]
+         */
+        const std::vector<int>& get_classes() const { return classes_; }
+
+    private:
+        std::vector<int> classes_;      ///< Sorted distinct training labels
+    };
+
+    /**
+     * @brief Decision tree regressor trained with histogram-based split search.
+     *
+     * Example usage:
+     * @code
+     * DecisionTreeRegressor tree(6, 5);
+     * tree.fit(X_train, y_train);
+     * vector<double> predictions = tree.predict(X_test);
+     * @endcode
+     */
+    class DecisionTreeRegressor : public DecisionTree {
+    public:
+        /**
+         * @brief Constructs a decision tree regressor.
+         *
+         * @param max_depth Maximum depth of the tree (default: 8)
+         * @param min_samples_leaf Minimum number of samples in each leaf (default: 1)
+         * @param max_bins Maximum number of bins per feature, at most 256 (default: 256)
+         */
+        explicit DecisionTreeRegressor(int max_depth = 8, int min_samples_leaf = 1, int max_bins = 256);
+
+        /**
+         * @brief Trains the tree.
+         *
+         * @param X_train Training features [samples][features]
+         * @param y_train Training target values [samples]
+         *
+         * @throws std::invalid_argument If X_train is empty or sizes do not match
+         *
+         * @note Time complexity: O(n * d * max_depth), no sorting of the samples
+         */
+        void fit(const std::vector<std::vector<double>>& X_train,
+                 const std::vector<double>& y_train);
+
+        /**
+         * @brief Predicts the target value for a single sample.
+         *
+         * @param sample Feature vector
+         * @return Predicted value (mean target of the leaf)
+         */
+        double predict(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Predicts target values for multiple samples.
+         *
+         * @param X_test Test features [samples][features]
+         * @return Vector of predicted values
+         */
+        std::vector<double> predict(const std::vector<std::vector<double>>& X_test) const;
+    };
+}
+
+#endif //MLCPP_DECISIONTREE_H
@@ -0,0 +1,270 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_GRADIENTBOOSTING_H
+#define MLCPP_GRADIENTBOOSTING_H
+#include <vector>
+#include "DecisionTree.h"
+
+namespace mlcpp {
+    /**
+     * @brief Loss functions supported by the gradient boosting engine.
+     */
+    enum class BoostingLoss {
+        Squared,    ///< Regression, 0.5 * (y - f)²
+        Logistic,   ///< Binary classification, one raw score per sample
+        Softmax     ///< Multiclass classification, one raw score per class
+    };
+
+    /**
+     * @brief Hyperparameters of gradient boosting (see GradientBoosting).
+     */
+    struct BoostingOptions {
+        int n_estimators = 100;             ///< Maximum number of boosting rounds
+        double learning_rate = 0.1;         ///< Shrinkage applied to every tree
+        int max_leaves = 31;                ///< Maximum number of leaves per tree
+        int max_depth = 0;                  ///< Maximum depth per tree, 0 for unlimited
+        int min_samples_leaf = 20;          ///< Minimum number of samples in each leaf
+        double min_hessian_leaf = 1e-3;     ///< Minimum sum of hessians in each leaf
+        double l2_regularization = 1.0;     ///< L2 penalty on the leaf values (lambda)
+        double subsample = 1.0;             ///< Fraction of rows sampled for each round
+        double colsample = 1.0;             ///< Fraction of features sampled for each tree
+        int early_stopping_rounds = 0;      ///< Rounds without validation improvement before stopping, 0 to disable
+        double validation_fraction = 0.1;   ///< Fraction of rows held out when early stopping is enabled
+        int max_bins = 256;                 ///< Maximum number of bins per feature, at most 256
+        int seed = 41;                      ///< Random seed for sampling and the validation split
+    };
+
+    /**
+     * @brief Gradient-boosted decision trees with histogram-based split search (shared engine).
+     *
+     * Features are binned once (see BinnedDataset). Each round fits one tree per raw
+     * output to the gradients and hessians of the loss (second-order boosting), with
+     * leaf values -G / (H + lambda) scaled by the learning rate.
+     *
+     * Trees grow leaf-wise: the leaf with the largest gain is always split next, up to
+     * max_leaves. Gradient/hessian histograms are built in parallel across features,
+     * or across row chunks when there are fewer features than threads, and only the
+     * smaller child of a split is scanned (sibling subtraction).
+     *
+     * When early stopping is enabled, a validation split is held out and its loss is
+     * computed every round with the fused Metrics accumulators; the model is cut back
+     * to the best round.
+     *
+     * Use GradientBoostingClassifier or GradientBoostingRegressor.
+     */
+    class GradientBoosting {
+    public:
+        /**
+         * @brief Computes the raw scores (before the sigmoid/softmax) for a batch of samples.
+         *
+         * @param X Samples [samples][features]
+         * @return Raw scores [samples * get_num_outputs()]
+         *
+         * @note Rows are processed in parallel blocks, each block through all trees
+         */
+        std::vector<double> decision_function(const std::vector<std::vector<double>>& X) const;
+
+        /**
+         * @brief Gets the fitted trees.
+         *
+         * @return Trees in round-major order: output k of round t is tree t * get_num_outputs() + k
+         */
+        const std::vector<FlatTree>& get_trees() const { return trees_; }
+
+        /**
+         * @brief Gets the initial raw score of each output.
+         *
+         * @return One base score per output
+         */
+        const std::vector<double>& get_base_scores() const { return base_scores_; }
+
+        /**
+         * @brief Gets the number of raw outputs (trees per round).
+         *
+         * @return 1 for squared and logistic losses, the number of classes for softmax
+         */
+        int get_num_outputs() const { return n_outputs_; }
+
+        /**
+         * @brief Gets the number of rounds kept after training.
+         *
+         * @return The best round when early stopping is enabled, otherwise n_estimators
+         */
+        int get_best_iteration() const { return best_iteration_; }
+
+        /**
+         * @brief Gets the validation loss after each round (empty without early stopping).
+         *
+         * @return MSE for the squared loss, log loss for classification
+         */
+        const std::vector<double>& get_validation_loss() const { return validation_loss_; }
+
+        /**
+         * @brief Gets the loss the model was trained with.
+         *
+         * @return The loss function
+         */
+        BoostingLoss get_loss() const { return loss_; }
+
+    protected:
+        BoostingOptions options_;               ///< Hyperparameters
+        BoostingLoss loss_ = BoostingLoss::Squared; ///< Loss function
+        int n_outputs_ = 1;                     ///< Raw outputs (trees per round)
+        int best_iteration_ = 0;                ///< Rounds kept
+        std::vector<double> base_scores_;       ///< Initial raw score per output
+        std::vector<FlatTree> trees_;           ///< Trees, round-major
+        std::vector<double> validation_loss_;   ///< Validation loss per round
+
+        /**
+         * @brief Stores the hyperparameters.
+         *
+         * @throws std::invalid_argument If a hyperparameter is out of range
+         */
+        explicit GradientBoosting(const BoostingOptions& options);
+
+        /**
+         * @brief Runs the boosting rounds.
+         *
+         * @param data Binned features
+         * @param targets Target values (Squared) or class indices (Logistic, Softmax)
+         * @param loss Loss function
+         * @param n_outputs Raw outputs: 1, or the number of classes for Softmax
+         */
+        void boost(const BinnedDataset& data, const std::vector<double>& targets, BoostingLoss loss, int n_outputs);
+    };
+
+    /**
+     * @brief Gradient boosting classifier (logistic loss for two classes, softmax otherwise).
+     *
+     * Example usage:
+     * @code
+     * BoostingOptions options;
+     * options.n_estimators = 500;
+     * options.early_stopping_rounds = 20;
+     * GradientBoostingClassifier model(options);
+     * model.fit(train_dataset);
+     * double accuracy = model.score(test_dataset);
+     * @endcode
+     */
+    class GradientBoostingClassifier : public GradientBoosting {
+    public:
+        /**
+         * @brief Constructs a gradient boosting classifier.
+         *
+         * @param options Hyperparameters (default: BoostingOptions())
+         *
+         * @throws std::invalid_argument If a hyperparameter is out of range
+         */
+        explicit GradientBoostingClassifier(const BoostingOptions& options = BoostingOptions());
+
+        /**
+         * @brief Trains the model on a dataset.
+         *
+         * @param dataset Training dataset containing features and integer labels
+         *
+         * @throws std::invalid_argument If the dataset is empty
+         *
+         * @note Time complexity: O(rounds * classes * (n * d / threads + max_leaves * d * bins))
+         */
+        void fit(const Dataset& dataset);
+
+        /**
+         * @brief Predicts the class label for a single sample.
+         *
+         * @param sample Feature vector
+         * @return Most probable class label
+         */
+        int predict(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Predicts class labels for multiple samples.
+         *
+         * @param samples 2D vector where each row is a sample to classify
+         * @return Vector of predicted labels
+         */
+        std::vector<int> predict(const std::vector<std::vector<double>>& samples) const;
+
+        /**
+         * @brief Predicts the class probabilities for multiple samples.
+         *
+         * @param samples 2D vector where each row is a sample
+         * @return Probabilities [samples][classes], classes ordered as get_classes()
+         */
+        std::vector<std::vector<double>> predict_proba(const std::vector<std::vector<double>>& samples) const;
+
+        /**
+         * @brief Calculates the accuracy of the model on a test dataset.
+         *
+         * @param test_dataset Dataset containing test samples and their true labels
+         * @return Accuracy as a value between 0.0 and 1.0
+         */
+        double score(const Dataset& test_dataset) const;
+
+        /**
+         * @brief Gets the class labels seen during training.
+         *
+         * @return Sorted distinct labels
+         */
+        const std::vector<int>& get_classes() const { return classes_; }
+
+    private:
+        std::vector<int> classes_;      ///< Sorted distinct training labels
+    };
+
+    /**
+     * @brief Gradient boosting regressor (squared loss).
+     *
+     * Example usage:
+     * @code
+     * BoostingOptions options;
+     * options.learning_rate = 0.05;
+     * options.n_estimators = 1000;
+     * options.early_stopping_rounds = 50;
+     * GradientBoostingRegressor model(options);
+     * model.fit(X_train, y_train);
+     * vector<double> predictions = model.predict(X_test);
+     * @endcode
+     */
+    class GradientBoostingRegressor : public GradientBoosting {
+    public:
+        /**
+         * @brief Constructs a gradient boosting regressor.
+         *
+         * @param options Hyperparameters (default: BoostingOptions())
+         *
+         * @throws std::invalid_argument If a hyperparameter is out of range
+         */
+        explicit GradientBoostingRegressor(const BoostingOptions& options = BoostingOptions());
+
+        /**
+         * @brief Trains the model.
+         *
+         * @param X_train Training features [samples][features]
+         * @param y_train Training target values [samples]
+         *
+         * @throws std::invalid_argument If X_train is empty or sizes do not match
+         */
+        void fit(const std::vector<std::vector<double>>& X_train,
+                 const std::vector<double>& y_train);
+
+        /**
+         * @brief Predicts the target value for a single sample.
+         *
+         * @param sample Feature vector
+         * @return Predicted value
+         */
+        double predict(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Predicts target values for multiple samples.
+         *
+         * @param X_test Test features [samples][features]
+         * @return Vector of predicted values
+         */
+        std::vector<double> predict(const std::vector<std::vector<double>>& X_test) const;
+    };
+}
+
+#endif //MLCPP_GRADIENTBOOSTING_H
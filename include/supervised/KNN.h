@@ -4,11 +4,27 @@
 
 #ifndef MLCPP_KNN_H
 #define MLCPP_KNN_H
+#include <cstdint>
+#include <optional>
 #include <vector>
+#include "../core/BinaryDistance.h"
+#include "../core/BitMatrix.h"
 #include "../core/Dataset.h"
 #include "../core/Distance.h"
+#include "../core/NeighborSearch.h"
+#include "../preprocessing/MahalanobisWhitening.h"
 
 namespace mlcpp {
+    /**
+     * @brief Fit-time reduction of the KNN reference set.
+     */
+    enum class PrototypeReduction {
+        None,       ///< Keep every training row
+        Condensed,  ///< Hart's condensed nearest neighbor: a subset that still classifies the training set with 1-NN
+        Edited,     ///< Wilson's edited nearest neighbor: drop rows misclassified by their own k neighbors
+        KMeans      ///< Replace each class by k-means centroids
+    };
+
     /**
      * @brief K-Nearest Neighbors (KNN) classifier for supervised learning.
      *
@@ -33,10 +49,38 @@ namespace mlcpp {
          * @code
          * KNN model1(5);                              // k=5, Euclidean distance
          * KNN model2(3, manhattan_distance);          // k=3, Manhattan distance
+         * KNN model3(10, cosine_distance);            // k=10, cosine distance
+         * KNN model4(10, inner_product_distance);     // k=10, maximum inner product search
          * @endcode
+         *
+         * @note euclidean_distance, cosine_distance and inner_product_distance are recognized
+         *       and use a fast path with norms cached at fit time; other metrics are called as given
          */
         explicit KNN(int k = 3, DistanceMetric distance = euclidean_distance);
 
+        /**
+         * @brief Creates a KNN classifier that uses the Mahalanobis distance.
+         *
+         * At fit time the feature covariance is estimated in one pass and factored once
+         * (Cholesky); the training rows are stored whitened, and queries are whitened
+         * once before the search. The search itself is the euclidean fast path, so
+         * Mahalanobis search costs the same as Euclidean search.
+         *
+         * @param k Number of nearest neighbors to consider (default: 3)
+         * @param regularization Ridge added to the covariance diagonal, relative to the
+         *                       average feature variance (default: 1e-9)
+         * @return KNN classifier configured for the Mahalanobis distance
+         *
+         * @note Useful when features are correlated or on different scales
+         *
+         * Example usage:
+         * @code
+         * KNN model = KNN::mahalanobis(5);
+         * model.fit(train_dataset);
+         * @endcode
+         */
+        static KNN mahalanobis(int k = 3, double regularization = 1e-9);
+
         /**
          * @brief Trains the KNN model by storing the training data.
          *
@@ -45,7 +89,8 @@ namespace mlcpp {
          *
          * @param dataset Training dataset containing features and labels
          *
-         * @note Time complexity: O(1) - just stores references to the data
+         * @note Time complexity: O(n * d) - copies the data and caches the row norms
+         *       needed by the euclidean, cosine and inner product fast paths
          * @note Any previous training data is overwritten
          *
          * Example usage:
@@ -56,6 +101,64 @@ namespace mlcpp {
          */
         void fit(Dataset& dataset);
 
+        /**
+         * @brief Trains the KNN model on a reduced reference set.
+         *
+         * Picks a smaller set of prototypes so queries compare against fewer rows:
+         * - Condensed: Hart's algorithm in a random order. Candidates are checked in
+         *   blocks, each block searched against the current store in parallel, so
+         *   the result is the same as the one-at-a-time algorithm. Passes repeat
+         *   until no candidate is added.
+         * - Edited: one parallel all-pairs pass (NeighborSearch::kneighbors_graph)
+         *   drops every row whose k neighbors vote for another label. This removes
+         *   noise and class overlap rather than shrinking much.
+         * - KMeans: each class is replaced by prototype_fraction of its size in
+         *   k-means centroids (Lloyd iterations with parallel assignment, euclidean).
+         *
+         * Reduction happens in the space the search uses (whitened for Mahalanobis).
+         *
+         * @param dataset Training dataset containing features and labels
+         * @param reduction Reduction method
+         * @param prototype_fraction Centroids per class as a fraction of its size, KMeans only (default: 0.1)
+         * @param seed Random seed for the visiting order and the centroid initialization (default: 41)
+         *
+         * @throws std::invalid_argument If prototype_fraction is not in (0, 1]
+         *
+         * Example usage:
+         * @code
+         * KNN model(5);
+         * model.fit(train_dataset, PrototypeReduction::Condensed);
+         * size_t kept = model.get_num_prototypes();
+         * @endcode
+         */
+        void fit(Dataset& dataset, PrototypeReduction reduction,
+                 double prototype_fraction = 0.1, uint64_t seed = 41);
+
+        /**
+         * @brief Trains the KNN model on bit-packed binary features.
+         *
+         * Stores the packed rows (1 bit per feature) and caches the popcount of each
+         * row, so Jaccard/Tanimoto comparisons need a single AND-popcount pass.
+         * Replaces any dense training data; use the BitMatrix predict overloads afterwards.
+         *
+         * @param features Bit-packed training features [samples][bits]
+         * @param labels Training labels [samples]
+         * @param metric Binary metric to use (default: BinaryMetric::Hamming)
+         *
+         * @throws std::invalid_argument If features and labels have different sizes
+         *
+         * @note Time complexity: O(n * d / 64)
+         *
+         * Example usage:
+         * @code
+         * KNN model(5);
+         * BitMatrix fingerprints = BitMatrix::from_features(train.get_features());
+         * model.fit(fingerprints, train.get_labels(), BinaryMetric::Tanimoto);
+         * @endcode
+         */
+        void fit(const BitMatrix& features, const std::vector<int>& labels,
+                 BinaryMetric metric = BinaryMetric::Hamming);
+
         /**
          * @brief Predicts the class label for a single sample.
          *
@@ -65,6 +168,9 @@ namespace mlcpp {
          * @param sample Feature vector of the sample to classify
          * @return Predicted class label (integer)
          *
+         * @throws std::logic_error If the model was fitted on bit-packed features
+         * @throws std::invalid_argument If a Mahalanobis model gets a different number of features than it was fitted on
+         *
          * @note Time complexity: O(n * d) where n = training samples, d = features
          * @note The model must be trained (fit) before calling this
          *
@@ -79,11 +185,16 @@ namespace mlcpp {
         /**
          * @brief Predicts class labels for multiple samples.
          *
-         * Applies the predict method to each sample in the input.
+         * Queries are processed in parallel blocks. For the euclidean, cosine and inner
+         * product metrics, each block is scored against the training set with a tiled
+         * dot-product kernel and the cached norms, instead of one comparison at a time.
          *
          * @param samples 2D vector where each row is a sample to classify
          * @return Vector of predicted labels, one for each input sample
          *
+         * @throws std::logic_error If the model was fitted on bit-packed features
+         * @throws std::invalid_argument If a Mahalanobis model gets a different number of features than it was fitted on
+         *
          * @note Time complexity: O(m * n * d) where m = test samples,
          *                        n = training samples, d = features
          *
@@ -96,6 +207,38 @@ namespace mlcpp {
          */
         std::vector<int> predict(const std::vector<std::vector<double>>& samples) const;
 
+        /**
+         * @brief Predicts the class label for one row of a bit-packed matrix.
+         *
+         * The scan over the training fingerprints is split across threads, each keeping
+         * its own k best, which are merged at the end.
+         *
+         * @param samples Bit-packed samples with the same number of bits as the training data
+         * @param row Index of the sample to classify
+         * @return Predicted class label (integer)
+         *
+         * @throws std::logic_error If the model was fitted on dense features
+         * @throws std::invalid_argument If samples has a different number of bits than the training data
+         *
+         * @note The model must be trained with fit(const BitMatrix&, ...) first
+         * @note Time complexity: O(n * d / 64) popcount operations
+         */
+        int predict(const BitMatrix& samples, size_t row) const;
+
+        /**
+         * @brief Predicts class labels for every row of a bit-packed matrix.
+         *
+         * @param samples Bit-packed samples with the same number of bits as the training data
+         * @return Vector of predicted labels, one for each row
+         *
+         * @throws std::logic_error If the model was fitted on dense features
+         * @throws std::invalid_argument If samples has a different number of bits than the training data
+         *
+         * @note Queries are processed in parallel
+         * @note Time complexity: O(m * n * d / 64) popcount operations
+         */
+        std::vector<int> predict(const BitMatrix& samples) const;
+
         /**
          * @brief Calculates the accuracy of the model on a test dataset.
          *
@@ -105,6 +248,8 @@ namespace mlcpp {
          * @param test_dataset Dataset containing test samples and their true labels
          * @return Accuracy as a value between 0.0 (0%) and 1.0 (100%)
          *
+         * @throws std::logic_error If the model was fitted on bit-packed features
+         *
          * @note The model must be trained before evaluation
          * @note Time complexity: O(m * n * d) where m = test samples
          *
@@ -116,6 +261,66 @@ namespace mlcpp {
          */
         double score(const Dataset& test_dataset) const;
 
+        /**
+         * @brief Leave-one-out accuracy over the fitted reference set, without refitting.
+         *
+         * Runs one all-pairs search (NeighborSearch::kneighbors_graph) that excludes each
+         * row from its own neighbor list, parallelized across rows, and votes with the
+         * remaining k nearest. The result equals fitting n models on n - 1 rows each.
+         *
+         * @return Fraction of reference rows predicted correctly by the others
+         *
+         * @throws std::logic_error If the model is not fitted on dense features
+         *
+         * @note With Mahalanobis, the whitening estimated on all rows is kept
+         * @note Time complexity: O(n² * d / threads), the cost of one batch prediction of the training set
+         *
+         * Example usage:
+         * @code
+         * model.fit(train_dataset);
+         * double loo = model.loo_score();
+         * @endcode
+         */
+        double loo_score() const;
+
+        /**
+         * @brief Leave-one-out accuracy for several values of k from a single search.
+         *
+         * The neighbor lists are computed once for the largest k and truncated for the
+         * others, so a whole k sweep costs one pass.
+         *
+         * @param k_values Values of k to evaluate (each at least 1)
+         * @return Accuracy for each value of k, in the same order
+         *
+         * @throws std::logic_error If the model is not fitted on dense features
+         * @throws std::invalid_argument If a value of k is below 1
+         *
+         * Example usage:
+         * @code
+         * vector<double> scores = model.loo_score({1, 3, 5, 7, 9});
+         * @endcode
+         */
+        std::vector<double> loo_score(const std::vector<int>& k_values) const;
+
+        /**
+         * @brief K-fold cross-validation accuracy over the fitted reference set, without refitting.
+         *
+         * Rows are assigned to folds at random. Every row needs its k nearest rows
+         * outside its own fold. These come from one shared neighbor list per row: a
+         * single all-pairs search for slightly more than k * n_folds / (n_folds - 1)
+         * neighbors, with same-fold rows filtered out. The few rows left short are
+         * searched again with a longer list. The result equals refitting on each
+         * training fold.
+         *
+         * @param n_folds Number of folds (default: 5)
+         * @param seed Random seed for the fold assignment (default: 41)
+         * @return Fraction of reference rows predicted correctly from the other folds
+         *
+         * @throws std::logic_error If the model is not fitted on dense features
+         * @throws std::invalid_argument If n_folds < 2 or exceeds the number of rows
+         */
+        double cv_score(int n_folds = 5, uint64_t seed = 41) const;
+
         /**
          * @brief Gets the number of neighbors (k) used by the classifier.
          *
@@ -123,24 +328,89 @@ namespace mlcpp {
          */
         int get_k() const { return k_; }
 
+        /**
+         * @brief Gets the number of reference rows kept after fit.
+         *
+         * @return Number of prototypes (all training rows without reduction)
+         */
+        size_t get_num_prototypes() const { return y_train_.size(); }
+
+        /**
+         * @brief Gets the neighbor search over the dense reference rows.
+         *
+         * @return Search engine holding the prototypes (whitened for Mahalanobis)
+         */
+        const NeighborSearch& get_search() const { return search_; }
+
+        /**
+         * @brief Gets the label of each reference row.
+         *
+         * @return Labels [prototypes]
+         */
+        const std::vector<int>& get_labels() const { return y_train_; }
+
+        /**
+         * @brief Checks whether queries are whitened before the search (Mahalanobis).
+         *
+         * @return true for models created with mahalanobis()
+         */
+        bool is_mahalanobis() const { return whitening_.has_value(); }
+
+        /**
+         * @brief Checks whether the model was trained on bit-packed features.
+         *
+         * @return true after fit(BitMatrix, ...)
+         */
+        bool is_binary() const { return binary_; }
+
     private:
         int k_;                                      ///< Number of nearest neighbors to consider
-        DistanceMetric distance_;                    ///< Distance metric function
-        std::vector<std::vector<double>> X_train_;   ///< Training features [samples][features]
+        NeighborSearch search_;                      ///< Neighbor engine over the dense training rows
         std::vector<int> y_train_;                   ///< Training labels [samples]
+        bool binary_ = false;                        ///< Whether the model was trained on bit-packed features
+        BinaryMetric binary_metric_ = BinaryMetric::Hamming;  ///< Metric for bit-packed features
+        BitMatrix bits_train_;                       ///< Bit-packed training features [samples][bits]
+        std::vector<uint32_t> train_popcounts_;      ///< Cached popcount of each packed training row [samples]
+        std::optional<MahalanobisWhitening> whitening_;  ///< Whitening applied to rows and queries (Mahalanobis only)
 
         /**
-         * @brief Finds the indices of the k nearest neighbors for a given sample.
+         * @brief Predicts labels for samples already in the space of the training rows (e.g. whitened).
          *
-         * Calculates distances from the sample to all training samples,
-         * then returns the indices of the k closest ones.
+         * @param samples 2D vector where each row is a sample to classify
+         * @return Vector of predicted labels
+         */
+        std::vector<int> predict_batch(const std::vector<std::vector<double>>& samples) const;
+
+        /**
+         * @brief Checks that bit-packed queries can be compared with the training rows.
+         *
+         * @param samples Bit-packed samples to classify
+         *
+         * @throws std::logic_error If the model was fitted on dense features
+         * @throws std::invalid_argument If samples has a different number of bits than the training data
+         */
+        void check_bit_samples(const BitMatrix& samples) const;
+
+        /**
+         * @brief Keeps the indices of the k lowest scores.
          *
-         * @param sample Feature vector to find neighbors for
-         * @return Vector of indices pointing to the k nearest training samples
+         * @param scored Pairs {score, training index}; reordered in place
+         * @return Indices of the k closest training samples, closest first
          *
          * @note Time complexity: O(n log k) using partial_sort
          */
-        std::vector<size_t> find_k_nearest(const std::vector<double>& sample) const;
+        std::vector<size_t> select_k_nearest(std::vector<std::pair<double, size_t>>& scored) const;
+
+        /**
+         * @brief Finds the k nearest bit-packed training rows to a packed query.
+         *
+         * @param query Packed query words (bits_train_.words_per_row() words)
+         * @param parallel Whether to split the scan over the training rows across threads
+         * @return Indices of the k closest training samples, closest first
+         *
+         * @note Each scan keeps a bounded max-heap (offer_neighbor()): O(k) memory per query and chunk
+         */
+        std::vector<size_t> find_k_nearest_bits(const uint64_t* query, bool parallel) const;
 
         /**
          * @brief Determines the predicted label by majority vote among neighbors.
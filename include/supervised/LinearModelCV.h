@@ -0,0 +1,120 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_LINEARMODELCV_H
+#define MLCPP_LINEARMODELCV_H
+#include <cstdint>
+#include <vector>
+
+namespace mlcpp {
+    /**
+     * @brief Result of cross-validating a least-squares model.
+     */
+    struct CVResult {
+        std::vector<double> fold_scores;    ///< MSE of each fold (one entry per row for leave-one-out)
+        double mean_score = 0.0;            ///< Mean of fold_scores
+        std::vector<double> predictions;    ///< Out-of-fold prediction of every row [samples]
+    };
+
+    /**
+     * @brief Fast cross-validation of least-squares (optionally ridge) linear regression.
+     *
+     * Fits the same model as LinearRegression with the normal equation, with an optional
+     * L2 penalty on the weights (the intercept is not penalized), without refitting per
+     * fold:
+     *
+     * - k_fold(): one parallel pass accumulates the normal equations ZᵀZ and Zᵀy of the
+     *   rows z = [1, x] of every fold. The system of a training split is the total minus
+     *   the block of the held-out fold, so each fold costs one O(d³) solve instead of an
+     *   O(n * d²) pass over the data.
+     * - leave_one_out(): solves the full system once and uses the closed form for linear
+     *   smoothers: the leave-one-out residual of row i is e_i / (1 - h_i), with e_i the
+     *   training residual and h_i = z_iᵀ (ZᵀZ + λR)⁻¹ z_i the leverage (hat-matrix diagonal).
+     *
+     * Both accept a list of ridge penalties and score all of them from the same data pass.
+     * Results match refitting on every training split up to rounding.
+     *
+     * Example usage:
+     * @code
+     * CVResult cv = LinearModelCV::k_fold(X, y, 10);
+     * cout << "10-fold MSE: " << cv.mean_score << endl;
+     *
+     * vector<CVResult> path = LinearModelCV::leave_one_out(X, y, {0.01, 0.1, 1.0, 10.0});
+     * @endcode
+     */
+    class LinearModelCV {
+    public:
+        /**
+         * @brief k-fold cross-validation with random balanced folds.
+         *
+         * @param X Features [samples][features]
+         * @param y Targets [samples]
+         * @param n_folds Number of folds (default: 5)
+         * @param seed Random seed of the fold assignment (default: 41)
+         * @param ridge L2 penalty on the weights (default: 0, ordinary least squares)
+         * @return Fold MSEs, their mean and the out-of-fold predictions
+         *
+         * @throws std::invalid_argument If sizes do not match, n_folds is not in [2, samples] or ridge < 0
+         *
+         * @note Time complexity: O(n * d² / threads + n_folds * d³)
+         */
+        static CVResult k_fold(const std::vector<std::vector<double>>& X,
+                               const std::vector<double>& y,
+                               int n_folds = 5,
+                               uint64_t seed = 41,
+                               double ridge = 0.0);
+
+        /**
+         * @brief k-fold cross-validation of several ridge penalties over the same folds.
+         *
+         * @param X Features [samples][features]
+         * @param y Targets [samples]
+         * @param ridges L2 penalties to score
+         * @param n_folds Number of folds (default: 5)
+         * @param seed Random seed of the fold assignment (default: 41)
+         * @return One result per penalty, in the order given
+         *
+         * @note Time complexity: O(n * d² / threads + ridges * n_folds * d³)
+         */
+        static std::vector<CVResult> k_fold(const std::vector<std::vector<double>>& X,
+                                            const std::vector<double>& y,
+                                            const std::vector<double>& ridges,
+                                            int n_folds = 5,
+                                            uint64_t seed = 41);
+
+        /**
+         * @brief Exact leave-one-out cross-validation from a single fit.
+         *
+         * @param X Features [samples][features]
+         * @param y Targets [samples]
+         * @param ridge L2 penalty on the weights (default: 0, ordinary least squares)
+         * @return Squared leave-one-out error per row, their mean and the leave-one-out predictions
+         *
+         * @throws std::invalid_argument If sizes do not match, there are not more rows than
+         *         parameters, or ridge < 0
+         *
+         * @note Time complexity: O(n * d² / threads + d³)
+         * @note A row with leverage 1 (the fit cannot predict it without it) gets an infinite error
+         */
+        static CVResult leave_one_out(const std::vector<std::vector<double>>& X,
+                                      const std::vector<double>& y,
+                                      double ridge = 0.0);
+
+        /**
+         * @brief Exact leave-one-out cross-validation of several ridge penalties.
+         *
+         * @param X Features [samples][features]
+         * @param y Targets [samples]
+         * @param ridges L2 penalties to score
+         * @return One result per penalty, in the order given
+         *
+         * @note Time complexity: O(n * d² / threads + ridges * (n * d² / threads + d³))
+         */
+        static std::vector<CVResult> leave_one_out(const std::vector<std::vector<double>>& X,
+                                                   const std::vector<double>& y,
+                                                   const std::vector<double>& ridges);
+    };
+}
+
+#endif //MLCPP_LINEARMODELCV_H
@@ -5,14 +5,32 @@
 #ifndef MLCPP_LINEARREGRESSION_H
 #define MLCPP_LINEARREGRESSION_H
 
+#include <cstdint>
+#include <optional>
 #include "../core/Dataset.h"
+#include "../core/DenseMatrix.h"
+#include "../core/Float32Matrix.h"
+#include "../core/SparseMatrix.h"
+#include "../io/Checkpoint.h"
+#include "../preprocessing/StandardScaler.h"
 
 namespace mlcpp {
+    /**
+     * @brief Preconditioner of the iterative least-squares solvers ("cg" and "lsqr").
+     */
+    enum class LeastSquaresPreconditioner {
+        None,       ///< Solve the system as given
+        Jacobi      ///< Scale every column of [1, X] to unit norm (diagonal of the normal equations)
+    };
+
     /**
      * @brief Linear Regression model for supervised learning.
      *
      * Fits a linear model to predict continuous target values using the
-     * Ordinary Least Squares (OLS) method or Gradient Descent.
+     * Ordinary Least Squares (OLS) method, Gradient Descent, or an iterative
+     * least-squares solver (CG on the normal equations, LSQR) that only needs
+     * matrix-vector products with the data, for wide or sparse problems, or a
+     * randomized sketch-and-solve for very tall problems.
      *
      * Model equation: y = w₀ + w₁*x₁ + w₂*x₂ + ... + wₙ*xₙ
      * where w₀ is the intercept (bias) and w₁...wₙ are the coefficients (weights).
@@ -23,16 +41,24 @@ namespace mlcpp {
          * @brief Constructs a Linear Regression model with specified method.
          *
          * @param learning_rate Learning rate for gradient descent (default: 0.01)
-         * @param n_iterations Number of iterations for gradient descent (default: 1000)
-         * @param method Training method: "normal" for Normal Equation, "gradient" for Gradient Descent (default: "normal")
+         * @param n_iterations Number of iterations for gradient descent, or the iteration limit of "cg" and "lsqr" (default: 1000)
+         * @param method Training method: "normal" for Normal Equation, "gradient" for Gradient Descent,
+         *               "cg" for Conjugate Gradient on the normal equations (CGLS), "lsqr" for LSQR,
+         *               "sketch" for sketch-and-solve with CountSketch (default: "normal")
+         *
+         * @throws std::invalid_argument If method is not one of the above
          *
          * @note Normal Equation is faster for small datasets (< 10,000 samples)
          * @note Gradient Descent is better for large datasets
+         * @note "cg" and "lsqr" never form XᵀX: use them for wide or sparse data (LSQR is the more stable of the two)
+         * @note "sketch" reads the data once to build a small sketch, then refines with n_iterations
+         *       cheap passes at most: use it for tall data (n >> d)
          *
          * Example usage:
          * @code
          * LinearRegression model1;                           // Normal Equation (default)
          * LinearRegression model2(0.01, 1000, "gradient");   // Gradient Descent
+         * LinearRegression model3(0.0, 500, "lsqr");         // LSQR, at most 500 iterations
          * @endcode
          */
         explicit LinearRegression(double learning_rate = 0.01,
@@ -45,8 +71,14 @@ namespace mlcpp {
          * Fits the model to the training data using either Normal Equation
          * or Gradient Descent depending on the method specified in constructor.
          *
+         * With sample weights, minimizes Σ wᵢ (yᵢ - ŷᵢ)² (weighted least squares) with
+         * every method.
+         *
          * @param X_train Training features [samples][features]
          * @param y_train Training target values [samples]
+         * @param sample_weight Non-negative weight of each sample, or empty for unit weights (default: empty)
+         *
+         * @throws std::invalid_argument If X is empty, sizes do not match or a weight is negative
          *
          * @note Features should be normalized/standardized for best results with Gradient Descent
          * @note Time complexity: O(n * d²) for Normal Equation, O(iterations * n * d) for Gradient Descent
@@ -55,10 +87,12 @@ namespace mlcpp {
          * @code
          * LinearRegression model;
          * model.fit(X_train, y_train);
+         * model.fit(X_train, y_train, weights);   // Weighted least squares
          * @endcode
          */
         void fit(const std::vector<std::vector<double>>& X_train,
-                const std::vector<double>& y_train);
+                const std::vector<double>& y_train,
+                const std::vector<double>& sample_weight = {});
 
         /**
          * @brief Predicts target value for a single sample.
@@ -91,6 +125,338 @@ namespace mlcpp {
          */
         std::vector<double> predict(const std::vector<std::vector<double>>& X_test) const;
 
+        /**
+         * @brief Trains on contiguous features with the "cg", "lsqr" or "sketch" method.
+         *
+         * Each iteration is one product with X and one with Xᵀ, parallel over rows;
+         * the intercept column is implicit, so X is never copied or centered.
+         *
+         * @param X_train Training features
+         * @param y_train Training target values [samples]
+         * @param sample_weight Non-negative weight of each sample, or empty for unit weights (default: empty)
+         *
+         * @throws std::invalid_argument If the method is not "cg", "lsqr" or "sketch", or sizes do not match
+         *
+         * @note Time complexity: O(iterations * n * d / threads)
+         */
+        void fit(const DenseMatrix& X_train, const std::vector<double>& y_train,
+                 const std::vector<double>& sample_weight = {});
+
+        /**
+         * @brief Trains on CSR sparse features with the "cg", "lsqr" or "sketch" method.
+         *
+         * @param X_train Training features
+         * @param y_train Training target values [samples]
+         * @param sample_weight Non-negative weight of each sample, or empty for unit weights (default: empty)
+         *
+         * @throws std::invalid_argument If the method is not "cg", "lsqr" or "sketch", or sizes do not match
+         *
+         * @note Time complexity: O(iterations * non-zeros / threads)
+         *
+         * Example usage:
+         * @code
+         * LinearRegression model(0.0, 200, "lsqr");
+         * model.set_tolerance(1e-6);
+         * model.fit(SparseMatrix::from_dense(X_train), y_train);
+         * @endcode
+         */
+        void fit(const SparseMatrix& X_train, const std::vector<double>& y_train,
+                 const std::vector<double>& sample_weight = {});
+
+        /**
+         * @brief Trains on float32 features with any method (mixed precision).
+         *
+         * The data is stored and streamed as floats; every kernel accumulates in double.
+         * "normal" builds the Gram matrix in double from the widened rows, then applies
+         * set_refinement_steps() corrections whose residuals are recomputed from the
+         * data; "gradient" runs the same epochs as the double path; "cg", "lsqr" and
+         * "sketch" use the float matrix-vector products.
+         *
+         * The solution is that of the float-rounded features: it differs from a fit on
+         * the double data by about cond(X) * 6e-8 relative (2⁻²⁴ per stored value).
+         *
+         * @param X_train Training features
+         * @param y_train Training target values [samples]
+         * @param sample_weight Non-negative weight of each sample, or empty for unit weights (default: empty)
+         *
+         * @throws std::invalid_argument If X_train is empty or sizes do not match
+         *
+         * @note Reads half the bytes of the DenseMatrix overload per pass over the data
+         *
+         * Example usage:
+         * @code
+         * LinearRegression model;                // Normal Equation
+         * model.set_refinement_steps(1);
+         * model.fit(Float32Matrix::from_rows(X_train), y_train);
+         * @endcode
+         */
+        void fit(const Float32Matrix& X_train, const std::vector<double>& y_train,
+                 const std::vector<double>& sample_weight = {});
+
+        /**
+         * @brief Predicts target values for contiguous samples.
+         *
+         * @param X_test Test features
+         * @return Vector of predicted values
+         *
+         * @throws std::logic_error If the model is not fitted
+         * @throws std::invalid_argument If the number of features differs from the training data
+         */
+        std::vector<double> predict(const DenseMatrix& X_test) const;
+
+        /**
+         * @brief Predicts target values for CSR sparse samples.
+         *
+         * @param X_test Test features
+         * @return Vector of predicted values
+         *
+         * @throws std::logic_error If the model is not fitted
+         * @throws std::invalid_argument If the number of features differs from the training data
+         */
+        std::vector<double> predict(const SparseMatrix& X_test) const;
+
+        /**
+         * @brief Predicts target values for float32 samples (accumulated in double).
+         *
+         * @param X_test Test features
+         * @return Vector of predicted values
+         *
+         * @throws std::logic_error If the model is not fitted
+         * @throws std::invalid_argument If the number of features differs from the training data
+         */
+        std::vector<double> predict(const Float32Matrix& X_test) const;
+
+        /**
+         * @brief Sets the iterative refinement steps of the "normal" method.
+         *
+         * Each step computes the residual Zᵀ W (y - Z θ) of the normal equations in one
+         * pass over the data and adds the correction solved with the existing Cholesky
+         * factor (O(n * d / threads + d²) per step). This recovers accuracy lost to
+         * rounding in the Gram accumulation and to the ridge added to singular systems.
+         *
+         * @param steps Refinement steps, 0 to disable (default: 0)
+         *
+         * @throws std::invalid_argument If steps < 0
+         */
+        void set_refinement_steps(int steps);
+
+        /**
+         * @brief Sets the stopping tolerance of the "cg" and "lsqr" methods.
+         *
+         * CG stops when |Zᵀr| <= tol * |Zᵀy|; LSQR stops when |Zᵀr| <= tol * |Z| * |r|
+         * or |r| <= tol * |y| (Z = [1, X] after preconditioning, r = y - Zθ).
+         *
+         * @param tol Relative tolerance (default: 1e-8)
+         *
+         * @throws std::invalid_argument If tol <= 0
+         */
+        void set_tolerance(double tol);
+
+        /**
+         * @brief Sets the preconditioner of the "cg" and "lsqr" methods.
+         *
+         * @param preconditioner LeastSquaresPreconditioner::Jacobi (default) or None
+         */
+        void set_preconditioner(LeastSquaresPreconditioner preconditioner) { preconditioner_ = preconditioner; }
+
+        /**
+         * @brief Sets the sketch used by the "sketch" method.
+         *
+         * Every row is added, with a random sign, to one of sketch_rows buckets
+         * (CountSketch), so the sketch costs one pass over the data. The sketched
+         * system is solved exactly; up to n_iterations steps of conjugate gradient
+         * preconditioned by it then refine the solution to the tolerance (each step
+         * is one pass over the data, O(n * d) instead of the O(n * d²) Gram pass).
+         *
+         * @param sketch_rows Rows of the sketch, 0 for 20 * (features + 1) (default: 0)
+         * @param seed Random seed of the row hashes (default: 41)
+         *
+         * @note Each thread keeps a sketch_rows x (features + 2) buffer during the pass
+         */
+        void set_sketch_size(size_t sketch_rows, uint64_t seed = 41);
+
+        /**
+         * @brief Gets the iterations run by the last "cg", "lsqr" or "sketch" fit.
+         *
+         * @return Number of iterations, refinement steps for "sketch" (0 for the other methods)
+         */
+        int get_n_iter() const { return n_iter_; }
+
+        /**
+         * @brief Enables periodic checkpoints of the "gradient" method.
+         *
+         * Every every_epochs epochs, and once at the end, the weights, bias and epoch
+         * count are handed to a CheckpointWriter, which writes them on a background
+         * thread: the training loop only copies d + 1 values. A killed run can be
+         * continued with resume_from() and the same data.
+         *
+         * @param path Checkpoint file path, empty to disable checkpoints
+         * @param every_epochs Epochs between checkpoints (default: 100)
+         *
+         * @throws std::invalid_argument If every_epochs < 1
+         *
+         * @note fit() waits for the final checkpoint and throws std::runtime_error if it
+         *       could not be written; the fitted weights are kept
+         *
+         * Example usage:
+         * @code
+         * LinearRegression model(0.01, 100000, "gradient");
+         * model.set_checkpoint("model.ckpt", 500);
+         * model.resume_from("model.ckpt");   // No-op on the first run
+         * model.fit(X_train, y_train);
+         * @endcode
+         */
+        void set_checkpoint(const std::string& path, int every_epochs = 100);
+
+        /**
+         * @brief Makes the next "gradient" fit continue from a checkpoint.
+         *
+         * The next fit() starts from the saved weights and bias at the saved epoch and
+         * runs the remaining n_iterations - epoch epochs.
+         *
+         * @param path Checkpoint written by set_checkpoint()
+         * @return true if a valid LinearRegression checkpoint was loaded; false leaves
+         *         the next fit starting from scratch
+         *
+         * @note fit() throws std::invalid_argument if the data has a different number of features
+         */
+        bool resume_from(const std::string& path);
+
+        /**
+         * @brief Trains one linear model per target column, sharing a single factorization.
+         *
+         * Always uses the normal equation: the Gram matrix of the rows [1, x] is
+         * accumulated and factored once, ZᵀY is computed as one matrix product, and all
+         * targets are solved together with one blocked triangular solve. Replaces any
+         * single-target fit (get_weights() is cleared).
+         *
+         * @param X_train Training features [samples][features]
+         * @param Y_train Training targets [samples][targets]
+         *
+         * @throws std::invalid_argument If X is empty, sizes do not match or Y rows differ in length
+         *
+         * @note Time complexity: O(n * d² / threads + n * d * t / threads + d³ + d² * t)
+         *
+         * Example usage:
+         * @code
+         * LinearRegression model;
+         * model.fit(X_train, Y_train);                                  // Y_train[i] holds every target of row i
+         * vector<vector<double>> predictions = model.predict_multi(X_test);
+         * @endcode
+         */
+        void fit(const std::vector<std::vector<double>>& X_train,
+                 const std::vector<std::vector<double>>& Y_train);
+
+        /**
+         * @brief Predicts every target of a multi-output model for multiple samples.
+         *
+         * Computed as one matrix product X * W plus the intercepts.
+         *
+         * @param X_test Test features [samples][features]
+         * @return Predictions [samples][targets]
+         *
+         * @throws std::logic_error If the model was not fitted on a target matrix
+         * @throws std::invalid_argument If a sample has a different number of features
+         */
+        std::vector<std::vector<double>> predict_multi(const std::vector<std::vector<double>>& X_test) const;
+
+
+        /**
+         * @brief Updates the fitted model with one new labelled row (recursive least squares).
+         *
+         * Maintains the inverse Gram matrix P = (ZᵀZ)⁻¹ over the rows z = [1, x] with the
+         * Sherman–Morrison formula, so the weights are the exact least-squares solution over
+         * all rows seen (fit() plus updates), refreshed in O(d²) instead of a refit.
+         * With a forgetting factor λ < 1, older rows are down-weighted by λ per new row.
+         *
+         * If the model was not fitted with the normal equation, updates start from the
+         * current weights with P = 1e6 * I (a weak prior).
+         *
+         * @param x Feature vector
+         * @param y Target value
+         *
+         * @throws std::invalid_argument If x has a different number of features than the model
+         *
+         * @note Time complexity: O(d²)
+         *
+         * Example usage:
+         * @code
+         * model.fit(X_train, y_train);
+         * model.set_forgetting_factor(0.999);   // Optional: track drift
+         * model.update(x_new, y_new);
+         * @endcode
+         */
+        void update(const std::vector<double>& x, double y);
+
+        /**
+         * @brief Updates the fitted model with a batch of labelled rows.
+         *
+         * Rows are folded in blocks with the Woodbury identity (a rank-k update per
+         * block), which gives the same result as calling update() row by row,
+         * including the forgetting factor. The weights and the inverse Gram matrix are
+         * updated on copies and committed together, so the model is unchanged if it throws.
+         *
+         * @param X New rows [samples][features]
+         * @param y New targets [samples]
+         *
+         * @throws std::invalid_argument If sizes do not match, the number of features differs
+         *         or a block leaves the update numerically indefinite
+         *
+         * @note Time complexity: O(m * d² + m * k * d) for m rows in blocks of k
+         */
+        void update_batch(const std::vector<std::vector<double>>& X, const std::vector<double>& y);
+
+        /**
+         * @brief Sets the forgetting factor used by update() and update_batch().
+         *
+         * @param lambda Weight multiplier applied to past rows per new row, in (0, 1] (1 = no forgetting)
+         *
+         * @throws std::invalid_argument If lambda is not in (0, 1]
+         */
+        void set_forgetting_factor(double lambda);
+
+        /**
+         * @brief Folds a feature standardization into the model so it takes raw features.
+         *
+         * For a model fitted on z_j = (x_j - mean_j) / scale_j, rewrites
+         *
+         *     w_j  <-  w_j / scale_j
+         *     b    <-  b - Σ_j w_j * mean_j / scale_j
+         *
+         * so predict() on raw x gives the same values, with a single dot product and no
+         * transform pass. Multi-output coefficients and the inverse Gram matrix kept for
+         * update() are mapped as well, so online updates continue on raw features.
+         *
+         * @param mean Per-feature mean subtracted before fitting
+         * @param scale Per-feature divisor applied before fitting (all positive)
+         *
+         * @throws std::logic_error If the model is not fitted
+         * @throws std::invalid_argument If the sizes differ from the number of features or a scale is not positive
+         *
+         * @note Time complexity: O(d) for the weights, O(d²) if the inverse Gram matrix is kept
+         *
+         * Example usage:
+         * @code
+         * auto [means, std_devs] = dataset.standardize();
+         * model.fit(dataset.get_features(), targets);
+         * model.fold_scaler(means, std_devs);
+         * @endcode
+         */
+        void fold_scaler(const std::vector<double>& mean, const std::vector<double>& scale);
+
+        /**
+         * @brief Folds a fitted StandardScaler into the model (see fold_scaler(mean, scale)).
+         *
+         * @param scaler Scaler whose transform was applied to the training features
+         */
+        void fold_scaler(const StandardScaler& scaler);
+
+        /**
+         * @brief Gets the forgetting factor.
+         *
+         * @return lambda in (0, 1]
+         */
+        double get_forgetting_factor() const { return forgetting_; }
 
         /**
          * @brief Gets the model coefficients (weights).
@@ -106,40 +472,130 @@ namespace mlcpp {
          */
         double get_bias() const { return bias_; }
 
+        /**
+         * @brief Gets the coefficients of a multi-output model.
+         *
+         * @return Weights [features][targets], column t belongs to target t
+         */
+        const std::vector<std::vector<double>>& get_coefficients() const { return coefficients_; }
+
+        /**
+         * @brief Gets the intercepts of a multi-output model.
+         *
+         * @return Bias of each target [targets]
+         */
+        const std::vector<double>& get_intercepts() const { return intercepts_; }
+
     private:
         double alpha_;        ///< Learning rate for gradient descent
         int epochs_;            ///< Number of iterations for gradient descent
         std::string method_;          ///< Training method: "normal" or "gradient"
         std::vector<double> weights_; ///< Model coefficients [features]
-        double bias_;            ///< Bias term
+        double bias_ = 0.0;      ///< Bias term
+        std::vector<std::vector<double>> inverse_gram_;  ///< (ZᵀZ)⁻¹ over rows z = [1, x], kept by the online updates
+        double forgetting_ = 1.0;   ///< Forgetting factor of the online updates
+        std::vector<std::vector<double>> coefficients_;  ///< Multi-output weights [features][targets]
+        std::vector<double> intercepts_;    ///< Multi-output biases [targets]
+        double tolerance_ = 1e-8;   ///< Stopping tolerance of "cg" and "lsqr"
+        LeastSquaresPreconditioner preconditioner_ = LeastSquaresPreconditioner::Jacobi;   ///< Preconditioner of "cg" and "lsqr"
+        int n_iter_ = 0;            ///< Iterations of the last iterative fit
+        size_t sketch_size_ = 0;    ///< Rows of the CountSketch (0 = automatic)
+        uint64_t sketch_seed_ = 41; ///< Seed of the CountSketch row hashes
+        std::string checkpoint_path_;   ///< Checkpoint file of the "gradient" method, empty if disabled
+        int checkpoint_every_ = 100;    ///< Epochs between checkpoints
+        std::optional<TrainingState> resume_;   ///< State the next "gradient" fit starts from
+        int refinement_steps_ = 0;  ///< Iterative refinement steps after a "normal" solve
 
         /**
          * @brief Trains using the Normal Equation (closed-form solution).
          *
          * Calculates weights using: w = (X^T * X)^-1 * X^T * y
          *
-         * @param X Training features with intercept column
+         * The Gram matrix of the rows [1, x] is accumulated in one parallel pass and
+         * solved with a Cholesky factorization; its inverse is kept for update().
+         *
+         * @param X Training features (the intercept column is implicit)
          * @param y Training targets
+         * @param weights Sample weights, or empty (solves ZᵀWZ θ = ZᵀWy)
          *
-         * @note Time complexity: O(n * d² + d³) where n = samples, d = features
-         * @note Requires matrix inversion - may be numerically unstable
+         * @note Time complexity: O(n * d² / threads + d³) where n = samples, d = features
+         * @note A tiny ridge is added to the diagonal if the Gram matrix is singular
          */
         void fit_normal_equation(const std::vector<std::vector<double>>& X,
-                                const std::vector<double>& y);
+                                const std::vector<double>& y,
+                                const std::vector<double>& weights);
+
+        /**
+         * @brief Solves accumulated normal equations by Cholesky, with optional iterative refinement.
+         *
+         * @param X Training features providing row_dot() and row_axpy() for the residual passes
+         * @param y Training targets
+         * @param weights Sample weights, or empty
+         * @param gram ZᵀWZ over the rows z = [1, x]
+         * @param rhs ZᵀWy
+         */
+        template<typename Matrix>
+        void solve_normal(const Matrix& X, const std::vector<double>& y, const std::vector<double>& weights,
+                          const std::vector<std::vector<double>>& gram, const std::vector<double>& rhs);
+
+        /**
+         * @brief Trains with CGLS or LSQR using only products with X and Xᵀ.
+         *
+         * @param X Training features (DenseMatrix, SparseMatrix or Float32Matrix)
+         * @param y Training targets
+         * @param weights Sample weights, or empty (rows and targets are scaled by √w)
+         */
+        template<typename Matrix>
+        void fit_iterative(const Matrix& X, const std::vector<double>& y, const std::vector<double>& weights);
+
+        /**
+         * @brief Trains with CountSketch sketch-and-solve plus preconditioned CG refinement.
+         *
+         * @param X Training features (DenseMatrix, SparseMatrix or Float32Matrix)
+         * @param y Training targets
+         * @param weights Sample weights, or empty
+         */
+        template<typename Matrix>
+        void fit_sketch(const Matrix& X, const std::vector<double>& y, const std::vector<double>& weights);
+
+        /**
+         * @brief Dispatches a DenseMatrix, SparseMatrix or Float32Matrix fit to fit_sketch() or fit_iterative().
+         */
+        template<typename Matrix>
+        void fit_matrix(const Matrix& X, const std::vector<double>& y, const std::vector<double>& weights);
+
+        /**
+         * @brief Computes X * w + bias for DenseMatrix, SparseMatrix or Float32Matrix samples.
+         */
+        template<typename Matrix>
+        std::vector<double> predict_matrix(const Matrix& X) const;
+
+        /**
+         * @brief Gets the parameters as one vector [bias, w₁, ..., wₙ].
+         */
+        std::vector<double> parameters() const;
+
+        /**
+         * @brief Stores parameters given as [bias, w₁, ..., wₙ].
+         */
+        void set_parameters(const std::vector<double>& theta);
 
         /**
          * @brief Trains using Gradient Descent optimization.
          *
          * Iteratively updates weights to minimize MSE loss function.
          *
-         * @param X Training features with intercept column
+         * @param X Training features providing row_dot() and row_axpy() (the intercept is learned separately)
          * @param y Training targets
+         * @param weights Sample weights, or empty
          *
-         * @note Time complexity: O(iterations * n * d)
+         * @note Time complexity: O(iterations * n * d / threads)
          * @note Requires careful tuning of learning_rate and n_iterations
          */
-        void fit_gradient_descent(const std::vector<std::vector<double>>& X,
-                                 const std::vector<double>& y);
+        template<typename Matrix>
+        void fit_gradient_descent(const Matrix& X,
+                                 const std::vector<double>& y,
+                                 const std::vector<double>& weights);
 
 
     };
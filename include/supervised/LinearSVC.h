@@ -0,0 +1,228 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_LINEARSVC_H
+#define MLCPP_LINEARSVC_H
+#include <cstdint>
+#include <vector>
+#include "../core/Dataset.h"
+#include "../core/DenseMatrix.h"
+#include "../core/SparseMatrix.h"
+
+namespace mlcpp {
+    /**
+     * @brief Margin losses supported by LinearSVC.
+     */
+    enum class SVCLoss {
+        Hinge,          ///< max(0, 1 - y f), the standard L1-loss SVM
+        SquaredHinge    ///< max(0, 1 - y f)², smooth and usually faster to solve
+    };
+
+    /**
+     * @brief Linear support vector machine trained by dual coordinate descent.
+     *
+     * Solves the dual of min_w ½||w||² + C Σ loss(y_i w·x_i) one coordinate at a time
+     * (Hsieh et al., 2008). Each step updates a single dual variable in closed form
+     * and keeps w = Σ α_i y_i x_i in sync, so an epoch costs one pass over the
+     * non-zeros. Samples are visited in a fresh random permutation every epoch
+     * (CounterRng), and shrinking drops samples whose dual variables are stuck at a
+     * bound from the active set; the full set is re-checked before declaring
+     * convergence. Training stops when the spread of the projected gradient falls
+     * below tol.
+     *
+     * Data can be dense (DenseMatrix, or a Dataset copied into one) or sparse CSR
+     * (SparseMatrix); the solver is shared through their row kernels. The intercept is
+     * learned as the weight of a constant feature of value intercept_scaling, so it
+     * is regularized like the other weights.
+     *
+     * Multiclass problems are solved one-vs-rest, one binary problem per class in
+     * parallel.
+     *
+     * Example usage:
+     * @code
+     * LinearSVC svm(1.0);
+     * svm.fit(X_sparse, labels);          // SparseMatrix, millions of rows
+     * vector<int> predicted = svm.predict(X_sparse_test);
+     * @endcode
+     */
+    class LinearSVC {
+    public:
+        /**
+         * @brief Constructs a linear SVM.
+         *
+         * @param C Inverse regularization strength (default: 1.0)
+         * @param loss Margin loss (default: SquaredHinge)
+         * @param tol Stopping tolerance on the projected gradient spread (default: 1e-3)
+         * @param max_iter Maximum number of epochs per binary problem (default: 1000)
+         * @param fit_intercept Whether to learn an intercept (default: true)
+         * @param intercept_scaling Value of the constant intercept feature (default: 1.0)
+         * @param seed Random seed for the epoch permutations (default: 41)
+         *
+         * @throws std::invalid_argument If C, tol or intercept_scaling is not positive
+         */
+        explicit LinearSVC(double C = 1.0,
+                           SVCLoss loss = SVCLoss::SquaredHinge,
+                           double tol = 1e-3,
+                           int max_iter = 1000,
+                           bool fit_intercept = true,
+                           double intercept_scaling = 1.0,
+                           uint64_t seed = 41);
+
+        /**
+         * @brief Trains the model on a dense dataset.
+         *
+         * @param dataset Training dataset containing features and integer labels
+         *
+         * @throws std::invalid_argument If the dataset is empty or has a single class
+         *
+         * @note Time complexity: O(epochs * n * d), one binary problem per class in parallel
+         */
+        void fit(const Dataset& dataset);
+
+        /**
+         * @brief Trains the model on dense contiguous data.
+         *
+         * @param X Training features
+         * @param labels Integer label of each sample
+         *
+         * @throws std::invalid_argument If sizes do not match, X is empty or there is a single class
+         */
+        void fit(const DenseMatrix& X, const std::vector<int>& labels);
+
+        /**
+         * @brief Trains the model on sparse CSR data.
+         *
+         * @param X Training features
+         * @param labels Integer label of each sample
+         *
+         * @throws std::invalid_argument If sizes do not match, X is empty or there is a single class
+         *
+         * @note Time complexity: O(epochs * non-zeros)
+         */
+        void fit(const SparseMatrix& X, const std::vector<int>& labels);
+
+        /**
+         * @brief Computes the signed distances to the hyperplanes.
+         *
+         * @param X Samples
+         * @return Scores [samples * get_weights().size()]: one column for binary problems
+         *         (positive means the second class), one per class otherwise
+         *
+         * @throws std::logic_error If the model is not fitted
+         */
+        std::vector<double> decision_function(const DenseMatrix& X) const;
+
+        /**
+         * @brief Computes the signed distances to the hyperplanes for sparse samples.
+         *
+         * @param X Samples
+         * @return Scores [samples * get_weights().size()]
+         *
+         * @throws std::logic_error If the model is not fitted
+         */
+        std::vector<double> decision_function(const SparseMatrix& X) const;
+
+        /**
+         * @brief Predicts the class label for a single sample.
+         *
+         * @param sample Feature vector
+         * @return Predicted class
+         *
+         * @throws std::logic_error If the model is not fitted
+         */
+        int predict(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Predicts class labels for multiple samples.
+         *
+         * @param samples 2D vector where each row is a sample to classify
+         * @return Vector of predicted labels
+         */
+        std::vector<int> predict(const std::vector<std::vector<double>>& samples) const;
+
+        /**
+         * @brief Predicts class labels for dense contiguous samples.
+         *
+         * @param X Samples
+         * @return Vector of predicted labels
+         */
+        std::vector<int> predict(const DenseMatrix& X) const;
+
+        /**
+         * @brief Predicts class labels for sparse samples.
+         *
+         * @param X Samples
+         * @return Vector of predicted labels
+         */
+        std::vector<int> predict(const SparseMatrix& X) const;
+
+        /**
+         * @brief Calculates the accuracy of the model on a test dataset.
+         *
+         * @param test_dataset Dataset containing test samples and their true labels
+         * @return Accuracy as a value between 0.0 and 1.0
+         */
+        double score(const Dataset& test_dataset) const;
+
+        /**
+         * @brief Gets the weight vectors.
+         *
+         * @return Weights [1 or classes][features]
+         */
+        const std::vector<std::vector<double>>& get_weights() const { return weights_; }
+
+        /**
+         * @brief Gets the intercepts.
+         *
+         * @return One intercept per weight vector
+         */
+        const std::vector<double>& get_bias() const { return bias_; }
+
+        /**
+         * @brief Gets the class labels seen during training.
+         *
+         * @return Sorted distinct labels
+         */
+        const std::vector<int>& get_classes() const { return classes_; }
+
+        /**
+         * @brief Gets the number of epochs run by the slowest binary problem.
+         *
+         * @return Epoch count, equal to max_iter if some problem did not converge
+         */
+        int get_n_iter() const { return n_iter_; }
+
+    private:
+        double C_;                                  ///< Inverse regularization strength
+        SVCLoss loss_;                              ///< Margin loss
+        double tol_;                                ///< Projected gradient tolerance
+        int max_iter_;                              ///< Maximum epochs per problem
+        bool fit_intercept_;                        ///< Whether to learn an intercept
+        double intercept_scaling_;                  ///< Value of the constant feature
+        uint64_t seed_;                             ///< Random seed
+        std::vector<int> classes_;                  ///< Sorted distinct labels
+        std::vector<std::vector<double>> weights_;  ///< Weights [problems][features]
+        std::vector<double> bias_;                  ///< Intercept per problem
+        int n_iter_ = 0;                            ///< Epochs of the slowest problem
+
+        /**
+         * @brief Solves every one-vs-rest problem on either storage format.
+         */
+        template<typename Matrix>
+        void fit_matrix(const Matrix& X, const std::vector<int>& labels);
+
+        /**
+         * @brief Computes the decision scores on either storage format.
+         */
+        template<typename Matrix>
+        std::vector<double> decision_matrix(const Matrix& X) const;
+
+        /**
+         * @brief Converts decision scores to labels.
+         */
+        std::vector<int> scores_to_labels(const std::vector<double>& scores) const;
+    };
+}
+
+#endif //MLCPP_LINEARSVC_H
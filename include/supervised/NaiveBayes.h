@@ -0,0 +1,282 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_NAIVEBAYES_H
+#define MLCPP_NAIVEBAYES_H
+#include <vector>
+#include "../core/Dataset.h"
+
+namespace mlcpp {
+    /**
+     * @brief Naive Bayes classifier base (shared prediction engine).
+     *
+     * Every Naive Bayes model here has a joint log-likelihood of the form
+     *
+     *     log P(c) + log P(x | c) = bias[c] + Σ_j x_j * linear[j][c] + x_j² * quadratic[j][c]
+     *
+     * so prediction is a single matrix-vector product over the features, with the
+     * weights laid out [features][classes] so the inner loop runs over contiguous
+     * classes. The per-class sufficient statistics are accumulated in one parallel
+     * pass (one mergeable accumulator per chunk), which is also how partial_fit()
+     * folds new batches into a fitted model.
+     *
+     * Class labels are the integer labels of the Dataset, used as they are.
+     *
+     * Use GaussianNB or MultinomialNB.
+     */
+    class NaiveBayes {
+    public:
+        /**
+         * @brief Predicts the class label for a single sample.
+         *
+         * @param sample Feature vector
+         * @return Class with the highest posterior probability
+         *
+         * @throws std::logic_error If the model is not fitted
+         *
+         * @note Time complexity: O(d * classes), no distance computations
+         */
+        int predict(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Predicts class labels for multiple samples.
+         *
+         * @param samples 2D vector where each row is a sample to classify
+         * @return Vector of predicted labels
+         *
+         * @throws std::logic_error If the model is not fitted
+         */
+        std::vector<int> predict(const std::vector<std::vector<double>>& samples) const;
+
+        /**
+         * @brief Predicts the class probabilities for multiple samples.
+         *
+         * @param samples 2D vector where each row is a sample
+         * @return Probabilities [samples][classes], classes ordered as get_classes()
+         *
+         * @throws std::logic_error If the model is not fitted
+         */
+        std::vector<std::vector<double>> predict_proba(const std::vector<std::vector<double>>& samples) const;
+
+        /**
+         * @brief Calculates the accuracy of the model on a test dataset.
+         *
+         * @param test_dataset Dataset containing test samples and their true labels
+         * @return Accuracy as a value between 0.0 and 1.0
+         */
+        double score(const Dataset& test_dataset) const;
+
+        /**
+         * @brief Gets the class labels seen during training.
+         *
+         * @return Sorted distinct labels
+         */
+        const std::vector<int>& get_classes() const { return classes_; }
+
+        /**
+         * @brief Gets the number of training samples seen for each class.
+         *
+         * @return Counts ordered as get_classes()
+         */
+        const std::vector<double>& get_class_counts() const { return class_counts_; }
+
+    protected:
+        std::vector<int> classes_;          ///< Sorted distinct labels
+        std::vector<double> class_counts_;  ///< Samples seen per class
+        size_t n_features_ = 0;             ///< Number of features
+        std::vector<double> bias_;          ///< Constant term per class [classes]
+        std::vector<double> linear_;        ///< Weights of x [features][classes]
+        std::vector<double> quadratic_;     ///< Weights of x² [features][classes], empty if unused
+        std::vector<double> shift_;         ///< Subtracted from x before scoring [features], empty if unused
+
+        /**
+         * @brief Adds unseen labels to classes_ (kept sorted) and class_counts_.
+         *
+         * @param labels Labels of a new batch
+         * @return New index of each previously known class
+         */
+        std::vector<size_t> merge_classes(const std::vector<int>& labels);
+
+        /**
+         * @brief Gets the index of a known label in classes_.
+         */
+        size_t class_index(int label) const;
+
+        /**
+         * @brief Computes the joint log-likelihood of one sample for every class.
+         *
+         * @param sample Pointer to n_features_ values
+         * @param scores Pointer to classes_.size() values, overwritten
+         */
+        void joint_log_likelihood(const double* sample, double* scores) const;
+
+        /**
+         * @brief Computes the joint log-likelihoods of a batch in parallel.
+         *
+         * @param samples Samples [samples][features]
+         * @return Scores [samples * classes]
+         *
+         * @throws std::logic_error If the model is not fitted
+         * @throws std::invalid_argument If a sample has the wrong number of features
+         */
+        std::vector<double> joint_log_likelihood(const std::vector<std::vector<double>>& samples) const;
+    };
+
+    /**
+     * @brief Gaussian Naive Bayes: features are independent normals within each class.
+     *
+     * Per-class counts, means and sums of squared deviations are accumulated with
+     * Welford's update and merged across chunks and batches with Chan's formula, so
+     * fit() reads the data once and partial_fit() gives the same model as fitting
+     * all batches at once.
+     *
+     * Example usage:
+     * @code
+     * GaussianNB model;
+     * model.fit(train_dataset);
+     * model.partial_fit(new_batch);   // Streaming update
+     * double accuracy = model.score(test_dataset);
+     * @endcode
+     */
+    class GaussianNB : public NaiveBayes {
+    public:
+        /**
+         * @brief Constructs a Gaussian Naive Bayes classifier.
+         *
+         * @param var_smoothing Fraction of the largest feature variance added to every
+         *                      variance for stability (default: 1e-9)
+         */
+        explicit GaussianNB(double var_smoothing = 1e-9);
+
+        /**
+         * @brief Trains the model from scratch.
+         *
+         * @param dataset Training dataset containing features and integer labels
+         *
+         * @throws std::invalid_argument If the dataset is empty
+         *
+         * @note Time complexity: O(n * d / threads), a single pass over the data
+         */
+        void fit(const Dataset& dataset);
+
+        /**
+         * @brief Updates the model with a new batch (streaming).
+         *
+         * @param dataset Batch of samples; new labels add new classes
+         *
+         * @throws std::invalid_argument If the number of features differs from earlier batches
+         */
+        void partial_fit(const Dataset& dataset);
+
+        /**
+         * @brief Updates the model with a new batch (streaming).
+         *
+         * @param X Samples [samples][features]
+         * @param labels Integer label of each sample
+         *
+         * @throws std::invalid_argument If sizes do not match or the number of features changes
+         */
+        void partial_fit(const std::vector<std::vector<double>>& X, const std::vector<int>& labels);
+
+        /**
+         * @brief Gets the per-class feature means.
+         *
+         * @return Means [classes][features]
+         */
+        std::vector<std::vector<double>> get_means() const;
+
+        /**
+         * @brief Gets the per-class feature variances, including the smoothing term.
+         *
+         * @return Variances [classes][features]
+         */
+        std::vector<std::vector<double>> get_variances() const;
+
+    private:
+        double var_smoothing_;          ///< Relative variance smoothing
+        double epsilon_ = 0.0;          ///< Absolute variance added to every variance
+        std::vector<double> means_;     ///< Per-class means [classes][features]
+        std::vector<double> m2_;        ///< Per-class sums of squared deviations [classes][features]
+
+        /**
+         * @brief Rebuilds the scoring weights from the sufficient statistics.
+         */
+        void update_weights();
+    };
+
+    /**
+     * @brief Multinomial Naive Bayes for count features (e.g. word counts, TF-IDF).
+     *
+     * Per-class feature totals are plain sums, accumulated per chunk and added up,
+     * so fit() reads the data once and partial_fit() is exact.
+     *
+     * Example usage:
+     * @code
+     * MultinomialNB model(0.5);
+     * model.fit(word_counts);
+     * vector<int> labels = model.predict(new_documents);
+     * @endcode
+     */
+    class MultinomialNB : public NaiveBayes {
+    public:
+        /**
+         * @brief Constructs a multinomial Naive Bayes classifier.
+         *
+         * @param alpha Additive (Laplace/Lidstone) smoothing (default: 1.0); values below
+         *              1e-10, including 0, are raised to 1e-10 so that a feature never seen
+         *              in a class gets a very low but finite log-probability instead of -inf
+         *
+         * @throws std::invalid_argument If alpha is negative or NaN
+         */
+        explicit MultinomialNB(double alpha = 1.0);
+
+        /**
+         * @brief Trains the model from scratch.
+         *
+         * @param dataset Training dataset containing non-negative features and integer labels
+         *
+         * @throws std::invalid_argument If the dataset is empty or has negative features
+         *
+         * @note Time complexity: O(n * d / threads), a single pass over the data
+         */
+        void fit(const Dataset& dataset);
+
+        /**
+         * @brief Updates the model with a new batch (streaming).
+         *
+         * @param dataset Batch of samples; new labels add new classes
+         *
+         * @throws std::invalid_argument If features are negative or their number changes
+         */
+        void partial_fit(const Dataset& dataset);
+
+        /**
+         * @brief Updates the model with a new batch (streaming).
+         *
+         * @param X Samples [samples][features], non-negative
+         * @param labels Integer label of each sample
+         *
+         * @throws std::invalid_argument If sizes do not match, features are negative or their number changes
+         */
+        void partial_fit(const std::vector<std::vector<double>>& X, const std::vector<int>& labels);
+
+        /**
+         * @brief Gets the per-class feature totals.
+         *
+         * @return Totals [classes][features]
+         */
+        std::vector<std::vector<double>> get_feature_counts() const;
+
+    private:
+        double alpha_;                      ///< Additive smoothing
+        std::vector<double> feature_counts_;    ///< Per-class feature totals [classes][features]
+
+        /**
+         * @brief Rebuilds the scoring weights from the sufficient statistics.
+         */
+        void update_weights();
+    };
+}
+
+#endif //MLCPP_NAIVEBAYES_H
@@ -0,0 +1,224 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_RANDOMFOREST_H
+#define MLCPP_RANDOMFOREST_H
+#include <vector>
+#include "DecisionTree.h"
+
+namespace mlcpp {
+    /**
+     * @brief Random forest ensemble of histogram-based decision trees (shared engine).
+     *
+     * The features are binned once and that single BinnedDataset is shared read-only
+     * by every tree. Trees train in parallel; each bootstrap sample is an integer
+     * weight vector (how many times each row was drawn) instead of a copy of the
+     * rows, so memory grows with the number of threads, not with the number of trees.
+     * Each node considers a random subset of max_features features.
+     *
+     * Use RandomForestClassifier or RandomForestRegressor.
+     */
+    class RandomForest {
+    public:
+        /**
+         * @brief Gets the fitted trees.
+         *
+         * @return One flat tree per estimator
+         */
+        const std::vector<FlatTree>& get_trees() const { return trees_; }
+
+        /**
+         * @brief Gets the number of trees.
+         *
+         * @return The n_estimators value
+         */
+        int get_n_estimators() const { return n_estimators_; }
+
+    protected:
+        int n_estimators_;          ///< Number of trees
+        int max_depth_;             ///< Maximum depth of each tree
+        int max_features_;          ///< Features sampled per node, -1 for the default
+        int min_samples_leaf_;      ///< Minimum number of samples in each leaf
+        bool bootstrap_;            ///< Whether each tree sees a bootstrap sample
+        int max_bins_;              ///< Maximum number of bins per feature
+        int seed_;                  ///< Random seed
+        std::vector<FlatTree> trees_;   ///< Fitted trees
+
+        /**
+         * @brief Stores the common hyperparameters.
+         */
+        RandomForest(int n_estimators, int max_depth, int max_features, int min_samples_leaf,
+                     bool bootstrap, int max_bins, int seed);
+
+        /**
+         * @brief Trains all the trees in parallel on shared binned data.
+         *
+         * @param data Binned features, shared by all trees
+         * @param targets Class index or target value per sample
+         * @param n_classes Number of classes, 0 for regression
+         * @param default_max_features Features per node used when max_features is -1
+         */
+        void grow_forest(const BinnedDataset& data, const std::vector<double>& targets, int n_classes,
+                         int default_max_features);
+
+        /**
+         * @brief Averages the leaf outputs of all trees for a batch of samples.
+         *
+         * Rows are processed in blocks; each tree is applied to the whole block before
+         * moving to the next, so a tree stays in cache while it is used.
+         *
+         * @param X Samples [samples][features]
+         * @return Averaged outputs [samples * n_outputs]
+         */
+        std::vector<double> predict_outputs(const std::vector<std::vector<double>>& X) const;
+    };
+
+    /**
+     * @brief Random forest classifier (soft voting over class probabilities).
+     *
+     * Example usage:
+     * @code
+     * RandomForestClassifier forest(200);
+     * forest.fit(train_dataset);
+     * double accuracy = forest.score(test_dataset);
+     * @endcode
+     */
+    class RandomForestClassifier : public RandomForest {
+    public:
+        /**
+         * @brief Constructs a random forest classifier.
+         *
+         * @param n_estimators Number of trees (default: 100)
+         * @param max_depth Maximum depth of each tree (default: 16)
+         * @param max_features Features sampled per node, -1 for sqrt(features) (default: -1)
+         * @param min_samples_leaf Minimum number of samples in each leaf (default: 1)
+         * @param bootstrap Whether each tree sees a bootstrap sample (default: true)
+         * @param max_bins Maximum number of bins per feature, at most 256 (default: 256)
+         * @param seed Random seed for reproducibility (default: 41)
+         */
+        explicit RandomForestClassifier(int n_estimators = 100,
+                                        int max_depth = 16,
+                                        int max_features = -1,
+                                        int min_samples_leaf = 1,
+                                        bool bootstrap = true,
+                                        int max_bins = 256,
+                                        int seed = 41);
+
+        /**
+         * @brief Trains the forest on a dataset.
+         *
+         * @param dataset Training dataset containing features and integer labels
+         *
+         * @throws std::invalid_argument If the dataset is empty
+         *
+         * @note Time complexity: O(n_estimators * n * max_features * max_depth / threads)
+         */
+        void fit(const Dataset& dataset);
+
+        /**
+         * @brief Predicts the class label for a single sample.
+         *
+         * @param sample Feature vector
+         * @return Class with the highest average probability
+         */
+        int predict(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Predicts class labels for multiple samples.
+         *
+         * @param samples 2D vector where each row is a sample to classify
+         * @return Vector of predicted labels
+         *
+         * @note Rows are processed in parallel blocks, each block through all trees
+         */
+        std::vector<int> predict(const std::vector<std::vector<double>>& samples) const;
+
+        /**
+         * @brief Predicts the class probabilities for multiple samples.
+         *
+         * @param samples 2D vector where each row is a sample
+         * @return Probabilities [samples][classes], classes ordered as get_classes()
+         */
+        std::vector<std::vector<double>> predict_proba(const std::vector<std::vector<double>>& samples) const;
+
+        /**
+         * @brief Calculates the accuracy of the model on a test dataset.
+         *
+         * @param test_dataset Dataset containing test samples and their true labels
+         * @return Accuracy as a value between 0.0 and 1.0
+         */
+        double score(const Dataset& test_dataset) const;
+
+        /**
+         * @brief Gets the class labels seen during training.
+         *
+         * @return Sorted distinct labels
+         */
+        const std::vector<int>& get_classes() const { return classes_; }
+
+    private:
+        std::vector<int> classes_;      ///< Sorted distinct training labels
+    };
+
+    /**
+     * @brief Random forest regressor (average of the tree predictions).
+     *
+     * Example usage:
+     * @code
+     * RandomForestRegressor forest(200, 12);
+     * forest.fit(X_train, y_train);
+     * vector<double> predictions = forest.predict(X_test);
+     * @endcode
+     */
+    class RandomForestRegressor : public RandomForest {
+    public:
+        /**
+         * @brief Constructs a random forest regressor.
+         *
+         * @param n_estimators Number of trees (default: 100)
+         * @param max_depth Maximum depth of each tree (default: 16)
+         * @param max_features Features sampled per node, -1 for features / 3 (default: -1)
+         * @param min_samples_leaf Minimum number of samples in each leaf (default: 1)
+         * @param bootstrap Whether each tree sees a bootstrap sample (default: true)
+         * @param max_bins Maximum number of bins per feature, at most 256 (default: 256)
+         * @param seed Random seed for reproducibility (default: 41)
+         */
+        explicit RandomForestRegressor(int n_estimators = 100,
+                                       int max_depth = 16,
+                                       int max_features = -1,
+                                       int min_samples_leaf = 1,
+                                       bool bootstrap = true,
+                                       int max_bins = 256,
+                                       int seed = 41);
+
+        /**
+         * @brief Trains the forest.
+         *
+         * @param X_train Training features [samples][features]
+         * @param y_train Training target values [samples]
+         *
+         * @throws std::invalid_argument If X_train is empty or sizes do not match
+         */
+        void fit(const std::vector<std::vector<double>>& X_train,
+                 const std::vector<double>& y_train);
+
+        /**
+         * @brief Predicts the target value for a single sample.
+         *
+         * @param sample Feature vector
+         * @return Average prediction of the trees
+         */
+        double predict(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Predicts target values for multiple samples.
+         *
+         * @param X_test Test features [samples][features]
+         * @return Vector of predicted values
+         */
+        std::vector<double> predict(const std::vector<std::vector<double>>& X_test) const;
+    };
+}
+
+#endif //MLCPP_RANDOMFOREST_H
@@ -0,0 +1,152 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_ROBUSTREGRESSION_H
+#define MLCPP_ROBUSTREGRESSION_H
+#include <string>
+#include <vector>
+#include "LinearRegression.h"
+
+namespace mlcpp {
+    /**
+     * @brief M-estimator loss of RobustRegression, given as the IRLS weight w(u) = ψ(u) / u.
+     */
+    enum class RobustLoss {
+        Huber,      ///< w = 1 if |u| <= c, else c / |u| (convex, default c = 1.345)
+        Bisquare,   ///< Tukey: w = (1 - (u/c)²)² if |u| < c, else 0 (rejects gross outliers, default c = 4.685)
+        Cauchy      ///< w = 1 / (1 + (u/c)²) (default c = 2.385)
+    };
+
+    /**
+     * @brief Outlier-resistant linear regression (M-estimation) by iteratively reweighted least squares.
+     *
+     * Starts from the least-squares fit, then repeats:
+     * 1. residuals rᵢ and the robust scale s = MAD(r) / 0.6745;
+     * 2. weights wᵢ = w(rᵢ / s) from the loss, so large residuals count less;
+     * 3. a weighted least-squares refit with LinearRegression's sample weights.
+     *
+     * Every refit goes through the weighted solver path of LinearRegression: with the
+     * "normal" solver, XᵀWX and XᵀWy are accumulated in one fused parallel pass per
+     * iteration; with "cg" or "lsqr", the rows are copied once into a DenseMatrix and
+     * each refit only needs matrix-vector products. The default tuning constants give
+     * 95% efficiency on Gaussian noise.
+     *
+     * Example usage:
+     * @code
+     * RobustRegression model(RobustLoss::Huber);
+     * model.fit(X_train, y_train);
+     * vector<double> predictions = model.predict(X_test);
+     * const vector<double>& w = model.get_robust_weights();   // Low for outlying rows
+     * @endcode
+     */
+    class RobustRegression {
+    public:
+        /**
+         * @brief Constructs a robust regression model.
+         *
+         * @param loss M-estimator loss (default: Huber)
+         * @param tuning Tuning constant c in units of the robust scale, 0 for the loss default (default: 0)
+         * @param max_iter Maximum number of IRLS iterations (default: 50)
+         * @param tol Stop when no parameter moves more than tol * max(1, |θ|∞) (default: 1e-6)
+         * @param solver Weighted least-squares solver: "normal", "cg" or "lsqr" (default: "normal")
+         *
+         * @throws std::invalid_argument If tuning < 0, max_iter < 1, tol <= 0 or the solver is unknown
+         */
+        explicit RobustRegression(RobustLoss loss = RobustLoss::Huber,
+                                  double tuning = 0.0,
+                                  int max_iter = 50,
+                                  double tol = 1e-6,
+                                  const std::string& solver = "normal");
+
+        /**
+         * @brief Trains the model by IRLS.
+         *
+         * @param X Training features [samples][features]
+         * @param y Training target values [samples]
+         * @param sample_weight Non-negative weight of each sample, multiplied with the robust weights
+         *                      (default: empty, unit weights)
+         *
+         * @throws std::invalid_argument If X is empty, sizes do not match or a weight is negative
+         *
+         * @note Time complexity: O(iterations * n * d² / threads) with the "normal" solver
+         */
+        void fit(const std::vector<std::vector<double>>& X,
+                 const std::vector<double>& y,
+                 const std::vector<double>& sample_weight = {});
+
+        /**
+         * @brief Predicts the target value of one sample.
+         *
+         * @param sample Feature vector
+         * @return Predicted value
+         *
+         * @throws std::logic_error If the model is not fitted
+         */
+        double predict(const std::vector<double>& sample) const;
+
+        /**
+         * @brief Predicts the target values of multiple samples.
+         *
+         * @param X Samples [samples][features]
+         * @return Predicted values
+         *
+         * @throws std::logic_error If the model is not fitted
+         */
+        std::vector<double> predict(const std::vector<std::vector<double>>& X) const;
+
+        /**
+         * @brief Gets the coefficients.
+         *
+         * @return Weights [features]
+         */
+        const std::vector<double>& get_weights() const { return model_.get_weights(); }
+
+        /**
+         * @brief Gets the intercept.
+         *
+         * @return Bias value
+         */
+        double get_bias() const { return model_.get_bias(); }
+
+        /**
+         * @brief Gets the robust weight of every training row from the last iteration.
+         *
+         * @return w(rᵢ / s) in [0, 1] per row (without the sample weights)
+         */
+        const std::vector<double>& get_robust_weights() const { return robust_weights_; }
+
+        /**
+         * @brief Gets the robust scale of the residuals from the last iteration.
+         *
+         * @return MAD(r) / 0.6745
+         */
+        double get_scale() const { return scale_; }
+
+        /**
+         * @brief Gets the number of reweighting iterations run by fit().
+         *
+         * @return Iterations after the initial least-squares fit
+         */
+        int get_n_iter() const { return n_iter_; }
+
+    private:
+        RobustLoss loss_;                       ///< M-estimator loss
+        double tuning_;                         ///< Tuning constant c
+        int max_iter_;                          ///< Maximum IRLS iterations
+        double tol_;                            ///< Convergence tolerance on the parameters
+        std::string solver_;                    ///< Weighted least-squares method of LinearRegression
+        LinearRegression model_;                ///< Current weighted least-squares fit
+        std::vector<double> robust_weights_;    ///< Robust weight of each training row
+        double scale_ = 0.0;                    ///< Robust residual scale
+        int n_iter_ = 0;                        ///< IRLS iterations of the last fit
+        bool fitted_ = false;                   ///< Whether fit() has completed
+
+        /**
+         * @brief Computes the IRLS weight ψ(u) / u of a standardized residual.
+         */
+        double weight(double u) const;
+    };
+}
+
+#endif //MLCPP_ROBUSTREGRESSION_H
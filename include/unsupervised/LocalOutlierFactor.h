@@ -0,0 +1,158 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#ifndef MLCPP_LOCALOUTLIERFACTOR_H
+#define MLCPP_LOCALOUTLIERFACTOR_H
+#include <vector>
+#include "../core/Dataset.h"
+#include "../core/NeighborSearch.h"
+
+namespace mlcpp {
+    /**
+     * @brief Local Outlier Factor (LOF) and kNN-distance anomaly scoring.
+     *
+     * For a reference set and k neighbors:
+     *
+     *     k-distance(o)      = distance from o to its k-th nearest neighbor
+     *     reach-dist(p, o)   = max(k-distance(o), d(p, o))
+     *     lrd(p)             = 1 / mean over the k neighbors o of reach-dist(p, o)
+     *     LOF(p)             = mean over the k neighbors o of lrd(o) / lrd(p)
+     *
+     * LOF is about 1 inside clusters and grows for points that are sparser than their
+     * neighbors. The k-distance itself is the simpler kNN-distance outlier score.
+     *
+     * fit() runs one all-pairs neighbor search (NeighborSearch::kneighbors_graph), then
+     * derives the k-distance, lrd and LOF arrays from that graph in parallel passes,
+     * so both scores cost a single neighbor search per point. New points are scored
+     * against the fitted reference set with one batch search (novelty detection).
+     *
+     * Example usage:
+     * @code
+     * LocalOutlierFactor lof(20);
+     * vector<int> labels = lof.fit_predict(X);               // -1 outlier, 1 inlier
+     * const vector<double>& scores = lof.get_scores();       // LOF of every row of X
+     * vector<double> novelty = lof.score_samples(X_new);     // LOF of unseen rows
+     * @endcode
+     */
+    class LocalOutlierFactor {
+    public:
+        /**
+         * @brief Constructs a LOF detector.
+         *
+         * @param n_neighbors Number of neighbors k (default: 20)
+         * @param contamination Expected fraction of outliers, sets the decision threshold (default: 0.1)
+         * @param distance Distance metric function (default: euclidean_distance)
+         *
+         * @throws std::invalid_argument If n_neighbors < 1 or contamination is not in (0, 0.5]
+         */
+        explicit LocalOutlierFactor(int n_neighbors = 20,
+                                    double contamination = 0.1,
+                                    DistanceMetric distance = euclidean_distance);
+
+        /**
+         * @brief Fits the detector and scores every reference row.
+         *
+         * @param X Reference rows [samples][features]
+         *
+         * @throws std::invalid_argument If X has no more rows than n_neighbors
+         *
+         * @note Time complexity: O(n² * d / threads) for the neighbor graph, O(n * k) for the scores
+         */
+        void fit(const std::vector<std::vector<double>>& X);
+
+        /**
+         * @brief Fits the detector on the features of a dataset (labels are ignored).
+         *
+         * @param dataset Reference dataset
+         */
+        void fit(const Dataset& dataset);
+
+        /**
+         * @brief Fits the detector and labels the reference rows.
+         *
+         * @param X Reference rows [samples][features]
+         * @return 1 for inliers, -1 for outliers (LOF above get_threshold())
+         */
+        std::vector<int> fit_predict(const std::vector<std::vector<double>>& X);
+
+        /**
+         * @brief Computes the LOF of new rows with respect to the reference set.
+         *
+         * @param X Rows to score [samples][features]
+         * @return LOF of each row
+         *
+         * @throws std::logic_error If the detector is not fitted
+         */
+        std::vector<double> score_samples(const std::vector<std::vector<double>>& X) const;
+
+        /**
+         * @brief Computes the kNN-distance score (distance to the k-th reference neighbor) of new rows.
+         *
+         * @param X Rows to score [samples][features]
+         * @return k-distance of each row
+         *
+         * @throws std::logic_error If the detector is not fitted
+         */
+        std::vector<double> knn_scores(const std::vector<std::vector<double>>& X) const;
+
+        /**
+         * @brief Labels new rows.
+         *
+         * @param X Rows to label [samples][features]
+         * @return 1 for inliers, -1 for outliers (LOF above get_threshold())
+         *
+         * @throws std::logic_error If the detector is not fitted
+         */
+        std::vector<int> predict(const std::vector<std::vector<double>>& X) const;
+
+        /**
+         * @brief Gets the LOF of every reference row.
+         *
+         * @return Scores [samples]
+         */
+        const std::vector<double>& get_scores() const { return scores_; }
+
+        /**
+         * @brief Gets the k-distance of every reference row (kNN-distance outlier score).
+         *
+         * @return k-distances [samples]
+         */
+        const std::vector<double>& get_k_distances() const { return k_distances_; }
+
+        /**
+         * @brief Gets the local reachability density of every reference row.
+         *
+         * @return lrd [samples]
+         */
+        const std::vector<double>& get_densities() const { return densities_; }
+
+        /**
+         * @brief Gets the LOF above which a row is labelled an outlier.
+         *
+         * @return The (1 - contamination) quantile of the reference scores
+         */
+        double get_threshold() const { return threshold_; }
+
+    private:
+        int k_;                             ///< Number of neighbors
+        double contamination_;              ///< Expected fraction of outliers
+        NeighborSearch search_;             ///< Neighbor engine over the reference rows
+        std::vector<double> k_distances_;   ///< k-distance of each reference row
+        std::vector<double> densities_;     ///< Local reachability density of each reference row
+        std::vector<double> scores_;        ///< LOF of each reference row
+        double threshold_ = 0.0;            ///< Outlier threshold on the LOF
+
+        /**
+         * @brief Computes the lrd of a point from its neighbor list.
+         */
+        double density(const std::vector<Neighbor>& neighbors) const;
+
+        /**
+         * @brief Computes the LOF of a point from its neighbor list and its lrd.
+         */
+        double outlier_factor(const std::vector<Neighbor>& neighbors, double density) const;
+    };
+}
+
+#endif //MLCPP_LOCALOUTLIERFACTOR_H
@@ -1,8 +1,16 @@
 #include <iostream>
 
 #include "include/core/Dataset.h"
+#include "include/core/Float32Matrix.h"
+#include "include/core/LinearAlgebra.h"
+#include "include/supervised/CompiledEnsemble.h"
+#include "include/supervised/GradientBoosting.h"
 #include "include/supervised/KNN.h"
+#include "include/supervised/LinearRegression.h"
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <random>
 
 using namespace std;
 
@@ -53,6 +61,98 @@ int main() {
         cout << "Accuracy: " << (accuracy * 100) << "%" << endl;
 
         cout << "=== Test Complete ===" << endl;
+
+        cout << "=== Compiled Ensemble Benchmark ===" << endl;
+
+        // 1. Synthetic regression data
+        mt19937 generator(7);
+        normal_distribution<double> noise(0.0, 1.0);
+        vector<vector<double>> X(20000, vector<double>(20));
+        vector<double> y(X.size());
+        for (size_t i = 0; i < X.size(); i++) {
+            for (double& value : X[i]) {
+                value = noise(generator);
+            }
+            y[i] = sin(X[i][0]) + X[i][1] * X[i][2] + 0.1 * noise(generator);
+        }
+
+        // 2. Train a 500-tree model and compile it
+        cout << "Training 500 boosting rounds..." << endl;
+        mlcpp::BoostingOptions options;
+        options.n_estimators = 500;
+        mlcpp::GradientBoostingRegressor boosted(options);
+        boosted.fit(X, y);
+        mlcpp::CompiledEnsemble engine = mlcpp::CompiledEnsemble::compile(boosted);
+
+        // 3. Time the per-tree traversal against the compiled engine
+        auto start = chrono::steady_clock::now();
+        vector<double> tree_predictions = boosted.predict(X);
+        auto middle = chrono::steady_clock::now();
+        vector<double> compiled_predictions = engine.predict(X);
+        auto end = chrono::steady_clock::now();
+        double tree_us = chrono::duration<double, micro>(middle - start).count() / X.size();
+        double compiled_us = chrono::duration<double, micro>(end - middle).count() / X.size();
+        cout << "Per-tree traversal: " << tree_us << " us/row" << endl;
+        cout << "Compiled ensemble: " << compiled_us << " us/row" << endl;
+
+        // 4. Both paths must agree
+        for (size_t i = 0; i < X.size(); i++) {
+            if (abs(tree_predictions[i] - compiled_predictions[i]) > 1e-9) {
+                cerr << "Error: compiled prediction differs at row " << i << endl;
+                return 1;
+            }
+        }
+
+        cout << "=== Benchmark Complete ===" << endl;
+
+        cout << "=== Float32 Storage Check ===" << endl;
+
+        // 1. Well-conditioned linear data with a little noise
+        vector<vector<double>> X_linear(50000, vector<double>(16));
+        vector<double> y_linear(X_linear.size());
+        uniform_real_distribution<double> uniform(-1.0, 1.0);
+        for (size_t i = 0; i < X_linear.size(); i++) {
+            y_linear[i] = 0.5;
+            for (size_t j = 0; j < X_linear[i].size(); j++) {
+                X_linear[i][j] = uniform(generator);
+                y_linear[i] += (0.25 * j - 2.0) * X_linear[i][j];
+            }
+            y_linear[i] += 0.01 * noise(generator);
+        }
+
+        // 2. Condition number of Z = [1, X] from the eigenvalues of ZᵀZ
+        mlcpp::GramBlock system = mlcpp::LinearAlgebra::augmented_gram(X_linear, y_linear)[0];
+        vector<double> eigenvalues = mlcpp::LinearAlgebra::symmetric_eigen(system.gram).first;
+        double condition = sqrt(eigenvalues.front() / eigenvalues.back());
+        cout << "cond([1, X]) = " << condition << endl;
+
+        // 3. Fit on doubles and on floats
+        mlcpp::Float32Matrix X_float = mlcpp::Float32Matrix::from_rows(X_linear);
+        mlcpp::LinearRegression double_model;
+        mlcpp::LinearRegression float_model;
+        start = chrono::steady_clock::now();
+        double_model.fit(X_linear, y_linear);
+        middle = chrono::steady_clock::now();
+        float_model.fit(X_float, y_linear);
+        end = chrono::steady_clock::now();
+        cout << "Double fit: " << chrono::duration<double, milli>(middle - start).count() << " ms" << endl;
+        cout << "Float32 fit: " << chrono::duration<double, milli>(end - middle).count() << " ms" << endl;
+
+        // 4. The parameters must agree within the documented cond(X) * 6e-8 relative error
+        double difference = abs(float_model.get_bias() - double_model.get_bias());
+        double magnitude = abs(double_model.get_bias());
+        for (size_t j = 0; j < double_model.get_weights().size(); j++) {
+            difference = max(difference, abs(float_model.get_weights()[j] - double_model.get_weights()[j]));
+            magnitude = max(magnitude, abs(double_model.get_weights()[j]));
+        }
+        double relative = difference / magnitude;
+        cout << "Relative difference: " << relative << " (tolerance " << condition * 6e-8 << ")" << endl;
+        if (relative > condition * 6e-8) {
+            cerr << "Error: float32 fit is outside the documented tolerance" << endl;
+            return 1;
+        }
+
+        cout << "=== Check Complete ===" << endl;
         return 0;
 
     } catch (const exception& e) {
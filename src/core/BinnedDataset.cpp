@@ -0,0 +1,66 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/core/BinnedDataset.h"
+#include "../../include/core/Parallel.h"
+
+#include <algorithm>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    // Rows sampled per feature to estimate the quantile edges
+    static constexpr size_t MAX_EDGE_SAMPLE = 100000;
+
+    BinnedDataset::BinnedDataset(const vector<vector<double> > &features, int max_bins) {
+        if (max_bins < 2 || max_bins > 256) {
+            throw invalid_argument("max_bins must be between 2 and 256.");
+        }
+        this->rows_ = features.size();
+        size_t d = features.empty() ? 0 : features[0].size();
+        this->edges_.assign(d, {});
+        this->bins_.assign(d * this->rows_, 0);
+
+        size_t stride = max<size_t>(1, (this->rows_ + MAX_EDGE_SAMPLE - 1) / MAX_EDGE_SAMPLE);
+        parallel_for(d, [&](size_t begin, size_t end, size_t) {
+            vector<double> values;
+            for (size_t f = begin; f < end; f++) {
+                // 1. Distinct values of an evenly spaced sample
+                values.clear();
+                for (size_t r = 0; r < this->rows_; r += stride) {
+                    values.push_back(features[r][f]);
+                }
+                sort(values.begin(), values.end());
+                values.erase(unique(values.begin(), values.end()), values.end());
+
+                // 2. Edges: midpoints if few distinct values, quantiles otherwise
+                vector<double> &edges = this->edges_[f];
+                if (values.size() <= static_cast<size_t>(max_bins)) {
+                    for (size_t i = 0; i + 1 < values.size(); i++) {
+                        edges.push_back(values[i] + (values[i + 1] - values[i]) / 2.0);
+                    }
+                } else {
+                    for (int b = 1; b < max_bins; b++) {
+                        size_t idx = values.size() * b / max_bins;
+                        double edge = values[idx - 1] + (values[idx] - values[idx - 1]) / 2.0;
+                        if (edges.empty() || edge > edges.back()) {
+                            edges.push_back(edge);
+                        }
+                    }
+                }
+
+                // 3. Bin every sample of the column
+                uint8_t *column = this->bins_.data() + f * this->rows_;
+                for (size_t r = 0; r < this->rows_; r++) {
+                    column[r] = bin_value(f, features[r][f]);
+                }
+            }
+        }, 1);
+    }
+
+    uint8_t BinnedDataset::bin_value(size_t feature, double value) const {
+        const vector<double> &edges = this->edges_[feature];
+        return static_cast<uint8_t>(lower_bound(edges.begin(), edges.end(), value) - edges.begin());
+    }
+}
@@ -0,0 +1,29 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/core/BitMatrix.h"
+using namespace std;
+
+namespace mlcpp {
+    BitMatrix::BitMatrix(size_t rows, size_t n_bits) {
+        this->rows_ = rows;
+        this->n_bits_ = n_bits;
+        this->words_per_row_ = (n_bits + 63) / 64;
+        this->bits_.assign(rows * this->words_per_row_, 0);
+    }
+
+    BitMatrix BitMatrix::from_features(const vector<vector<double> > &features, double threshold) {
+        size_t n_bits = features.empty() ? 0 : features[0].size();
+        BitMatrix matrix(features.size(), n_bits);
+        for (size_t r = 0; r < features.size(); r++) {
+            uint64_t *words = matrix.row(r);
+            for (size_t b = 0; b < n_bits; b++) {
+                if (features[r][b] > threshold) {
+                    words[b / 64] |= uint64_t{1} << (b % 64);
+                }
+            }
+        }
+        return matrix;
+    }
+}
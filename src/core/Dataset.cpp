@@ -173,13 +173,15 @@ namespace mlcpp {
         }
     }
 
-    void Dataset::standardize() {
+    pair<vector<double>, vector<double> > Dataset::standardize() {
         if (features_.empty()) {
-            return; // There is data
+            return {}; // There is data
         }
 
         size_t num_samples = features_.size();
         size_t num_features = features_[0].size();
+        vector<double> means(num_features, 0.0);
+        vector<double> std_devs(num_features, 1.0);
 
         // Normalize each feature (column) independently
         for (size_t col = 0; col < num_features; ++col) {
@@ -205,8 +207,11 @@ namespace mlcpp {
                 for (size_t row = 0; row < num_samples; ++row) {
                     features_[row][col] = (features_[row][col] - mean) / std_dev;
                 }
+                means[col] = mean;
+                std_devs[col] = std_dev;
             }
             // If range == 0, let the values as they (they are all the same)
         }
+        return {means, std_devs};
     }
 }
@@ -0,0 +1,100 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/core/Float32Matrix.h"
+#include "../../include/core/Parallel.h"
+
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    Float32Matrix::Float32Matrix(size_t rows, size_t n_features) {
+        this->rows_ = rows;
+        this->n_features_ = n_features;
+        this->values_.assign(rows * n_features, 0.0f);
+    }
+
+    Float32Matrix Float32Matrix::from_rows(const vector<vector<double> > &features) {
+        size_t n_features = features.empty() ? 0 : features[0].size();
+        for (const vector<double> &row: features) {
+            if (row.size() != n_features) {
+                throw invalid_argument("All samples must have the same number of features.");
+            }
+        }
+        Float32Matrix matrix(features.size(), n_features);
+        parallel_for(features.size(), [&](size_t begin, size_t end, size_t) {
+            for (size_t r = begin; r < end; r++) {
+                float *values = matrix.row(r);
+                for (size_t j = 0; j < n_features; j++) {
+                    values[j] = static_cast<float>(features[r][j]);
+                }
+            }
+        });
+        return matrix;
+    }
+
+    double Float32Matrix::row_squared_norm(size_t row) const {
+        const float *x = this->row(row);
+        double sum = 0.0;
+        for (size_t j = 0; j < this->n_features_; j++) {
+            sum += static_cast<double>(x[j]) * x[j];
+        }
+        return sum;
+    }
+
+    vector<double> Float32Matrix::multiply(const vector<double> &w) const {
+        if (w.size() != this->n_features_) {
+            throw invalid_argument("Vector size must match the number of features.");
+        }
+        vector<double> result(this->rows_);
+        parallel_for(this->rows_, [&](size_t begin, size_t end, size_t) {
+            for (size_t r = begin; r < end; r++) {
+                result[r] = row_dot(r, w.data());
+            }
+        });
+        return result;
+    }
+
+    vector<double> Float32Matrix::multiply_transpose(const vector<double> &y) const {
+        if (y.size() != this->rows_) {
+            throw invalid_argument("Vector size must match the number of samples.");
+        }
+        vector<vector<double> > partial(num_threads());
+        size_t chunks = parallel_for(this->rows_, [&](size_t begin, size_t end, size_t chunk) {
+            partial[chunk].assign(this->n_features_, 0.0);
+            for (size_t r = begin; r < end; r++) {
+                row_axpy(r, y[r], partial[chunk].data());
+            }
+        });
+        vector<double> result(this->n_features_, 0.0);
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            for (size_t j = 0; j < this->n_features_; j++) {
+                result[j] += partial[chunk][j];
+            }
+        }
+        return result;
+    }
+
+    vector<double> Float32Matrix::column_squared_norms(const vector<double> &weights) const {
+        vector<vector<double> > partial(num_threads());
+        size_t chunks = parallel_for(this->rows_, [&](size_t begin, size_t end, size_t chunk) {
+            partial[chunk].assign(this->n_features_, 0.0);
+            for (size_t r = begin; r < end; r++) {
+                const float *values = row(r);
+                double weight = weights.empty() ? 1.0 : weights[r];
+                for (size_t j = 0; j < this->n_features_; j++) {
+                    double value = values[j];
+                    partial[chunk][j] += weight * value * value;
+                }
+            }
+        });
+        vector<double> result(this->n_features_, 0.0);
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            for (size_t j = 0; j < this->n_features_; j++) {
+                result[j] += partial[chunk][j];
+            }
+        }
+        return result;
+    }
+}
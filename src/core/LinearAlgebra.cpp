@@ -0,0 +1,440 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/core/LinearAlgebra.h"
+#include "../../include/core/Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    // Number of inner-dimension rows of B kept hot in cache per block
+    static constexpr size_t BLOCK_SIZE = 64;
+    // Minimum right-hand-side columns per task in the multi-column triangular solves
+    static constexpr size_t SOLVE_COLUMNS = 64;
+
+    vector<vector<double> > LinearAlgebra::matmul(const vector<vector<double> > &A,
+                                                  const vector<vector<double> > &B) {
+        size_t n = A.size();
+        size_t m = B.size();
+        size_t p = B.empty() ? 0 : B[0].size();
+        if (n > 0 && A[0].size() != m) {
+            throw invalid_argument("matmul: inner dimensions do not match.");
+        }
+
+        vector<vector<double> > C(n, vector<double>(p, 0.0));
+        parallel_for(n, [&](size_t begin, size_t end, size_t) {
+            // Block over the inner dimension so the rows of B stay in cache
+            for (size_t kk = 0; kk < m; kk += BLOCK_SIZE) {
+                size_t k_end = min(m, kk + BLOCK_SIZE);
+                for (size_t i = begin; i < end; i++) {
+                    double *c = C[i].data();
+                    const double *a = A[i].data();
+                    for (size_t k = kk; k < k_end; k++) {
+                        double a_ik = a[k];
+                        if (a_ik == 0.0) {
+                            continue;
+                        }
+                        const double *b = B[k].data();
+                        for (size_t j = 0; j < p; j++) {
+                            c[j] += a_ik * b[j];
+                        }
+                    }
+                }
+            }
+        }, BLOCK_SIZE);
+        return C;
+    }
+
+    vector<vector<double> > LinearAlgebra::matmul_transpose_a(const vector<vector<double> > &A,
+                                                              const vector<vector<double> > &B) {
+        if (A.size() != B.size()) {
+            throw invalid_argument("matmul_transpose_a: row counts do not match.");
+        }
+        size_t n = A.size();
+        size_t m = n == 0 ? 0 : A[0].size();
+        size_t p = n == 0 ? 0 : B[0].size();
+
+        // One partial result per thread, merged at the end
+        vector<vector<double> > partials(num_threads(), vector<double>(m * p, 0.0));
+        parallel_for(n, [&](size_t begin, size_t end, size_t chunk) {
+            double *acc = partials[chunk].data();
+            for (size_t i = begin; i < end; i++) {
+                const double *a = A[i].data();
+                const double *b = B[i].data();
+                for (size_t r = 0; r < m; r++) {
+                    double a_ir = a[r];
+                    if (a_ir == 0.0) {
+                        continue;
+                    }
+                    double *row = acc + r * p;
+                    for (size_t j = 0; j < p; j++) {
+                        row[j] += a_ir * b[j];
+                    }
+                }
+            }
+        });
+
+        vector<vector<double> > C(m, vector<double>(p, 0.0));
+        for (const auto &partial: partials) {
+            for (size_t r = 0; r < m; r++) {
+                for (size_t j = 0; j < p; j++) {
+                    C[r][j] += partial[r * p + j];
+                }
+            }
+        }
+        return C;
+    }
+
+    void LinearAlgebra::orthonormalize_columns(vector<vector<double> > &Y) {
+        size_t n = Y.size();
+        if (n == 0) {
+            return;
+        }
+        size_t l = Y[0].size();
+        size_t threads = num_threads();
+
+        for (size_t j = 0; j < l; j++) {
+            // 1. Remove the components along the previous columns (twice for stability)
+            for (int pass = 0; pass < 2 && j > 0; pass++) {
+                vector<vector<double> > partials(threads, vector<double>(j, 0.0));
+                parallel_for(n, [&](size_t begin, size_t end, size_t chunk) {
+                    double *acc = partials[chunk].data();
+                    for (size_t i = begin; i < end; i++) {
+                        double y_ij = Y[i][j];
+                        for (size_t c = 0; c < j; c++) {
+                            acc[c] += Y[i][c] * y_ij;
+                        }
+                    }
+                });
+                vector<double> r(j, 0.0);
+                for (const auto &partial: partials) {
+                    for (size_t c = 0; c < j; c++) {
+                        r[c] += partial[c];
+                    }
+                }
+                parallel_for(n, [&](size_t begin, size_t end, size_t) {
+                    for (size_t i = begin; i < end; i++) {
+                        double proj = 0.0;
+                        for (size_t c = 0; c < j; c++) {
+                            proj += Y[i][c] * r[c];
+                        }
+                        Y[i][j] -= proj;
+                    }
+                });
+            }
+
+            // 2. Normalize the column, or zero it if it collapsed
+            vector<double> partial_norms(threads, 0.0);
+            parallel_for(n, [&](size_t begin, size_t end, size_t chunk) {
+                double sum = 0.0;
+                for (size_t i = begin; i < end; i++) {
+                    sum += Y[i][j] * Y[i][j];
+                }
+                partial_norms[chunk] = sum;
+            });
+            double norm = sqrt(accumulate(partial_norms.begin(), partial_norms.end(), 0.0));
+            double scale = norm > 1e-12 ? 1.0 / norm : 0.0;
+            parallel_for(n, [&](size_t begin, size_t end, size_t) {
+                for (size_t i = begin; i < end; i++) {
+                    Y[i][j] *= scale;
+                }
+            });
+        }
+    }
+
+    pair<vector<double>, vector<vector<double> > > LinearAlgebra::symmetric_eigen(vector<vector<double> > S) {
+        size_t l = S.size();
+        vector<vector<double> > V(l, vector<double>(l, 0.0));
+        for (size_t i = 0; i < l; i++) {
+            V[i][i] = 1.0;
+        }
+
+        // Cyclic Jacobi sweeps until the off-diagonal mass vanishes
+        for (int sweep = 0; sweep < 100; sweep++) {
+            double off = 0.0;
+            double diag = 0.0;
+            for (size_t p = 0; p < l; p++) {
+                diag += S[p][p] * S[p][p];
+                for (size_t q = p + 1; q < l; q++) {
+                    off += S[p][q] * S[p][q];
+                }
+            }
+            if (off <= 1e-30 * max(diag, 1e-300)) {
+                break;
+            }
+
+            for (size_t p = 0; p < l; p++) {
+                for (size_t q = p + 1; q < l; q++) {
+                    if (S[p][q] == 0.0) {
+                        continue;
+                    }
+                    double theta = (S[q][q] - S[p][p]) / (2.0 * S[p][q]);
+                    double t = (theta >= 0 ? 1.0 : -1.0) / (abs(theta) + sqrt(theta * theta + 1.0));
+                    double c = 1.0 / sqrt(t * t + 1.0);
+                    double s = t * c;
+
+                    for (size_t k = 0; k < l; k++) {
+                        double s_kp = S[k][p];
+                        double s_kq = S[k][q];
+                        S[k][p] = c * s_kp - s * s_kq;
+                        S[k][q] = s * s_kp + c * s_kq;
+                    }
+                    for (size_t k = 0; k < l; k++) {
+                        double s_pk = S[p][k];
+                        double s_qk = S[q][k];
+                        S[p][k] = c * s_pk - s * s_qk;
+                        S[q][k] = s * s_pk + c * s_qk;
+                    }
+                    for (size_t k = 0; k < l; k++) {
+                        double v_kp = V[k][p];
+                        double v_kq = V[k][q];
+                        V[k][p] = c * v_kp - s * v_kq;
+                        V[k][q] = s * v_kp + c * v_kq;
+                    }
+                }
+            }
+        }
+
+        // Sort by decreasing eigenvalue; eigenvectors are the columns of V
+        vector<size_t> order(l);
+        iota(order.begin(), order.end(), 0);
+        sort(order.begin(), order.end(), [&](size_t a, size_t b) { return S[a][a] > S[b][b]; });
+
+        vector<double> values(l);
+        vector<vector<double> > vectors(l, vector<double>(l));
+        for (size_t i = 0; i < l; i++) {
+            values[i] = S[order[i]][order[i]];
+            for (size_t k = 0; k < l; k++) {
+                vectors[i][k] = V[k][order[i]];
+            }
+        }
+        return {values, vectors};
+    }
+
+    vector<vector<double> > LinearAlgebra::cholesky(const vector<vector<double> > &A) {
+        size_t d = A.size();
+        vector<vector<double> > L(d, vector<double>(d, 0.0));
+        for (size_t j = 0; j < d; j++) {
+            if (A[j].size() != d) {
+                throw invalid_argument("cholesky: matrix must be square.");
+            }
+            double diagonal = A[j][j];
+            for (size_t k = 0; k < j; k++) {
+                diagonal -= L[j][k] * L[j][k];
+            }
+            if (!(diagonal > 0.0)) {
+                throw invalid_argument("cholesky: matrix is not positive definite.");
+            }
+            L[j][j] = sqrt(diagonal);
+
+            // The column below the diagonal is independent per row
+            double inverse = 1.0 / L[j][j];
+            for (size_t i = j + 1; i < d; i++) {
+                double value = A[i][j];
+                const double *l_i = L[i].data();
+                const double *l_j = L[j].data();
+                for (size_t k = 0; k < j; k++) {
+                    value -= l_i[k] * l_j[k];
+                }
+                L[i][j] = value * inverse;
+            }
+        }
+        return L;
+    }
+
+    vector<vector<double> > LinearAlgebra::cholesky_jittered(vector<vector<double> > A, size_t first) {
+        size_t d = A.size();
+        double trace = 0.0;
+        for (size_t j = 0; j < d; j++) {
+            trace += A[j][j];
+        }
+        double ridge = 1e-12 * max(d == 0 ? 0.0 : trace / d, 1.0);
+        for (int attempt = 0;; attempt++) {
+            try {
+                return cholesky(A);
+            } catch (const invalid_argument &) {
+                if (attempt == 4) {
+                    throw;
+                }
+                for (size_t j = first; j < d; j++) {
+                    A[j][j] += ridge;
+                }
+                ridge *= 1000.0;
+            }
+        }
+    }
+
+    // Per-group normal equations of rows z = [1, x]; copy_row(i, out) writes the d features of row i
+    template<typename CopyRow>
+    static vector<GramBlock> gram_pass(size_t n, size_t d, const CopyRow &copy_row, const vector<double> &y,
+                                       const vector<int> &groups, size_t n_groups, const vector<double> &weights) {
+        size_t p = d + 1;
+
+        // Per thread and group: lower triangle of ZᵀZ, then Zᵀy, in one flat buffer
+        size_t stride = p * p + p;
+        vector<vector<double> > partials(num_threads());
+        size_t chunks = parallel_for(n, [&](size_t begin, size_t end, size_t chunk) {
+            vector<double> &acc = partials[chunk];
+            acc.assign(n_groups * stride, 0.0);
+            vector<double> z(p, 1.0);
+            for (size_t i = begin; i < end; i++) {
+                copy_row(i, z.data() + 1);
+                double *block = acc.data() + (groups.empty() ? 0 : groups[i]) * stride;
+                double *rhs = block + p * p;
+                double target = y.empty() ? 0.0 : y[i];
+                double weight = weights.empty() ? 1.0 : weights[i];
+                for (size_t a = 0; a < p; a++) {
+                    double z_a = weight * z[a];
+                    double *row = block + a * p;
+                    for (size_t b = 0; b <= a; b++) {
+                        row[b] += z_a * z[b];
+                    }
+                    rhs[a] += z_a * target;
+                }
+            }
+        });
+
+        vector<GramBlock> blocks(n_groups, GramBlock{vector<vector<double> >(p, vector<double>(p, 0.0)),
+                                                     vector<double>(p, 0.0)});
+        for (size_t g = 0; g < n_groups; g++) {
+            GramBlock &block = blocks[g];
+            for (size_t chunk = 0; chunk < chunks; chunk++) {
+                const double *acc = partials[chunk].data() + g * stride;
+                for (size_t a = 0; a < p; a++) {
+                    for (size_t b = 0; b <= a; b++) {
+                        block.gram[a][b] += acc[a * p + b];
+                    }
+                    block.rhs[a] += acc[p * p + a];
+                }
+            }
+            for (size_t a = 0; a < p; a++) {
+                for (size_t b = 0; b < a; b++) {
+                    block.gram[b][a] = block.gram[a][b];
+                }
+            }
+        }
+        return blocks;
+    }
+
+    vector<GramBlock> LinearAlgebra::augmented_gram(const vector<vector<double> > &X, const vector<double> &y,
+                                                    const vector<int> &groups, size_t n_groups,
+                                                    const vector<double> &weights) {
+        if ((!y.empty() && X.size() != y.size()) || (!groups.empty() && groups.size() != X.size()) ||
+            (!weights.empty() && weights.size() != X.size())) {
+            throw invalid_argument("augmented_gram: X, y, groups and weights must have the same size.");
+        }
+        size_t d = X.empty() ? 0 : X[0].size();
+        for (size_t i = 0; i < X.size(); i++) {
+            if (X[i].size() != d) {
+                throw invalid_argument("augmented_gram: all rows must have the same number of features.");
+            }
+            if (!groups.empty() && (groups[i] < 0 || static_cast<size_t>(groups[i]) >= n_groups)) {
+                throw invalid_argument("augmented_gram: group out of range.");
+            }
+        }
+        return gram_pass(X.size(), d, [&](size_t i, double *out) {
+            copy(X[i].begin(), X[i].end(), out);
+        }, y, groups, n_groups, weights);
+    }
+
+    GramBlock LinearAlgebra::augmented_gram(const Float32Matrix &X, const vector<double> &y,
+                                            const vector<double> &weights) {
+        if ((!y.empty() && X.size() != y.size()) || (!weights.empty() && weights.size() != X.size())) {
+            throw invalid_argument("augmented_gram: X, y and weights must have the same size.");
+        }
+        size_t d = X.num_features();
+        return gram_pass(X.size(), d, [&](size_t i, double *out) {
+            const float *row = X.row(i);
+            for (size_t j = 0; j < d; j++) {
+                out[j] = row[j];
+            }
+        }, y, {}, 1, weights)[0];
+    }
+
+    vector<double> LinearAlgebra::solve_lower(const vector<vector<double> > &L, const vector<double> &b) {
+        size_t d = L.size();
+        vector<double> x(d);
+        for (size_t i = 0; i < d; i++) {
+            double value = b[i];
+            for (size_t k = 0; k < i; k++) {
+                value -= L[i][k] * x[k];
+            }
+            x[i] = value / L[i][i];
+        }
+        return x;
+    }
+
+    vector<double> LinearAlgebra::solve_lower_transposed(const vector<vector<double> > &L,
+                                                         const vector<double> &b) {
+        size_t d = L.size();
+        vector<double> x(b.begin(), b.end());
+        // Column-oriented back substitution, so L is still walked row by row
+        for (size_t i = d; i-- > 0;) {
+            x[i] /= L[i][i];
+            for (size_t k = 0; k < i; k++) {
+                x[k] -= L[i][k] * x[i];
+            }
+        }
+        return x;
+    }
+
+    vector<double> LinearAlgebra::cholesky_solve(const vector<vector<double> > &L, const vector<double> &b) {
+        return solve_lower_transposed(L, solve_lower(L, b));
+    }
+
+    vector<vector<double> > LinearAlgebra::cholesky_solve(const vector<vector<double> > &L,
+                                                          const vector<vector<double> > &B) {
+        size_t d = L.size();
+        size_t t = B.empty() ? 0 : B[0].size();
+        if (B.size() != d) {
+            throw invalid_argument("cholesky_solve: B must have as many rows as L.");
+        }
+        for (const vector<double> &row: B) {
+            if (row.size() != t) {
+                throw invalid_argument("cholesky_solve: all rows of B must have the same length.");
+            }
+        }
+
+        // Each chunk owns a block of columns and runs both substitutions on it
+        vector<vector<double> > X = B;
+        parallel_for(t, [&](size_t begin, size_t end, size_t) {
+            // 1. Forward substitution L * Y = B, one axpy over the block per entry of L
+            for (size_t i = 0; i < d; i++) {
+                double *x_i = X[i].data();
+                for (size_t k = 0; k < i; k++) {
+                    double l_ik = L[i][k];
+                    const double *x_k = X[k].data();
+                    for (size_t c = begin; c < end; c++) {
+                        x_i[c] -= l_ik * x_k[c];
+                    }
+                }
+                double inverse = 1.0 / L[i][i];
+                for (size_t c = begin; c < end; c++) {
+                    x_i[c] *= inverse;
+                }
+            }
+
+            // 2. Back substitution L^T * X = Y, column-oriented so L is walked row by row
+            for (size_t i = d; i-- > 0;) {
+                double *x_i = X[i].data();
+                double inverse = 1.0 / L[i][i];
+                for (size_t c = begin; c < end; c++) {
+                    x_i[c] *= inverse;
+                }
+                for (size_t k = 0; k < i; k++) {
+                    double l_ik = L[i][k];
+                    double *x_k = X[k].data();
+                    for (size_t c = begin; c < end; c++) {
+                        x_k[c] -= l_ik * x_i[c];
+                    }
+                }
+            }
+        }, SOLVE_COLUMNS);
+        return X;
+    }
+}
@@ -4,93 +4,209 @@
 
 #include "../../include/core/Metrics.h"
 
-#include <complex>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 
 namespace mlcpp {
-    static double mean_squared_error(const std::vector<double> &y_true,
-                                     const std::vector<double> &y_pred) {
-        size_t n = y_true.size();
-        double sum = 0.0;
-        for (size_t i = 0; i < n; i++) {
-            double diff = y_true[i] - y_pred[i];
-            sum += diff * diff;
+    // Probabilities are clipped to this before taking the log
+    static constexpr double MIN_PROBABILITY = 1e-15;
+
+    // ==================== ACCUMULATORS ====================
+
+    void RegressionAccumulator::add(double y_true, double y_pred) {
+        double diff = y_true - y_pred;
+        this->count++;
+        this->sum_squared_error += diff * diff;
+        this->sum_absolute_error += std::abs(diff);
+        double delta = y_true - this->mean_true;
+        this->mean_true += delta / static_cast<double>(this->count);
+        this->m2_true += delta * (y_true - this->mean_true);
+    }
+
+    void RegressionAccumulator::merge(const RegressionAccumulator &other) {
+        if (other.count == 0) {
+            return;
         }
-        return sum / n;
+        size_t total = this->count + other.count;
+        double delta = other.mean_true - this->mean_true;
+        this->m2_true += other.m2_true + delta * delta * static_cast<double>(this->count) *
+                static_cast<double>(other.count) / static_cast<double>(total);
+        this->mean_true += delta * static_cast<double>(other.count) / static_cast<double>(total);
+        this->sum_squared_error += other.sum_squared_error;
+        this->sum_absolute_error += other.sum_absolute_error;
+        this->count = total;
     }
 
-    static double root_mean_squared_error(const std::vector<double> &y_true,
-                                          const std::vector<double> &y_pred) {
-        return std::sqrt(mean_squared_error(y_true, y_pred));
+    double RegressionAccumulator::mse() const {
+        return this->count == 0 ? 0.0 : this->sum_squared_error / static_cast<double>(this->count);
     }
 
-    static double mean_absolute_error(const std::vector<double> &y_true,
-                                      const std::vector<double> &y_pred) {
-        size_t n = y_true.size();
-        double sum = 0.0;
-        for (size_t i = 0; i < n; i++) {
-            double diff = y_true[i] - y_pred[i];
-            sum += std::abs(diff);
+    double RegressionAccumulator::rmse() const {
+        return std::sqrt(mse());
+    }
+
+    double RegressionAccumulator::mae() const {
+        return this->count == 0 ? 0.0 : this->sum_absolute_error / static_cast<double>(this->count);
+    }
+
+    double RegressionAccumulator::r2() const {
+        return this->m2_true <= 0.0 ? 0.0 : 1.0 - this->sum_squared_error / this->m2_true;
+    }
+
+    void ClassificationAccumulator::add(int true_class, const double *proba, size_t n_classes) {
+        size_t best = std::max_element(proba, proba + n_classes) - proba;
+        this->count++;
+        if (best == static_cast<size_t>(true_class)) {
+            this->correct++;
         }
-        return sum / n;
+        this->sum_log_loss -= std::log(std::min(1.0, std::max(proba[true_class], MIN_PROBABILITY)));
     }
 
+    void ClassificationAccumulator::merge(const ClassificationAccumulator &other) {
+        this->count += other.count;
+        this->correct += other.correct;
+        this->sum_log_loss += other.sum_log_loss;
+    }
+
+    double ClassificationAccumulator::accuracy() const {
+        return this->count == 0 ? 0.0 : static_cast<double>(this->correct) / static_cast<double>(this->count);
+    }
 
-    static double r2_score(const std::vector<double> &y_true,
-                           const std::vector<double> &y_pred) {
-        double SS_res = 0.0;
-        double SS_tot = 0.0;
-        double mean_ = mean(y_true);
+    double ClassificationAccumulator::log_loss() const {
+        return this->count == 0 ? 0.0 : this->sum_log_loss / static_cast<double>(this->count);
+    }
 
+    // ==================== REGRESSION METRICS ====================
+
+    RegressionAccumulator Metrics::regression_report(const std::vector<double> &y_true,
+                                                     const std::vector<double> &y_pred) {
+        if (y_true.size() != y_pred.size()) {
+            throw std::invalid_argument("y_true and y_pred must have the same size.");
+        }
+        RegressionAccumulator accumulator;
         for (size_t i = 0; i < y_true.size(); i++) {
-            double diff = y_true[i] - y_pred[i];
-            SS_res += diff * diff;
-            diff = y_true - mean_;
-            SS_tot = diff * diff;
+            accumulator.add(y_true[i], y_pred[i]);
         }
-        return 1 - (SS_res / SS_tot);
+        return accumulator;
     }
 
-    static double accuracy(const std::vector<int> &y_true,
-                           const std::vector<int> &y_pred) {
+    double Metrics::mean_squared_error(const std::vector<double> &y_true,
+                                       const std::vector<double> &y_pred) {
+        return regression_report(y_true, y_pred).mse();
+    }
+
+    double Metrics::root_mean_squared_error(const std::vector<double> &y_true,
+                                            const std::vector<double> &y_pred) {
+        return regression_report(y_true, y_pred).rmse();
+    }
+
+    double Metrics::mean_absolute_error(const std::vector<double> &y_true,
+                                        const std::vector<double> &y_pred) {
+        return regression_report(y_true, y_pred).mae();
+    }
+
+    double Metrics::r2_score(const std::vector<double> &y_true,
+                             const std::vector<double> &y_pred) {
+        return regression_report(y_true, y_pred).r2();
+    }
+
+    // ==================== CLASSIFICATION METRICS ====================
+
+    double Metrics::accuracy(const std::vector<int> &y_true,
+                             const std::vector<int> &y_pred) {
         size_t total = y_true.size();
+        if (total == 0) {
+            return 0.0;
+        }
         size_t correct = 0;
         for (size_t i = 0; i < total; i++) {
             if (y_true[i] == y_pred[i]) {
                 correct++;
             }
         }
-        return static_cast<double>(total / correct);
+        return static_cast<double>(correct) / static_cast<double>(total);
     }
 
-
-    static std::vector<std::vector<int> > confusion_matrix(
+    std::vector<std::vector<int> > Metrics::confusion_matrix(
         const std::vector<int> &y_true,
         const std::vector<int> &y_pred,
         int n_classes) {
+        if (n_classes < 0) {
+            n_classes = 0;
+            for (size_t i = 0; i < y_true.size(); i++) {
+                n_classes = std::max(n_classes, std::max(y_true[i], y_pred[i]) + 1);
+            }
+        }
+        std::vector<std::vector<int> > matrix(n_classes, std::vector<int>(n_classes, 0));
+        for (size_t i = 0; i < y_true.size(); i++) {
+            if (y_true[i] >= 0 && y_true[i] < n_classes && y_pred[i] >= 0 && y_pred[i] < n_classes) {
+                matrix[y_true[i]][y_pred[i]]++;
+            }
+        }
+        return matrix;
     }
 
-
-    static double precision(const std::vector<int> &y_true,
-                            const std::vector<int> &y_pred,
-                            int target_class) {
-    }
-
-    static double recall(const std::vector<int> &y_true,
-                         const std::vector<int> &y_pred,
-                         int target_class) {
+    double Metrics::precision(const std::vector<int> &y_true,
+                              const std::vector<int> &y_pred,
+                              int target_class) {
+        size_t true_positives = 0;
+        size_t predicted_positives = 0;
+        for (size_t i = 0; i < y_true.size(); i++) {
+            if (y_pred[i] == target_class) {
+                predicted_positives++;
+                if (y_true[i] == target_class) {
+                    true_positives++;
+                }
+            }
+        }
+        return predicted_positives == 0 ? 0.0 : static_cast<double>(true_positives) / predicted_positives;
     }
 
-    static double f1_score(const std::vector<int> &y_true,
+    double Metrics::recall(const std::vector<int> &y_true,
                            const std::vector<int> &y_pred,
                            int target_class) {
+        size_t true_positives = 0;
+        size_t actual_positives = 0;
+        for (size_t i = 0; i < y_true.size(); i++) {
+            if (y_true[i] == target_class) {
+                actual_positives++;
+                if (y_pred[i] == target_class) {
+                    true_positives++;
+                }
+            }
+        }
+        return actual_positives == 0 ? 0.0 : static_cast<double>(true_positives) / actual_positives;
+    }
 
-        double precision_ = precision(y_true,y_pred,target_class);
-        double recall_ = recall(y_true,y_pred,target_class);
+    double Metrics::f1_score(const std::vector<int> &y_true,
+                             const std::vector<int> &y_pred,
+                             int target_class) {
+        double precision_ = precision(y_true, y_pred, target_class);
+        double recall_ = recall(y_true, y_pred, target_class);
+        if (precision_ + recall_ == 0.0) {
+            return 0.0;
+        }
         return 2 * (precision_ * recall_) / (precision_ + recall_);
     }
 
-    double mean(const std::vector<double> &values) {
+    double Metrics::log_loss(const std::vector<int> &y_true,
+                             const std::vector<std::vector<double> > &proba) {
+        if (y_true.size() != proba.size()) {
+            throw std::invalid_argument("y_true and proba must have the same size.");
+        }
+        ClassificationAccumulator accumulator;
+        for (size_t i = 0; i < y_true.size(); i++) {
+            accumulator.add(y_true[i], proba[i].data(), proba[i].size());
+        }
+        return accumulator.log_loss();
+    }
+
+    double Metrics::mean(const std::vector<double> &values) {
         size_t n = values.size();
+        if (n == 0) {
+            return 0.0;
+        }
         double sum = 0.0;
         for (size_t i = 0; i < n; i++) {
             sum += values[i];
@@ -0,0 +1,181 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/core/NeighborSearch.h"
+#include "../../include/core/Parallel.h"
+
+#include <algorithm>
+#include <limits>
+using namespace std;
+
+namespace mlcpp {
+    // Queries scored together against the reference set in the batch path
+    static constexpr size_t QUERY_BLOCK = 32;
+    // Reference rows per tile, so a tile stays in cache while a query block is scored
+    static constexpr size_t TRAIN_BLOCK = 256;
+
+    NeighborSearch::NeighborSearch(DistanceMetric distance) {
+        this->distance_ = distance;
+
+        // Recognize the built-in metrics that can be computed from dot products
+        using MetricFunction = double (*)(const vector<double> &, const vector<double> &);
+        const MetricFunction *function = this->distance_.target<MetricFunction>();
+        if (function != nullptr && *function == euclidean_distance) {
+            this->metric_kind_ = MetricKind::Euclidean;
+        } else if (function != nullptr && *function == cosine_distance) {
+            this->metric_kind_ = MetricKind::Cosine;
+        } else if (function != nullptr && *function == inner_product_distance) {
+            this->metric_kind_ = MetricKind::InnerProduct;
+        } else {
+            this->metric_kind_ = MetricKind::Generic;
+        }
+    }
+
+    void NeighborSearch::fit(vector<vector<double> > X) {
+        this->X_ = move(X);
+        this->norms_.assign(this->X_.size(), 0.0);
+        if (this->metric_kind_ == MetricKind::Euclidean || this->metric_kind_ == MetricKind::Cosine) {
+            parallel_for(this->X_.size(), [&](size_t begin, size_t end, size_t) {
+                for (size_t i = begin; i < end; i++) {
+                    this->norms_[i] = norm_term(this->X_[i]);
+                }
+            });
+        }
+    }
+
+    vector<Neighbor> NeighborSearch::kneighbors(const vector<double> &query, size_t k) const {
+        vector<Neighbor> scored;
+        scored.reserve(this->X_.size());
+        if (this->metric_kind_ == MetricKind::Generic) {
+            for (size_t i = 0; i < this->X_.size(); i++) {
+                scored.push_back({this->distance_(query, this->X_[i]), i});
+            }
+        } else {
+            // Fast path: one dot product per reference row, norms come from the cache
+            double query_norm = norm_term(query);
+            for (size_t i = 0; i < this->X_.size(); i++) {
+                scored.push_back({score_from_dot(dot_product(query, this->X_[i]), query_norm, i), i});
+            }
+        }
+        return select(scored, k);
+    }
+
+    vector<vector<Neighbor> > NeighborSearch::kneighbors(const vector<vector<double> > &queries, size_t k) const {
+        return search(queries, k, false);
+    }
+
+    vector<vector<Neighbor> > NeighborSearch::kneighbors_graph(size_t k) const {
+        size_t n = this->X_.size();
+        return search(this->X_, min(k, n == 0 ? 0 : n - 1), true);
+    }
+
+    vector<vector<Neighbor> > NeighborSearch::search(const vector<vector<double> > &queries, size_t k,
+                                                     bool exclude_self) const {
+        const double EXCLUDED = numeric_limits<double>::infinity();
+        size_t n = this->X_.size();
+        k = min(k, n);
+        vector<vector<Neighbor> > neighbors(queries.size());
+        if (this->metric_kind_ == MetricKind::Generic) {
+            parallel_for(queries.size(), [&](size_t begin, size_t end, size_t) {
+                for (size_t q = begin; q < end; q++) {
+                    vector<Neighbor> &heap = neighbors[q];
+                    heap.reserve(k);
+                    for (size_t i = 0; i < n; i++) {
+                        double score = exclude_self && i == q ? EXCLUDED : this->distance_(queries[q], this->X_[i]);
+                        offer_neighbor(heap, k, {score, i});
+                    }
+                    finish(heap);
+                }
+            }, 1);
+            return neighbors;
+        }
+
+        // Batch path: score a block of queries against tiles of the reference set. Each query
+        // only keeps its k best candidates, so memory stays O(queries * k) whatever n is.
+        size_t n_blocks = (queries.size() + QUERY_BLOCK - 1) / QUERY_BLOCK;
+        parallel_for(n_blocks, [&](size_t block_begin, size_t block_end, size_t) {
+            vector<double> query_norms(QUERY_BLOCK);
+            for (size_t block = block_begin; block < block_end; block++) {
+                size_t q_begin = block * QUERY_BLOCK;
+                size_t q_end = min(queries.size(), q_begin + QUERY_BLOCK);
+                for (size_t q = q_begin; q < q_end; q++) {
+                    query_norms[q - q_begin] = norm_term(queries[q]);
+                    neighbors[q].reserve(k);
+                }
+
+                for (size_t t_begin = 0; t_begin < n; t_begin += TRAIN_BLOCK) {
+                    size_t t_end = min(n, t_begin + TRAIN_BLOCK);
+                    for (size_t q = q_begin; q < q_end; q++) {
+                        const vector<double> &query = queries[q];
+                        vector<Neighbor> &heap = neighbors[q];
+                        for (size_t t = t_begin; t < t_end; t++) {
+                            double score = exclude_self && t == q
+                                               ? EXCLUDED
+                                               : score_from_dot(dot_product(query, this->X_[t]),
+                                                                query_norms[q - q_begin], t);
+                            offer_neighbor(heap, k, {score, t});
+                        }
+                    }
+                }
+
+                for (size_t q = q_begin; q < q_end; q++) {
+                    finish(neighbors[q]);
+                }
+            }
+        }, 1);
+        return neighbors;
+    }
+
+    void NeighborSearch::finish(vector<Neighbor> &heap) const {
+        sort_heap(heap.begin(), heap.end());
+        for (Neighbor &neighbor: heap) {
+            neighbor.first = score_to_distance(neighbor.first);
+        }
+    }
+
+    vector<Neighbor> NeighborSearch::select(vector<Neighbor> &scored, size_t k) const {
+        k = min(k, scored.size());
+        partial_sort(scored.begin(), scored.begin() + k, scored.end());
+        vector<Neighbor> nearest(scored.begin(), scored.begin() + k);
+        for (Neighbor &neighbor: nearest) {
+            neighbor.first = score_to_distance(neighbor.first);
+        }
+        return nearest;
+    }
+
+    double NeighborSearch::norm_term(const vector<double> &row) const {
+        switch (this->metric_kind_) {
+            case MetricKind::Euclidean:
+                return dot_product(row, row);
+            case MetricKind::Cosine:
+                return sqrt(dot_product(row, row));
+            default:
+                return 0.0;
+        }
+    }
+
+    double NeighborSearch::score_from_dot(double dot, double query_norm, size_t index) const {
+        switch (this->metric_kind_) {
+            case MetricKind::Euclidean:
+                // Squared distance ranks the same as the distance, without the sqrt
+                return query_norm + this->norms_[index] - 2.0 * dot;
+            case MetricKind::Cosine: {
+                double norms = query_norm * this->norms_[index];
+                return norms == 0.0 ? 1.0 : 1.0 - dot / norms;
+            }
+            case MetricKind::InnerProduct:
+                return -dot;
+            default:
+                return dot;
+        }
+    }
+
+    double NeighborSearch::score_to_distance(double score) const {
+        // Only the euclidean fast path ranks by a different quantity (squared distance)
+        if (this->metric_kind_ == MetricKind::Euclidean) {
+            return sqrt(max(score, 0.0));
+        }
+        return score;
+    }
+}
@@ -0,0 +1,109 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/core/SparseMatrix.h"
+#include "../../include/core/Parallel.h"
+
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    SparseMatrix::SparseMatrix(size_t rows, size_t n_features, vector<size_t> indptr,
+                               vector<uint32_t> indices, vector<double> values) {
+        if (indptr.size() != rows + 1 || indptr[0] != 0 || indptr[rows] != values.size()) {
+            throw invalid_argument("indptr must have rows + 1 offsets from 0 to the number of values.");
+        }
+        if (indices.size() != values.size()) {
+            throw invalid_argument("indices and values must have the same size.");
+        }
+        for (size_t r = 0; r < rows; r++) {
+            if (indptr[r] > indptr[r + 1]) {
+                throw invalid_argument("indptr must be non-decreasing.");
+            }
+        }
+        for (uint32_t index: indices) {
+            if (index >= n_features) {
+                throw invalid_argument("Feature index out of range.");
+            }
+        }
+        this->rows_ = rows;
+        this->n_features_ = n_features;
+        this->indptr_ = move(indptr);
+        this->indices_ = move(indices);
+        this->values_ = move(values);
+    }
+
+    SparseMatrix SparseMatrix::from_dense(const vector<vector<double> > &features) {
+        SparseMatrix matrix;
+        matrix.rows_ = features.size();
+        matrix.n_features_ = features.empty() ? 0 : features[0].size();
+        matrix.indptr_.reserve(features.size() + 1);
+        for (const vector<double> &row: features) {
+            if (row.size() != matrix.n_features_) {
+                throw invalid_argument("All samples must have the same number of features.");
+            }
+            for (size_t j = 0; j < row.size(); j++) {
+                if (row[j] != 0.0) {
+                    matrix.indices_.push_back(static_cast<uint32_t>(j));
+                    matrix.values_.push_back(row[j]);
+                }
+            }
+            matrix.indptr_.push_back(matrix.values_.size());
+        }
+        return matrix;
+    }
+
+    vector<double> SparseMatrix::multiply(const vector<double> &w) const {
+        if (w.size() != this->n_features_) {
+            throw invalid_argument("Vector size must match the number of features.");
+        }
+        vector<double> result(this->rows_);
+        parallel_for(this->rows_, [&](size_t begin, size_t end, size_t) {
+            for (size_t r = begin; r < end; r++) {
+                result[r] = row_dot(r, w.data());
+            }
+        });
+        return result;
+    }
+
+    vector<double> SparseMatrix::multiply_transpose(const vector<double> &y) const {
+        if (y.size() != this->rows_) {
+            throw invalid_argument("Vector size must match the number of samples.");
+        }
+        vector<vector<double> > partial(num_threads());
+        size_t chunks = parallel_for(this->rows_, [&](size_t begin, size_t end, size_t chunk) {
+            partial[chunk].assign(this->n_features_, 0.0);
+            for (size_t r = begin; r < end; r++) {
+                row_axpy(r, y[r], partial[chunk].data());
+            }
+        });
+        vector<double> result(this->n_features_, 0.0);
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            for (size_t j = 0; j < this->n_features_; j++) {
+                result[j] += partial[chunk][j];
+            }
+        }
+        return result;
+    }
+
+    vector<double> SparseMatrix::column_squared_norms(const vector<double> &weights) const {
+        vector<vector<double> > partial(num_threads());
+        size_t chunks = parallel_for(this->rows_, [&](size_t begin, size_t end, size_t chunk) {
+            partial[chunk].assign(this->n_features_, 0.0);
+            for (size_t r = begin; r < end; r++) {
+                double weight = weights.empty() ? 1.0 : weights[r];
+                for (size_t k = this->indptr_[r]; k < this->indptr_[r + 1]; k++) {
+                    partial[chunk][this->indices_[k]] += weight * this->values_[k] * this->values_[k];
+                }
+            }
+        });
+        vector<double> result(this->n_features_, 0.0);
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            for (size_t j = 0; j < this->n_features_; j++) {
+                result[j] += partial[chunk][j];
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,233 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/io/Checkpoint.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+namespace mlcpp {
+    static constexpr char MAGIC[8] = {'M', 'L', 'C', 'P', 'P', 'C', 'K', 'P'};
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * @brief Fixed-size header at the start of checkpoint files.
+     */
+    struct CheckpointHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t model;
+        uint64_t epoch;
+        uint64_t rng_counter;
+        uint64_t n_parameters;
+        uint64_t n_optimizer;
+    };
+
+    // FNV-1a hash of the bytes before the checksum, to reject torn or corrupted files
+    static uint64_t checksum(const char *data, size_t size) {
+        uint64_t hash = 14695981039346656037ULL;
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ static_cast<unsigned char>(data[i])) * 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    // Writes a whole file and, where supported, waits until its contents reach the disk
+    static bool write_file(const string &path, const char *data, size_t size) {
+#if !defined(_WIN32)
+        int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            return false;
+        }
+        size_t written = 0;
+        while (written < size) {
+            ssize_t count = ::write(fd, data + written, size - written);
+            if (count < 0 && errno == EINTR) {
+                continue;
+            }
+            if (count <= 0) {
+                close(fd);
+                return false;
+            }
+            written += static_cast<size_t>(count);
+        }
+        bool synced = fsync(fd) == 0;
+        return close(fd) == 0 && synced;
+#else
+        ofstream file(path, ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(data, static_cast<streamsize>(size));
+        return static_cast<bool>(file.flush());
+#endif
+    }
+
+    // Makes a rename inside the directory of path durable (no-op where directories cannot be synced)
+    static bool sync_directory(const string &path) {
+#if !defined(_WIN32)
+        size_t slash = path.find_last_of('/');
+        string directory = slash == string::npos ? "." : (slash == 0 ? "/" : path.substr(0, slash));
+        int fd = open(directory.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        // Some file systems do not support syncing a directory; the rename is then as durable as it gets
+        bool synced = fsync(fd) == 0 || errno == EINVAL;
+        close(fd);
+        return synced;
+#else
+        (void) path;
+        return true;
+#endif
+    }
+
+    CheckpointWriter::CheckpointWriter(string path) {
+        this->path_ = move(path);
+    }
+
+    CheckpointWriter::~CheckpointWriter() {
+        {
+            lock_guard<mutex> lock(this->mutex_);
+            this->stop_ = true;
+        }
+        this->changed_.notify_all();
+        if (this->worker_.joinable()) {
+            this->worker_.join();
+        }
+    }
+
+    void CheckpointWriter::submit(TrainingState state) {
+        {
+            lock_guard<mutex> lock(this->mutex_);
+            this->pending_ = move(state);
+            if (!this->worker_.joinable()) {
+                this->worker_ = thread(&CheckpointWriter::run, this);
+            }
+        }
+        this->changed_.notify_all();
+    }
+
+    bool CheckpointWriter::flush() {
+        unique_lock<mutex> lock(this->mutex_);
+        this->changed_.wait(lock, [this] { return !this->pending_ && !this->writing_; });
+        return this->last_ok_;
+    }
+
+    void CheckpointWriter::run() {
+        unique_lock<mutex> lock(this->mutex_);
+        while (true) {
+            this->changed_.wait(lock, [this] { return this->pending_ || this->stop_; });
+            if (!this->pending_) {
+                return;  // Stopped with nothing left to write
+            }
+            TrainingState state = move(*this->pending_);
+            this->pending_.reset();
+            this->writing_ = true;
+
+            // The disk write runs unlocked, so submit() never waits for it
+            lock.unlock();
+            bool ok = write(state, this->path_);
+            lock.lock();
+            this->writing_ = false;
+            this->last_ok_ = ok;
+            this->changed_.notify_all();
+        }
+    }
+
+    bool CheckpointWriter::write(const TrainingState &state, const string &path) {
+        // 1. Serialize header, arrays and checksum into one buffer
+        CheckpointHeader header{};
+        memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.model = state.model;
+        header.epoch = state.epoch;
+        header.rng_counter = state.rng_counter;
+        header.n_parameters = state.parameters.size();
+        header.n_optimizer = state.optimizer.size();
+        size_t parameter_bytes = state.parameters.size() * sizeof(double);
+        size_t optimizer_bytes = state.optimizer.size() * sizeof(double);
+        vector<char> buffer(sizeof(header) + parameter_bytes + optimizer_bytes + sizeof(uint64_t));
+        char *out = buffer.data();
+        memcpy(out, &header, sizeof(header));
+        if (parameter_bytes > 0) {
+            memcpy(out + sizeof(header), state.parameters.data(), parameter_bytes);
+        }
+        if (optimizer_bytes > 0) {
+            memcpy(out + sizeof(header) + parameter_bytes, state.optimizer.data(), optimizer_bytes);
+        }
+        size_t body = buffer.size() - sizeof(uint64_t);
+        uint64_t sum = checksum(out, body);
+        memcpy(out + body, &sum, sizeof(sum));
+
+        // 2. Write and sync a temporary file, then replace the previous checkpoint atomically
+        //    and sync the directory, so the new name survives a crash too
+        string temporary = path + ".tmp";
+        if (!write_file(temporary, out, buffer.size())) {
+            return false;
+        }
+        if (rename(temporary.c_str(), path.c_str()) != 0) {
+            return false;
+        }
+        return sync_directory(path);
+    }
+
+    optional<TrainingState> CheckpointWriter::read(const string &path) {
+        ifstream file(path, ios::binary | ios::ate);
+        if (!file.is_open()) {
+            return {};
+        }
+        size_t size = static_cast<size_t>(file.tellg());
+        if (size < sizeof(CheckpointHeader) + sizeof(uint64_t)) {
+            return {};
+        }
+        vector<char> buffer(size);
+        file.seekg(0);
+        if (!file.read(buffer.data(), static_cast<streamsize>(size))) {
+            return {};
+        }
+
+        // 1. Header, sizes and checksum must all agree
+        CheckpointHeader header{};
+        memcpy(&header, buffer.data(), sizeof(header));
+        if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+            return {};
+        }
+        size_t max_values = size / sizeof(double);
+        if (header.n_parameters > max_values || header.n_optimizer > max_values ||
+            sizeof(header) + (header.n_parameters + header.n_optimizer) * sizeof(double) + sizeof(uint64_t) != size) {
+            return {};
+        }
+        uint64_t sum;
+        memcpy(&sum, buffer.data() + size - sizeof(sum), sizeof(sum));
+        if (sum != checksum(buffer.data(), size - sizeof(sum))) {
+            return {};
+        }
+
+        // 2. Copy out the arrays
+        TrainingState state;
+        state.model = header.model;
+        state.epoch = header.epoch;
+        state.rng_counter = header.rng_counter;
+        state.parameters.resize(header.n_parameters);
+        state.optimizer.resize(header.n_optimizer);
+        const char *data = buffer.data() + sizeof(header);
+        if (header.n_parameters > 0) {
+            memcpy(state.parameters.data(), data, header.n_parameters * sizeof(double));
+        }
+        if (header.n_optimizer > 0) {
+            memcpy(state.optimizer.data(), data + header.n_parameters * sizeof(double),
+                   header.n_optimizer * sizeof(double));
+        }
+        return state;
+    }
+}
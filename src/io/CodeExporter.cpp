@@ -0,0 +1,360 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/io/CodeExporter.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    // Significant digits that round-trip any double through its decimal literal
+    static constexpr int LITERAL_DIGITS = 17;
+    // Values written per line of a generated array
+    static constexpr size_t VALUES_PER_LINE = 4;
+
+    // Rejects namespace names that would not compile
+    static void check_name(const string &name) {
+        bool valid = !name.empty() && (isalpha(static_cast<unsigned char>(name[0])) || name[0] == '_');
+        for (char c: name) {
+            valid = valid && (isalnum(static_cast<unsigned char>(c)) || c == '_');
+        }
+        if (!valid) {
+            throw invalid_argument("name must be a C++ identifier.");
+        }
+    }
+
+    // Decimal literal of a double that parses back to the same value
+    static string literal(double value) {
+        if (!isfinite(value)) {
+            throw invalid_argument("Exported model parameters must be finite.");
+        }
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "%.*g", LITERAL_DIGITS, value);
+        string text = buffer;
+        if (text.find_first_of(".e") == string::npos) {
+            text += ".0";
+        }
+        return text;
+    }
+
+    // Comma-separated literals, VALUES_PER_LINE per line at the given indentation
+    static string literal_list(const double *values, size_t count, const string &indent) {
+        string text;
+        for (size_t i = 0; i < count; i++) {
+            text += i % VALUES_PER_LINE == 0 ? "\n" + indent : " ";
+            text += literal(values[i]) + (i + 1 < count ? "," : "");
+        }
+        return text;
+    }
+
+    // Opening lines of every generated header: guard, includes and namespace
+    static string header_begin(const string &name, const string &description,
+                               const string &includes = "#include <cstddef>\n") {
+        string guard = name;
+        transform(guard.begin(), guard.end(), guard.begin(), [](unsigned char c) { return toupper(c); });
+        return "// " + description + "\n"
+               "// Generated by mlcpp::CodeExporter; depends only on the standard library.\n\n"
+               "#ifndef " + guard + "_H\n"
+               "#define " + guard + "_H\n"
+               + includes + "\n"
+               "namespace " + name + " {\n";
+    }
+
+    static string header_end(const string &name) {
+        string guard = name;
+        transform(guard.begin(), guard.end(), guard.begin(), [](unsigned char c) { return toupper(c); });
+        return "}\n\n#endif // " + guard + "_H\n";
+    }
+
+    // Dot product of x with a constexpr row, as four independent partial sums
+    static string dot_function() {
+        return "    // Four independent partial sums: vectorizes without reassociating the additions\n"
+               "    inline double dot(const double* w, const double* x) {\n"
+               "        double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;\n"
+               "        std::size_t j = 0;\n"
+               "        for (; j + 4 <= n_features; j += 4) {\n"
+               "            s0 += w[j] * x[j];\n"
+               "            s1 += w[j + 1] * x[j + 1];\n"
+               "            s2 += w[j + 2] * x[j + 2];\n"
+               "            s3 += w[j + 3] * x[j + 3];\n"
+               "        }\n"
+               "        for (; j < n_features; j++) {\n"
+               "            s0 += w[j] * x[j];\n"
+               "        }\n"
+               "        return (s0 + s1) + (s2 + s3);\n"
+               "    }\n\n";
+    }
+
+    // Unrolls the subtree under a node into nested branches; leaf(index) is the statement of a leaf
+    template<typename LeafStatement>
+    static void emit_node(const FlatTree &tree, int index, int depth, string &code, const LeafStatement &leaf) {
+        const TreeNode &node = tree.nodes[index];
+        string indent(4 * (depth + 2), ' ');
+        if (node.feature < 0) {
+            code += indent + leaf(node.leaf) + "\n";
+            return;
+        }
+        code += indent + "if (x[" + to_string(node.feature) + "] <= " + literal(node.threshold) + ") {\n";
+        emit_node(tree, node.left, depth + 1, code, leaf);
+        code += indent + "} else {\n";
+        emit_node(tree, node.left + 1, depth + 1, code, leaf);
+        code += indent + "}\n";
+    }
+
+    // Features read by a tree: one past the highest split feature
+    static size_t tree_features(const FlatTree &tree) {
+        int highest = -1;
+        for (const TreeNode &node: tree.nodes) {
+            highest = max(highest, node.feature);
+        }
+        return static_cast<size_t>(highest + 1);
+    }
+
+    string CodeExporter::export_model(const LinearRegression &model, const string &name) {
+        check_name(name);
+        const vector<double> &weights = model.get_weights();
+        const vector<vector<double> > &coefficients = model.get_coefficients();
+        const vector<double> &intercepts = model.get_intercepts();
+        if (weights.empty() && intercepts.empty()) {
+            throw logic_error("LinearRegression must be fitted before export.");
+        }
+        string code = header_begin(name, "Linear regression model");
+
+        // 1. Single target: one weight row and a scalar prediction
+        if (!weights.empty()) {
+            code += "    constexpr std::size_t n_features = " + to_string(weights.size()) + ";\n"
+                    "    constexpr double bias = " + literal(model.get_bias()) + ";\n"
+                    "    constexpr double weights[n_features] = {" +
+                    literal_list(weights.data(), weights.size(), "        ") + "\n    };\n\n";
+            code += dot_function();
+            code += "    // x: n_features raw feature values\n"
+                    "    inline double predict(const double* x) {\n"
+                    "        return bias + dot(weights, x);\n"
+                    "    }\n";
+            return code + header_end(name);
+        }
+
+        // 2. Multi-output: coefficients stored per target, so each output is one contiguous dot product
+        size_t d = coefficients.size();
+        size_t t = intercepts.size();
+        code += "    constexpr std::size_t n_features = " + to_string(d) + ";\n"
+                "    constexpr std::size_t n_targets = " + to_string(t) + ";\n"
+                "    constexpr double intercepts[n_targets] = {" +
+                literal_list(intercepts.data(), t, "        ") + "\n    };\n"
+                "    constexpr double coefficients[n_targets][n_features] = {\n";
+        vector<double> column(d);
+        for (size_t k = 0; k < t; k++) {
+            for (size_t j = 0; j < d; j++) {
+                column[j] = coefficients[j][k];
+            }
+            code += "        {" + literal_list(column.data(), d, "            ") + "\n        }" +
+                    (k + 1 < t ? ",\n" : "\n");
+        }
+        code += "    };\n\n";
+        code += dot_function();
+        code += "    // x: n_features raw feature values; out: n_targets predictions\n"
+                "    inline void predict(const double* x, double* out) {\n"
+                "        for (std::size_t k = 0; k < n_targets; k++) {\n"
+                "            out[k] = intercepts[k] + dot(coefficients[k], x);\n"
+                "        }\n"
+                "    }\n";
+        return code + header_end(name);
+    }
+
+    string CodeExporter::export_model(const DecisionTreeRegressor &model, const string &name) {
+        check_name(name);
+        const FlatTree &tree = model.get_tree();
+        if (tree.nodes.empty()) {
+            throw logic_error("DecisionTreeRegressor must be fitted before export.");
+        }
+        string code = header_begin(name, "Decision tree regressor");
+        code += "    constexpr std::size_t n_features = " + to_string(tree_features(tree)) + ";\n\n"
+                "    // x: at least n_features raw feature values\n"
+                "    inline double predict(const double* x) {\n";
+        emit_node(tree, 0, 0, code, [&](int leaf) {
+            return "return " + literal(tree.leaf_values[static_cast<size_t>(leaf) * tree.n_outputs]) + ";";
+        });
+        code += "    }\n";
+        return code + header_end(name);
+    }
+
+    string CodeExporter::export_model(const DecisionTreeClassifier &model, const string &name) {
+        check_name(name);
+        const FlatTree &tree = model.get_tree();
+        if (tree.nodes.empty()) {
+            throw logic_error("DecisionTreeClassifier must be fitted before export.");
+        }
+        const vector<int> &classes = model.get_classes();
+        size_t n_leaves = tree.leaf_values.size() / tree.n_outputs;
+
+        // 1. Class labels and the probabilities of every leaf
+        string code = header_begin(name, "Decision tree classifier");
+        code += "    constexpr std::size_t n_features = " + to_string(tree_features(tree)) + ";\n"
+                "    constexpr std::size_t n_classes = " + to_string(classes.size()) + ";\n"
+                "    constexpr int classes[n_classes] = {";
+        for (size_t c = 0; c < classes.size(); c++) {
+            code += to_string(classes[c]) + (c + 1 < classes.size() ? ", " : "");
+        }
+        code += "};\n"
+                "    constexpr double leaf_proba[" + to_string(n_leaves) + "][n_classes] = {\n";
+        for (size_t leaf = 0; leaf < n_leaves; leaf++) {
+            code += "        {" + literal_list(tree.leaf_values.data() + leaf * tree.n_outputs, tree.n_outputs,
+                                               "            ") +
+                    "\n        }" + (leaf + 1 < n_leaves ? ",\n" : "\n");
+        }
+        code += "    };\n\n";
+
+        // 2. Branches selecting the leaf, then the most probable class (first on ties)
+        code += "    // x: at least n_features raw feature values; returns n_classes probabilities\n"
+                "    inline const double* predict_proba(const double* x) {\n";
+        emit_node(tree, 0, 0, code, [](int leaf) {
+            return "return leaf_proba[" + to_string(leaf) + "];";
+        });
+        code += "    }\n\n"
+                "    inline int predict(const double* x) {\n"
+                "        const double* proba = predict_proba(x);\n"
+                "        std::size_t best = 0;\n"
+                "        for (std::size_t c = 1; c < n_classes; c++) {\n"
+                "            if (proba[c] > proba[best]) {\n"
+                "                best = c;\n"
+                "            }\n"
+                "        }\n"
+                "        return classes[best];\n"
+                "    }\n";
+        return code + header_end(name);
+    }
+
+    string CodeExporter::export_model(const KNN &model, const string &name) {
+        check_name(name);
+        const NeighborSearch &search = model.get_search();
+        if (model.is_binary() || search.size() == 0) {
+            throw logic_error("KNN must be fitted on dense features before export.");
+        }
+        if (model.is_mahalanobis()) {
+            throw invalid_argument("Mahalanobis KNN models cannot be exported.");
+        }
+        NeighborSearch::MetricKind kind = search.get_metric_kind();
+        if (kind == NeighborSearch::MetricKind::Generic) {
+            throw invalid_argument("Only euclidean, cosine and inner product KNN models can be exported.");
+        }
+        if (model.get_k() < 1) {
+            throw invalid_argument("k must be at least 1.");
+        }
+        const vector<vector<double> > &rows = search.get_data();
+        const vector<int> &labels = model.get_labels();
+        size_t n = rows.size();
+        size_t d = rows[0].size();
+
+        // 1. Classes in the order KNN breaks vote ties (ascending label as size_t)
+        vector<int> classes(labels);
+        sort(classes.begin(), classes.end(), [](int a, int b) {
+            return static_cast<size_t>(a) < static_cast<size_t>(b);
+        });
+        classes.erase(unique(classes.begin(), classes.end()), classes.end());
+
+        // 2. Reference rows, their norm terms and class indices
+        bool euclidean = kind == NeighborSearch::MetricKind::Euclidean;
+        bool cosine = kind == NeighborSearch::MetricKind::Cosine;
+        string code = header_begin(name, "K-nearest neighbors classifier",
+                                   cosine ? "#include <cmath>\n#include <cstddef>\n" : "#include <cstddef>\n");
+        code += "    constexpr std::size_t n_features = " + to_string(d) + ";\n"
+                "    constexpr std::size_t n_references = " + to_string(n) + ";\n"
+                "    constexpr std::size_t k = " + to_string(min(static_cast<size_t>(model.get_k()), n)) + ";\n"
+                "    constexpr std::size_t n_classes = " + to_string(classes.size()) + ";\n"
+                "    constexpr int classes[n_classes] = {";
+        for (size_t c = 0; c < classes.size(); c++) {
+            code += to_string(classes[c]) + (c + 1 < classes.size() ? ", " : "");
+        }
+        code += "};\n"
+                "    constexpr std::size_t reference_class[n_references] = {";
+        for (size_t i = 0; i < n; i++) {
+            size_t c = lower_bound(classes.begin(), classes.end(), labels[i], [](int a, int b) {
+                return static_cast<size_t>(a) < static_cast<size_t>(b);
+            }) - classes.begin();
+            code += (i % (4 * VALUES_PER_LINE) == 0 ? "\n        " : " ") + to_string(c) + (i + 1 < n ? "," : "");
+        }
+        code += "\n    };\n"
+                "    constexpr double references[n_references][n_features] = {\n";
+        for (size_t i = 0; i < n; i++) {
+            code += "        {" + literal_list(rows[i].data(), d, "            ") + "\n        }" +
+                    (i + 1 < n ? ",\n" : "\n");
+        }
+        code += "    };\n";
+        if (euclidean || cosine) {
+            vector<double> norms(n);
+            for (size_t i = 0; i < n; i++) {
+                double squared = 0.0;
+                for (double value: rows[i]) {
+                    squared += value * value;
+                }
+                norms[i] = euclidean ? squared : sqrt(squared);
+            }
+            code += string("    // ") + (euclidean ? "Squared norm" : "Norm") + " of each reference row\n"
+                    "    constexpr double norms[n_references] = {" +
+                    literal_list(norms.data(), n, "        ") + "\n    };\n";
+        }
+        code += "\n" + dot_function();
+
+        // 3. Scan keeping the k lowest scores (earlier rows first on ties), then the majority vote
+        string score;
+        if (euclidean) {
+            score = "query_norm + norms[i] - 2.0 * dot(references[i], x)";
+        } else if (cosine) {
+            score = "query_norm * norms[i] == 0.0 ? 1.0 : 1.0 - dot(references[i], x) / (query_norm * norms[i])";
+        } else {
+            score = "-dot(references[i], x)";
+        }
+        code += "    // x: n_features raw feature values\n"
+                "    inline int predict(const double* x) {\n";
+        if (euclidean) {
+            code += "        double query_norm = dot(x, x);\n";
+        } else if (cosine) {
+            code += "        double query_norm = std::sqrt(dot(x, x));\n";
+        }
+        code += "        double best_score[k];\n"
+                "        std::size_t best_index[k];\n"
+                "        std::size_t found = 0;\n"
+                "        for (std::size_t i = 0; i < n_references; i++) {\n"
+                "            double score = " + score + ";\n"
+                "            if (found == k && !(score < best_score[k - 1])) {\n"
+                "                continue;\n"
+                "            }\n"
+                "            std::size_t position = found < k ? found++ : k - 1;\n"
+                "            while (position > 0 && best_score[position - 1] > score) {\n"
+                "                best_score[position] = best_score[position - 1];\n"
+                "                best_index[position] = best_index[position - 1];\n"
+                "                position--;\n"
+                "            }\n"
+                "            best_score[position] = score;\n"
+                "            best_index[position] = i;\n"
+                "        }\n"
+                "        std::size_t votes[n_classes] = {};\n"
+                "        for (std::size_t m = 0; m < found; m++) {\n"
+                "            votes[reference_class[best_index[m]]]++;\n"
+                "        }\n"
+                "        std::size_t best = 0;\n"
+                "        for (std::size_t c = 1; c < n_classes; c++) {\n"
+                "            if (votes[c] > votes[best]) {\n"
+                "                best = c;\n"
+                "            }\n"
+                "        }\n"
+                "        return classes[best];\n"
+                "    }\n";
+        return code + header_end(name);
+    }
+
+    bool CodeExporter::save(const string &source, const string &path) {
+        ofstream file(path, ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file << source;
+        return static_cast<bool>(file);
+    }
+}
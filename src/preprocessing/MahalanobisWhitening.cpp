@@ -0,0 +1,142 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/preprocessing/MahalanobisWhitening.h"
+#include "../../include/core/LinearAlgebra.h"
+#include "../../include/core/Parallel.h"
+
+#include <cmath>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    MahalanobisWhitening::MahalanobisWhitening(double regularization) {
+        this->regularization_ = regularization;
+    }
+
+    void MahalanobisWhitening::fit(const Dataset &dataset) {
+        fit(dataset.get_features());
+    }
+
+    void MahalanobisWhitening::fit(const vector<vector<double> > &X) {
+        if (X.size() < 2) {
+            throw invalid_argument("MahalanobisWhitening requires at least 2 samples.");
+        }
+        size_t d = X[0].size();
+
+        // 1. One pass: per-thread count, mean and co-moment (lower triangle)
+        struct Moments {
+            double count = 0.0;
+            vector<double> mean;
+            vector<double> comoment; // [d * d], lower triangle used
+        };
+        size_t threads = num_threads();
+        vector<Moments> partials(threads);
+        parallel_for(X.size(), [&](size_t begin, size_t end, size_t chunk) {
+            Moments &m = partials[chunk];
+            m.mean.assign(d, 0.0);
+            m.comoment.assign(d * d, 0.0);
+            vector<double> delta(d);
+            for (size_t i = begin; i < end; i++) {
+                m.count += 1.0;
+                for (size_t j = 0; j < d; j++) {
+                    delta[j] = X[i][j] - m.mean[j];
+                    m.mean[j] += delta[j] / m.count;
+                }
+                // Welford: C += delta_old * (x - mean_new)^T
+                for (size_t r = 0; r < d; r++) {
+                    double after = X[i][r] - m.mean[r];
+                    double *row = m.comoment.data() + r * d;
+                    for (size_t c = 0; c <= r; c++) {
+                        row[c] += after * delta[c];
+                    }
+                }
+            }
+        });
+
+        // 2. Merge the partial moments (Chan et al.)
+        Moments total;
+        total.mean.assign(d, 0.0);
+        total.comoment.assign(d * d, 0.0);
+        for (const Moments &m: partials) {
+            if (m.count == 0.0) {
+                continue;
+            }
+            double n = total.count + m.count;
+            double factor = total.count * m.count / n;
+            vector<double> delta(d);
+            for (size_t j = 0; j < d; j++) {
+                delta[j] = m.mean[j] - total.mean[j];
+            }
+            for (size_t r = 0; r < d; r++) {
+                for (size_t c = 0; c <= r; c++) {
+                    total.comoment[r * d + c] += m.comoment[r * d + c] + delta[r] * delta[c] * factor;
+                }
+            }
+            for (size_t j = 0; j < d; j++) {
+                total.mean[j] += delta[j] * m.count / n;
+            }
+            total.count = n;
+        }
+
+        // 3. Regularized covariance and its Cholesky factor
+        vector<vector<double> > covariance(d, vector<double>(d, 0.0));
+        double trace = 0.0;
+        for (size_t r = 0; r < d; r++) {
+            for (size_t c = 0; c <= r; c++) {
+                covariance[r][c] = total.comoment[r * d + c] / (total.count - 1.0);
+                covariance[c][r] = covariance[r][c];
+            }
+            trace += covariance[r][r];
+        }
+        double ridge = this->regularization_ * (trace > 0.0 ? trace / d : 1.0);
+        for (size_t j = 0; j < d; j++) {
+            covariance[j][j] += ridge;
+        }
+
+        this->mean_ = total.mean;
+        this->cholesky_ = LinearAlgebra::cholesky(covariance);
+    }
+
+    vector<double> MahalanobisWhitening::transform(const vector<double> &sample) const {
+        if (sample.size() != this->mean_.size()) {
+            throw invalid_argument("Sample must have the same number of features as the training data.");
+        }
+        vector<double> centered(sample.size());
+        for (size_t j = 0; j < sample.size(); j++) {
+            centered[j] = sample[j] - this->mean_[j];
+        }
+        return LinearAlgebra::solve_lower(this->cholesky_, centered);
+    }
+
+    vector<vector<double> > MahalanobisWhitening::transform(const vector<vector<double> > &X) const {
+        vector<vector<double> > whitened(X.size());
+        parallel_for(X.size(), [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                whitened[i] = transform(X[i]);
+            }
+        }, 64);
+        return whitened;
+    }
+
+    Dataset MahalanobisWhitening::transform(const Dataset &dataset) const {
+        return Dataset(transform(dataset.get_features()), dataset.get_labels());
+    }
+
+    double MahalanobisWhitening::distance(const vector<double> &a, const vector<double> &b) const {
+        if (a.size() != this->mean_.size() || b.size() != this->mean_.size()) {
+            throw invalid_argument("Sample must have the same number of features as the training data.");
+        }
+        vector<double> diff(a.size());
+        for (size_t j = 0; j < a.size(); j++) {
+            diff[j] = a[j] - b[j];
+        }
+        vector<double> z = LinearAlgebra::solve_lower(this->cholesky_, diff);
+        double sum = 0.0;
+        for (double value: z) {
+            sum += value * value;
+        }
+        return sqrt(sum);
+    }
+}
@@ -0,0 +1,353 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/preprocessing/PCA.h"
+#include "../../include/core/LinearAlgebra.h"
+#include "../../include/core/Parallel.h"
+
+#include <cmath>
+#include <random>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    PCA::PCA(int n_components, int n_power_iterations, int n_oversamples, int seed) {
+        this->n_components_ = n_components;
+        this->n_power_iterations_ = n_power_iterations;
+        this->n_oversamples_ = n_oversamples;
+        this->seed_ = seed;
+    }
+
+    void PCA::fit(const Dataset &dataset) {
+        fit(dataset.get_features());
+    }
+
+    // Randomized SVD (Halko, Martinsson & Tropp) on the implicitly centered data:
+    // Xc * M is computed as X * M - 1 * (mean^T * M), so X is never copied
+    void PCA::fit(const vector<vector<double> > &X) {
+        if (X.empty() || this->n_components_ <= 0) {
+            throw invalid_argument("PCA requires data and a positive number of components.");
+        }
+        size_t n = X.size();
+        size_t d = X[0].size();
+        size_t l = min(d, static_cast<size_t>(this->n_components_ + this->n_oversamples_));
+        size_t threads = num_threads();
+
+        // 1. Mean and total variance of each feature (two parallel passes)
+        vector<vector<double> > partials(threads, vector<double>(d, 0.0));
+        parallel_for(n, [&](size_t begin, size_t end, size_t chunk) {
+            for (size_t i = begin; i < end; i++) {
+                for (size_t j = 0; j < d; j++) {
+                    partials[chunk][j] += X[i][j];
+                }
+            }
+        });
+        this->mean_.assign(d, 0.0);
+        for (const auto &partial: partials) {
+            for (size_t j = 0; j < d; j++) {
+                this->mean_[j] += partial[j];
+            }
+        }
+        for (size_t j = 0; j < d; j++) {
+            this->mean_[j] /= n;
+        }
+
+        for (auto &partial: partials) {
+            fill(partial.begin(), partial.end(), 0.0);
+        }
+        parallel_for(n, [&](size_t begin, size_t end, size_t chunk) {
+            for (size_t i = begin; i < end; i++) {
+                for (size_t j = 0; j < d; j++) {
+                    double diff = X[i][j] - this->mean_[j];
+                    partials[chunk][j] += diff * diff;
+                }
+            }
+        });
+        this->squared_deviations_.assign(d, 0.0);
+        for (const auto &partial: partials) {
+            for (size_t j = 0; j < d; j++) {
+                this->squared_deviations_[j] += partial[j];
+            }
+        }
+        this->n_samples_seen_ = n;
+
+        // Helpers for products with the centered data
+        auto centered_times = [&](const vector<vector<double> > &M) {
+            // Xc * M  [n][cols]
+            vector<vector<double> > Y = LinearAlgebra::matmul(X, M);
+            size_t cols = M.empty() ? 0 : M[0].size();
+            vector<double> shift(cols, 0.0);
+            for (size_t j = 0; j < d; j++) {
+                for (size_t c = 0; c < cols; c++) {
+                    shift[c] += this->mean_[j] * M[j][c];
+                }
+            }
+            parallel_for(n, [&](size_t begin, size_t end, size_t) {
+                for (size_t i = begin; i < end; i++) {
+                    for (size_t c = 0; c < cols; c++) {
+                        Y[i][c] -= shift[c];
+                    }
+                }
+            });
+            return Y;
+        };
+        auto centered_transpose_times = [&](const vector<vector<double> > &Q) {
+            // Xc^T * Q  [d][cols]
+            vector<vector<double> > Z = LinearAlgebra::matmul_transpose_a(X, Q);
+            size_t cols = Q[0].size();
+            vector<double> column_sums(cols, 0.0);
+            for (size_t i = 0; i < n; i++) {
+                for (size_t c = 0; c < cols; c++) {
+                    column_sums[c] += Q[i][c];
+                }
+            }
+            for (size_t j = 0; j < d; j++) {
+                for (size_t c = 0; c < cols; c++) {
+                    Z[j][c] -= this->mean_[j] * column_sums[c];
+                }
+            }
+            return Z;
+        };
+
+        // 2. Random Gaussian test matrix [d][l]
+        mt19937 generator(this->seed_);
+        normal_distribution<double> gaussian(0.0, 1.0);
+        vector<vector<double> > omega(d, vector<double>(l));
+        for (size_t j = 0; j < d; j++) {
+            for (size_t c = 0; c < l; c++) {
+                omega[j][c] = gaussian(generator);
+            }
+        }
+
+        // 3. Range finder with power iterations, re-orthonormalizing at each step
+        vector<vector<double> > Q = centered_times(omega);
+        LinearAlgebra::orthonormalize_columns(Q);
+        for (int it = 0; it < this->n_power_iterations_; it++) {
+            vector<vector<double> > Z = centered_transpose_times(Q);
+            LinearAlgebra::orthonormalize_columns(Z);
+            Q = centered_times(Z);
+            LinearAlgebra::orthonormalize_columns(Q);
+        }
+
+        // 4. Project onto the range: B = Q^T * Xc  [l][d], then a small SVD
+        vector<vector<double> > Bt = centered_transpose_times(Q);
+        vector<vector<double> > B(l, vector<double>(d));
+        for (size_t j = 0; j < d; j++) {
+            for (size_t c = 0; c < l; c++) {
+                B[c][j] = Bt[j][c];
+            }
+        }
+        set_components_from_rows(B);
+    }
+
+    // Incremental PCA (Ross et al.): SVD of [S * V ; Xb - mean_b ; correction]
+    void PCA::partial_fit(const vector<vector<double> > &X_batch) {
+        if (X_batch.empty()) {
+            return;
+        }
+        if (this->n_components_ <= 0) {
+            throw invalid_argument("PCA requires a positive number of components.");
+        }
+        size_t b = X_batch.size();
+        size_t d = X_batch[0].size();
+        if (this->n_samples_seen_ > 0 && d != this->mean_.size()) {
+            throw invalid_argument("Batch has a different number of features than previous data.");
+        }
+
+        // 1. Batch mean and squared deviations
+        vector<double> batch_mean(d, 0.0);
+        for (size_t i = 0; i < b; i++) {
+            for (size_t j = 0; j < d; j++) {
+                batch_mean[j] += X_batch[i][j];
+            }
+        }
+        for (size_t j = 0; j < d; j++) {
+            batch_mean[j] /= b;
+        }
+        vector<double> batch_deviations(d, 0.0);
+        for (size_t i = 0; i < b; i++) {
+            for (size_t j = 0; j < d; j++) {
+                double diff = X_batch[i][j] - batch_mean[j];
+                batch_deviations[j] += diff * diff;
+            }
+        }
+
+        // 2. Stack the previous components with the centered batch
+        vector<vector<double> > M;
+        M.reserve(this->components_.size() + b + 1);
+        for (size_t c = 0; c < this->components_.size(); c++) {
+            vector<double> row(d);
+            for (size_t j = 0; j < d; j++) {
+                row[j] = this->singular_values_[c] * this->components_[c][j];
+            }
+            M.push_back(row);
+        }
+        for (size_t i = 0; i < b; i++) {
+            vector<double> row(d);
+            for (size_t j = 0; j < d; j++) {
+                row[j] = X_batch[i][j] - batch_mean[j];
+            }
+            M.push_back(row);
+        }
+
+        // 3. Merge the running statistics (Chan et al.) and add the mean-shift row
+        double n_old = static_cast<double>(this->n_samples_seen_);
+        double n_total = n_old + b;
+        if (this->n_samples_seen_ == 0) {
+            this->mean_ = batch_mean;
+            this->squared_deviations_ = batch_deviations;
+        } else {
+            double correction = sqrt(n_old * b / n_total);
+            vector<double> shift_row(d);
+            for (size_t j = 0; j < d; j++) {
+                double delta = batch_mean[j] - this->mean_[j];
+                shift_row[j] = correction * (this->mean_[j] - batch_mean[j]);
+                this->squared_deviations_[j] += batch_deviations[j] + delta * delta * n_old * b / n_total;
+                this->mean_[j] += delta * b / n_total;
+            }
+            M.push_back(shift_row);
+        }
+        this->n_samples_seen_ += b;
+
+        set_components_from_rows(M);
+    }
+
+    void PCA::set_components_from_rows(const vector<vector<double> > &M) {
+        size_t r = M.size();
+        size_t d = M[0].size();
+
+        // 1. Gram matrix of the rows [r][r]
+        vector<vector<double> > G(r, vector<double>(r, 0.0));
+        parallel_for(r, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                for (size_t k = 0; k <= i; k++) {
+                    double dot = 0.0;
+                    for (size_t j = 0; j < d; j++) {
+                        dot += M[i][j] * M[k][j];
+                    }
+                    G[i][k] = dot;
+                }
+            }
+        }, 1);
+        for (size_t i = 0; i < r; i++) {
+            for (size_t k = i + 1; k < r; k++) {
+                G[i][k] = G[k][i];
+            }
+        }
+
+        // 2. Right singular vectors: v_i = M^T * u_i / sigma_i
+        auto [values, vectors] = LinearAlgebra::symmetric_eigen(G);
+        size_t k = min(static_cast<size_t>(this->n_components_), min(r, d));
+        this->components_.assign(k, vector<double>(d, 0.0));
+        this->singular_values_.assign(k, 0.0);
+        for (size_t c = 0; c < k; c++) {
+            double sigma = sqrt(max(values[c], 0.0));
+            this->singular_values_[c] = sigma;
+            if (sigma <= 1e-12) {
+                continue;
+            }
+            for (size_t i = 0; i < r; i++) {
+                double weight = vectors[c][i] / sigma;
+                if (weight == 0.0) {
+                    continue;
+                }
+                for (size_t j = 0; j < d; j++) {
+                    this->components_[c][j] += weight * M[i][j];
+                }
+            }
+
+            // Deterministic sign: largest absolute loading is positive
+            size_t largest = 0;
+            for (size_t j = 1; j < d; j++) {
+                if (abs(this->components_[c][j]) > abs(this->components_[c][largest])) {
+                    largest = j;
+                }
+            }
+            if (this->components_[c][largest] < 0) {
+                for (size_t j = 0; j < d; j++) {
+                    this->components_[c][j] = -this->components_[c][j];
+                }
+            }
+        }
+    }
+
+    vector<double> PCA::transform(const vector<double> &sample) const {
+        if (sample.size() != this->mean_.size()) {
+            throw invalid_argument("Sample has a different number of features than the fitted data.");
+        }
+        vector<double> projected(this->components_.size(), 0.0);
+        for (size_t c = 0; c < this->components_.size(); c++) {
+            double dot = 0.0;
+            for (size_t j = 0; j < sample.size(); j++) {
+                dot += (sample[j] - this->mean_[j]) * this->components_[c][j];
+            }
+            projected[c] = dot;
+        }
+        return projected;
+    }
+
+    vector<vector<double> > PCA::transform(const vector<vector<double> > &X) const {
+        if (X.empty()) {
+            return {};
+        }
+        size_t d = this->mean_.size();
+        size_t k = this->components_.size();
+        if (X[0].size() != d) {
+            throw invalid_argument("Sample has a different number of features than the fitted data.");
+        }
+
+        // Xc * V^T as one blocked product, with the centering folded into an offset
+        vector<vector<double> > Vt(d, vector<double>(k));
+        vector<double> offset(k, 0.0);
+        for (size_t c = 0; c < k; c++) {
+            for (size_t j = 0; j < d; j++) {
+                Vt[j][c] = this->components_[c][j];
+                offset[c] += this->mean_[j] * this->components_[c][j];
+            }
+        }
+        vector<vector<double> > projected = LinearAlgebra::matmul(X, Vt);
+        for (auto &row: projected) {
+            for (size_t c = 0; c < k; c++) {
+                row[c] -= offset[c];
+            }
+        }
+        return projected;
+    }
+
+    Dataset PCA::transform(const Dataset &dataset) const {
+        return Dataset(transform(dataset.get_features()), dataset.get_labels());
+    }
+
+    Dataset PCA::fit_transform(const Dataset &dataset) {
+        fit(dataset);
+        return transform(dataset);
+    }
+
+    vector<double> PCA::get_explained_variance() const {
+        vector<double> variance(this->singular_values_.size(), 0.0);
+        if (this->n_samples_seen_ < 2) {
+            return variance;
+        }
+        for (size_t c = 0; c < variance.size(); c++) {
+            variance[c] = this->singular_values_[c] * this->singular_values_[c] / (this->n_samples_seen_ - 1);
+        }
+        return variance;
+    }
+
+    vector<double> PCA::get_explained_variance_ratio() const {
+        vector<double> ratio = get_explained_variance();
+        double total = 0.0;
+        for (double deviation: this->squared_deviations_) {
+            total += deviation;
+        }
+        if (this->n_samples_seen_ < 2 || total <= 0.0) {
+            return ratio;
+        }
+        total /= (this->n_samples_seen_ - 1);
+        for (double &value: ratio) {
+            value /= total;
+        }
+        return ratio;
+    }
+}
@@ -0,0 +1,140 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/preprocessing/SparseRandomProjection.h"
+#include "../../include/core/Parallel.h"
+#include "../../include/core/Random.h"
+
+#include <cmath>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    // Rows transformed per regeneration of the projection matrix
+    static constexpr size_t ROW_BLOCK = 256;
+
+    SparseRandomProjection::SparseRandomProjection(int n_components, double density, double eps, int seed) {
+        this->requested_components_ = n_components;
+        this->requested_density_ = density;
+        this->eps_ = eps;
+        this->seed_ = seed;
+    }
+
+    int SparseRandomProjection::johnson_lindenstrauss_min_dim(size_t n_samples, double eps) {
+        if (eps <= 0.0 || eps >= 1.0) {
+            throw invalid_argument("eps must be between 0 and 1.");
+        }
+        double denominator = eps * eps / 2.0 - eps * eps * eps / 3.0;
+        return static_cast<int>(ceil(4.0 * log(static_cast<double>(max<size_t>(n_samples, 2))) / denominator));
+    }
+
+    void SparseRandomProjection::fit(const Dataset &dataset) {
+        fit(dataset.get_features());
+    }
+
+    void SparseRandomProjection::fit(const vector<vector<double> > &X) {
+        if (X.empty() || X[0].empty()) {
+            throw invalid_argument("SparseRandomProjection requires non-empty data.");
+        }
+        size_t n_features = X[0].size();
+        int n_components = this->requested_components_;
+        if (n_components <= 0) {
+            // The JL bound only depends on n and eps: refuse to project into more dimensions than the input has
+            n_components = johnson_lindenstrauss_min_dim(X.size(), this->eps_);
+            if (static_cast<size_t>(n_components) > n_features) {
+                throw invalid_argument("eps = " + to_string(this->eps_) + " requires " + to_string(n_components) +
+                                       " components for " + to_string(X.size()) + " samples, more than the " +
+                                       to_string(n_features) + " input features; raise eps or set n_components.");
+            }
+        }
+        this->n_features_ = n_features;
+        this->n_components_ = n_components;
+        this->density_ = this->requested_density_ > 0.0
+                             ? this->requested_density_
+                             : 1.0 / sqrt(static_cast<double>(this->n_features_));
+        if (this->density_ > 1.0) {
+            throw invalid_argument("density must be in (0, 1].");
+        }
+    }
+
+    void SparseRandomProjection::feature_entries(size_t feature, vector<pair<size_t, double> > &entries) const {
+        entries.clear();
+        size_t k = static_cast<size_t>(this->n_components_);
+        double value = sqrt(1.0 / (this->density_ * k));
+
+        // Each feature owns an independent stream derived from the seed
+        CounterRng rng(CounterRng::at(static_cast<uint64_t>(this->seed_), feature));
+        if (this->density_ >= 1.0) {
+            for (size_t c = 0; c < k; c++) {
+                entries.push_back({c, (rng.next() & 1) ? value : -value});
+            }
+            return;
+        }
+
+        // Gaps between non-zeros are geometric with success probability = density
+        double log_q = log1p(-this->density_);
+        size_t c = 0;
+        while (true) {
+            double gap = floor(log1p(-rng.uniform()) / log_q);
+            if (gap >= static_cast<double>(k - c)) {
+                break;
+            }
+            c += static_cast<size_t>(gap);
+            entries.push_back({c, (rng.next() & 1) ? value : -value});
+            c++;
+            if (c >= k) {
+                break;
+            }
+        }
+    }
+
+    vector<double> SparseRandomProjection::transform(const vector<double> &sample) const {
+        return transform(vector<vector<double> >{sample})[0];
+    }
+
+    vector<vector<double> > SparseRandomProjection::transform(const vector<vector<double> > &X) const {
+        if (this->n_components_ <= 0) {
+            throw logic_error("SparseRandomProjection must be fitted before transform.");
+        }
+        size_t n = X.size();
+        if (n > 0 && X[0].size() != this->n_features_) {
+            throw invalid_argument("Sample has a different number of features than the fitted data.");
+        }
+
+        vector<vector<double> > projected(n, vector<double>(this->n_components_, 0.0));
+        parallel_for(n, [&](size_t begin, size_t end, size_t) {
+            vector<pair<size_t, double> > entries;
+            for (size_t block = begin; block < end; block += ROW_BLOCK) {
+                size_t block_end = min(end, block + ROW_BLOCK);
+                // Regenerate one row of the projection at a time and apply it to the whole block
+                for (size_t j = 0; j < this->n_features_; j++) {
+                    feature_entries(j, entries);
+                    if (entries.empty()) {
+                        continue;
+                    }
+                    for (size_t i = block; i < block_end; i++) {
+                        double x = X[i][j];
+                        if (x == 0.0) {
+                            continue;
+                        }
+                        double *out = projected[i].data();
+                        for (const auto &[c, value]: entries) {
+                            out[c] += x * value;
+                        }
+                    }
+                }
+            }
+        }, ROW_BLOCK);
+        return projected;
+    }
+
+    Dataset SparseRandomProjection::transform(const Dataset &dataset) const {
+        return Dataset(transform(dataset.get_features()), dataset.get_labels());
+    }
+
+    Dataset SparseRandomProjection::fit_transform(const Dataset &dataset) {
+        fit(dataset);
+        return transform(dataset);
+    }
+}
@@ -0,0 +1,112 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/preprocessing/StandardScaler.h"
+#include "../../include/core/Parallel.h"
+
+#include <cmath>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    void StandardScaler::fit(const Dataset &dataset) {
+        fit(dataset.get_features());
+    }
+
+    void StandardScaler::fit(const vector<vector<double> > &X) {
+        if (X.size() < 2) {
+            throw invalid_argument("StandardScaler requires at least 2 samples.");
+        }
+        size_t d = X[0].size();
+        for (const vector<double> &row: X) {
+            if (row.size() != d) {
+                throw invalid_argument("All samples must have the same number of features.");
+            }
+        }
+
+        // 1. One pass: per-thread count, mean and sum of squared deviations (Welford)
+        struct Moments {
+            double count = 0.0;
+            vector<double> mean;
+            vector<double> m2;
+        };
+        vector<Moments> partials(num_threads());
+        parallel_for(X.size(), [&](size_t begin, size_t end, size_t chunk) {
+            Moments &m = partials[chunk];
+            m.mean.assign(d, 0.0);
+            m.m2.assign(d, 0.0);
+            for (size_t i = begin; i < end; i++) {
+                m.count += 1.0;
+                for (size_t j = 0; j < d; j++) {
+                    double delta = X[i][j] - m.mean[j];
+                    m.mean[j] += delta / m.count;
+                    m.m2[j] += delta * (X[i][j] - m.mean[j]);
+                }
+            }
+        });
+
+        // 2. Merge the partial moments (Chan et al.)
+        Moments total;
+        total.mean.assign(d, 0.0);
+        total.m2.assign(d, 0.0);
+        for (const Moments &m: partials) {
+            if (m.count == 0.0) {
+                continue;
+            }
+            double n = total.count + m.count;
+            for (size_t j = 0; j < d; j++) {
+                double delta = m.mean[j] - total.mean[j];
+                total.m2[j] += m.m2[j] + delta * delta * total.count * m.count / n;
+                total.mean[j] += delta * m.count / n;
+            }
+            total.count = n;
+        }
+
+        // 3. Sample standard deviation; constant features keep scale 1
+        this->mean_ = total.mean;
+        this->scale_.assign(d, 1.0);
+        for (size_t j = 0; j < d; j++) {
+            double std_dev = sqrt(total.m2[j] / (total.count - 1.0));
+            if (std_dev > 0.0) {
+                this->scale_[j] = std_dev;
+            }
+        }
+    }
+
+    vector<double> StandardScaler::transform(const vector<double> &sample) const {
+        if (this->scale_.empty()) {
+            throw logic_error("StandardScaler must be fitted before transform.");
+        }
+        if (sample.size() != this->mean_.size()) {
+            throw invalid_argument("Sample must have the same number of features as the training data.");
+        }
+        vector<double> scaled(sample.size());
+        for (size_t j = 0; j < sample.size(); j++) {
+            scaled[j] = (sample[j] - this->mean_[j]) / this->scale_[j];
+        }
+        return scaled;
+    }
+
+    vector<vector<double> > StandardScaler::transform(const vector<vector<double> > &X) const {
+        if (this->scale_.empty()) {
+            throw logic_error("StandardScaler must be fitted before transform.");
+        }
+        for (const vector<double> &row: X) {
+            if (row.size() != this->mean_.size()) {
+                throw invalid_argument("Sample must have the same number of features as the training data.");
+            }
+        }
+        vector<vector<double> > scaled(X.size());
+        parallel_for(X.size(), [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                scaled[i] = transform(X[i]);
+            }
+        }, 64);
+        return scaled;
+    }
+
+    Dataset StandardScaler::transform(const Dataset &dataset) const {
+        return Dataset(transform(dataset.get_features()), dataset.get_labels());
+    }
+}
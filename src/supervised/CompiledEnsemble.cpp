@@ -0,0 +1,474 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/supervised/CompiledEnsemble.h"
+#include "../../include/core/Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+namespace mlcpp {
+    // Rows evaluated together, level by level, through each tree
+    static constexpr size_t PREDICT_BLOCK = 128;
+    // Trees walked together by the single-sample path
+    static constexpr size_t TREE_BLOCK = 16;
+    // Longest root-to-leaf path accepted when compiling or loading
+    static constexpr int32_t MAX_DEPTH = 64;
+    static constexpr char MAGIC[8] = {'M', 'L', 'C', 'P', 'P', 'E', 'N', 'S'};
+    static constexpr uint32_t VERSION = 1;
+
+    /**
+     * @brief Fixed-size header at the start of the buffer and of saved files.
+     */
+    struct EnsembleHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t transform;
+        uint64_t n_trees;
+        uint64_t n_nodes;
+        uint64_t n_leaf_values;
+        uint64_t n_outputs;
+        uint64_t n_features;
+        double scale;
+    };
+
+    /**
+     * @brief Byte offsets of the arrays following the header (each aligned to 8 bytes).
+     */
+    struct EnsembleLayout {
+        size_t base_scores;
+        size_t thresholds;
+        size_t leaf_values;
+        size_t roots;
+        size_t depths;
+        size_t output_offsets;
+        size_t widths;
+        size_t features;
+        size_t children;
+        size_t leaves;
+        size_t total;
+    };
+
+    static size_t align8(size_t bytes) {
+        return (bytes + 7) & ~static_cast<size_t>(7);
+    }
+
+    static EnsembleLayout layout_of(const EnsembleHeader &header) {
+        EnsembleLayout layout{};
+        size_t offset = align8(sizeof(EnsembleHeader));
+        auto take = [&](size_t bytes) {
+            size_t start = offset;
+            offset += align8(bytes);
+            return start;
+        };
+        layout.base_scores = take(header.n_outputs * sizeof(double));
+        layout.thresholds = take(header.n_nodes * sizeof(double));
+        layout.leaf_values = take(header.n_leaf_values * sizeof(double));
+        layout.roots = take(header.n_trees * sizeof(int32_t));
+        layout.depths = take(header.n_trees * sizeof(int32_t));
+        layout.output_offsets = take(header.n_trees * sizeof(int32_t));
+        layout.widths = take(header.n_trees * sizeof(int32_t));
+        layout.features = take(header.n_nodes * sizeof(int32_t));
+        layout.children = take(header.n_nodes * sizeof(int32_t));
+        layout.leaves = take(header.n_nodes * sizeof(int32_t));
+        layout.total = offset;
+        return layout;
+    }
+
+    CompiledEnsemble CompiledEnsemble::compile(const vector<FlatTree> &trees, int n_outputs,
+                                               const vector<double> &base_scores, double scale,
+                                               EnsembleTransform transform) {
+        if (n_outputs < 1) {
+            throw invalid_argument("n_outputs must be at least 1.");
+        }
+        if (!base_scores.empty() && base_scores.size() != static_cast<size_t>(n_outputs)) {
+            throw invalid_argument("base_scores must be empty or have n_outputs values.");
+        }
+
+        // 1. Flatten every tree into the shared node arrays
+        vector<double> thresholds;
+        vector<double> leaf_values;
+        vector<int32_t> roots;
+        vector<int32_t> depths;
+        vector<int32_t> output_offsets;
+        vector<int32_t> widths;
+        vector<int32_t> features;
+        vector<int32_t> children;
+        vector<int32_t> leaves;
+        size_t n_features = 0;
+        for (size_t t = 0; t < trees.size(); t++) {
+            const FlatTree &tree = trees[t];
+            if (tree.nodes.empty() || tree.n_outputs < 1 || n_outputs % tree.n_outputs != 0) {
+                throw invalid_argument("Tree outputs do not fit the ensemble outputs.");
+            }
+            if (tree.depth() > MAX_DEPTH) {
+                throw invalid_argument("Trees deeper than " + to_string(MAX_DEPTH) + " levels cannot be compiled.");
+            }
+            int32_t root = static_cast<int32_t>(thresholds.size());
+            int32_t leaf_base = static_cast<int32_t>(leaf_values.size());
+            int groups = n_outputs / tree.n_outputs;
+            roots.push_back(root);
+            depths.push_back(tree.depth());
+            output_offsets.push_back(static_cast<int32_t>((t % groups) * tree.n_outputs));
+            widths.push_back(tree.n_outputs);
+            for (size_t i = 0; i < tree.nodes.size(); i++) {
+                const TreeNode &node = tree.nodes[i];
+                int32_t self = root + static_cast<int32_t>(i);
+                if (node.feature >= 0) {
+                    thresholds.push_back(node.threshold);
+                    features.push_back(node.feature);
+                    children.push_back(root + node.left);
+                    leaves.push_back(leaf_base);
+                    n_features = max(n_features, static_cast<size_t>(node.feature) + 1);
+                } else {
+                    // x <= NaN is always false, so the step lands on (self - 1) + 1
+                    thresholds.push_back(numeric_limits<double>::quiet_NaN());
+                    features.push_back(0);
+                    children.push_back(self - 1);
+                    leaves.push_back(leaf_base + node.leaf * tree.n_outputs);
+                }
+            }
+            leaf_values.insert(leaf_values.end(), tree.leaf_values.begin(), tree.leaf_values.end());
+        }
+
+        // 2. Write the header and arrays into one aligned buffer (the file format)
+        EnsembleHeader header{};
+        memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.transform = static_cast<uint32_t>(transform);
+        header.n_trees = trees.size();
+        header.n_nodes = thresholds.size();
+        header.n_leaf_values = leaf_values.size();
+        header.n_outputs = static_cast<uint64_t>(n_outputs);
+        header.n_features = n_features;
+        header.scale = scale;
+        EnsembleLayout layout = layout_of(header);
+
+        auto buffer = make_shared<vector<uint64_t> >(layout.total / sizeof(uint64_t), 0);
+        char *bytes = reinterpret_cast<char *>(buffer->data());
+        vector<double> bases = base_scores.empty() ? vector<double>(n_outputs, 0.0) : base_scores;
+        memcpy(bytes, &header, sizeof(header));
+        memcpy(bytes + layout.base_scores, bases.data(), bases.size() * sizeof(double));
+        memcpy(bytes + layout.thresholds, thresholds.data(), thresholds.size() * sizeof(double));
+        memcpy(bytes + layout.leaf_values, leaf_values.data(), leaf_values.size() * sizeof(double));
+        memcpy(bytes + layout.roots, roots.data(), roots.size() * sizeof(int32_t));
+        memcpy(bytes + layout.depths, depths.data(), depths.size() * sizeof(int32_t));
+        memcpy(bytes + layout.output_offsets, output_offsets.data(), output_offsets.size() * sizeof(int32_t));
+        memcpy(bytes + layout.widths, widths.data(), widths.size() * sizeof(int32_t));
+        memcpy(bytes + layout.features, features.data(), features.size() * sizeof(int32_t));
+        memcpy(bytes + layout.children, children.data(), children.size() * sizeof(int32_t));
+        memcpy(bytes + layout.leaves, leaves.data(), leaves.size() * sizeof(int32_t));
+
+        CompiledEnsemble ensemble;
+        if (!ensemble.attach(shared_ptr<const void>(buffer, buffer->data()), layout.total)) {
+            throw invalid_argument("Trees could not be compiled into a valid ensemble.");
+        }
+        return ensemble;
+    }
+
+    CompiledEnsemble CompiledEnsemble::compile(const DecisionTree &tree) {
+        const FlatTree &flat = tree.get_tree();
+        return compile({flat}, flat.n_outputs, {}, 1.0, EnsembleTransform::Identity);
+    }
+
+    CompiledEnsemble CompiledEnsemble::compile(const RandomForest &forest) {
+        const vector<FlatTree> &trees = forest.get_trees();
+        if (trees.empty()) {
+            return CompiledEnsemble();
+        }
+        return compile(trees, trees[0].n_outputs, {}, 1.0 / trees.size(), EnsembleTransform::Identity);
+    }
+
+    CompiledEnsemble CompiledEnsemble::compile(const GradientBoosting &model) {
+        EnsembleTransform transform = EnsembleTransform::Identity;
+        if (model.get_loss() == BoostingLoss::Logistic) {
+            transform = EnsembleTransform::Sigmoid;
+        } else if (model.get_loss() == BoostingLoss::Softmax) {
+            transform = EnsembleTransform::Softmax;
+        }
+        return compile(model.get_trees(), model.get_num_outputs(), model.get_base_scores(), 1.0, transform);
+    }
+
+    bool CompiledEnsemble::attach(shared_ptr<const void> storage, size_t size_bytes) {
+        // 1. Header and total size
+        if (size_bytes < sizeof(EnsembleHeader)) {
+            return false;
+        }
+        const char *bytes = static_cast<const char *>(storage.get());
+        EnsembleHeader header;
+        memcpy(&header, bytes, sizeof(header));
+        if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION ||
+            header.transform > static_cast<uint32_t>(EnsembleTransform::Softmax) ||
+            header.n_nodes > static_cast<uint64_t>(numeric_limits<int32_t>::max()) ||
+            header.n_leaf_values > static_cast<uint64_t>(numeric_limits<int32_t>::max()) ||
+            header.n_trees > header.n_nodes || header.n_outputs == 0 ||
+            header.n_outputs > static_cast<uint64_t>(numeric_limits<int32_t>::max())) {
+            return false;
+        }
+        EnsembleLayout layout = layout_of(header);
+        if (layout.total != size_bytes) {
+            return false;
+        }
+        auto roots = reinterpret_cast<const int32_t *>(bytes + layout.roots);
+        auto depths = reinterpret_cast<const int32_t *>(bytes + layout.depths);
+        auto output_offsets = reinterpret_cast<const int32_t *>(bytes + layout.output_offsets);
+        auto widths = reinterpret_cast<const int32_t *>(bytes + layout.widths);
+        auto features = reinterpret_cast<const int32_t *>(bytes + layout.features);
+        auto children = reinterpret_cast<const int32_t *>(bytes + layout.children);
+        auto leaves = reinterpret_cast<const int32_t *>(bytes + layout.leaves);
+        auto thresholds = reinterpret_cast<const double *>(bytes + layout.thresholds);
+
+        // 2. Every index reachable during traversal must stay inside its tree and arrays
+        int64_t n_nodes = static_cast<int64_t>(header.n_nodes);
+        int64_t n_leaf_values = static_cast<int64_t>(header.n_leaf_values);
+        int64_t n_outputs = static_cast<int64_t>(header.n_outputs);
+        for (size_t t = 0; t < header.n_trees; t++) {
+            int64_t begin = roots[t];
+            int64_t end = t + 1 < header.n_trees ? roots[t + 1] : n_nodes;
+            int64_t width = widths[t];
+            if ((t == 0 && begin != 0) || begin >= end || end > n_nodes || depths[t] < 0 || depths[t] > MAX_DEPTH || width < 1 ||
+                output_offsets[t] < 0 || output_offsets[t] + width > n_outputs) {
+                return false;
+            }
+            for (int64_t node = begin; node < end; node++) {
+                bool leaf = std::isnan(thresholds[node]);
+                int64_t low = leaf ? static_cast<int64_t>(children[node]) + 1 : children[node];
+                if (low < begin || static_cast<int64_t>(children[node]) + 1 >= end ||
+                    features[node] < 0 || (depths[t] > 0 && static_cast<uint64_t>(features[node]) >=
+                                                            max<uint64_t>(header.n_features, 1)) ||
+                    leaves[node] < 0 || leaves[node] + width > n_leaf_values) {
+                    return false;
+                }
+            }
+        }
+        if (header.n_features == 0) {
+            for (size_t t = 0; t < header.n_trees; t++) {
+                if (depths[t] != 0) {
+                    return false;
+                }
+            }
+        }
+
+        // 3. Point the arrays into the buffer
+        this->storage_ = move(storage);
+        this->size_bytes_ = size_bytes;
+        this->n_trees_ = header.n_trees;
+        this->n_outputs_ = header.n_outputs;
+        this->n_features_ = header.n_features;
+        this->transform_ = static_cast<EnsembleTransform>(header.transform);
+        this->scale_ = header.scale;
+        this->base_scores_ = reinterpret_cast<const double *>(bytes + layout.base_scores);
+        this->thresholds_ = thresholds;
+        this->leaf_values_ = reinterpret_cast<const double *>(bytes + layout.leaf_values);
+        this->roots_ = roots;
+        this->depths_ = depths;
+        this->output_offsets_ = output_offsets;
+        this->widths_ = widths;
+        this->features_ = features;
+        this->children_ = children;
+        this->leaves_ = leaves;
+        return true;
+    }
+
+    void CompiledEnsemble::finish(double *outputs) const {
+        if (this->transform_ == EnsembleTransform::Sigmoid) {
+            outputs[0] = 1.0 / (1.0 + exp(-outputs[0]));
+        } else if (this->transform_ == EnsembleTransform::Softmax) {
+            double max_score = *max_element(outputs, outputs + this->n_outputs_);
+            double sum = 0.0;
+            for (size_t k = 0; k < this->n_outputs_; k++) {
+                outputs[k] = exp(outputs[k] - max_score);
+                sum += outputs[k];
+            }
+            for (size_t k = 0; k < this->n_outputs_; k++) {
+                outputs[k] /= sum;
+            }
+        }
+    }
+
+    void CompiledEnsemble::predict(const double *sample, double *outputs) const {
+        fill(outputs, outputs + this->n_outputs_, 0.0);
+        int32_t nodes[TREE_BLOCK];
+        size_t active[TREE_BLOCK];
+        // Several trees at once: their paths are independent, so the loads overlap
+        for (size_t first = 0; first < this->n_trees_; first += TREE_BLOCK) {
+            size_t count = min(TREE_BLOCK, this->n_trees_ - first);
+            size_t n_active = 0;
+            int32_t block_depth = 0;
+            for (size_t j = 0; j < count; j++) {
+                nodes[j] = this->roots_[first + j];
+                active[n_active] = j;
+                n_active += !is_leaf(nodes[j]);
+                block_depth = max(block_depth, this->depths_[first + j]);
+            }
+            for (int32_t level = 0; n_active > 0 && level < block_depth; level++) {
+                // Branchless step, then compact the trees that have not reached a leaf
+                size_t still_active = 0;
+                for (size_t a = 0; a < n_active; a++) {
+                    size_t j = active[a];
+                    int32_t node = nodes[j];
+                    int32_t next = this->children_[node] + !(sample[this->features_[node]] <= this->thresholds_[node]);
+                    nodes[j] = next;
+                    active[still_active] = j;
+                    still_active += !is_leaf(next);
+                }
+                n_active = still_active;
+            }
+            for (size_t j = 0; j < count; j++) {
+                size_t t = first + j;
+                const double *leaf = this->leaf_values_ + this->leaves_[nodes[j]];
+                double *out = outputs + this->output_offsets_[t];
+                for (int32_t o = 0; o < this->widths_[t]; o++) {
+                    out[o] += leaf[o];
+                }
+            }
+        }
+        for (size_t k = 0; k < this->n_outputs_; k++) {
+            outputs[k] = this->base_scores_[k] + this->scale_ * outputs[k];
+        }
+        finish(outputs);
+    }
+
+    vector<double> CompiledEnsemble::predict(const vector<double> &sample) const {
+        if (sample.size() < this->n_features_) {
+            throw invalid_argument("Sample has fewer features than the ensemble reads.");
+        }
+        vector<double> outputs(this->n_outputs_);
+        predict(sample.data(), outputs.data());
+        return outputs;
+    }
+
+    vector<double> CompiledEnsemble::predict(const vector<vector<double> > &X) const {
+        size_t d = this->n_features_;
+        size_t K = this->n_outputs_;
+        for (const vector<double> &sample: X) {
+            if (sample.size() < d) {
+                throw invalid_argument("Sample has fewer features than the ensemble reads.");
+            }
+        }
+        vector<double> outputs(X.size() * K, 0.0);
+
+        size_t n_blocks = (X.size() + PREDICT_BLOCK - 1) / PREDICT_BLOCK;
+        parallel_for(n_blocks, [&](size_t block_begin, size_t block_end, size_t) {
+            vector<double> rows(PREDICT_BLOCK * d);
+            int32_t nodes[PREDICT_BLOCK];
+            size_t active[PREDICT_BLOCK];
+            for (size_t block = block_begin; block < block_end; block++) {
+                size_t begin = block * PREDICT_BLOCK;
+                size_t count = min(X.size(), begin + PREDICT_BLOCK) - begin;
+                // 1. Gather the block into a contiguous row-major buffer
+                for (size_t i = 0; i < count; i++) {
+                    copy(X[begin + i].begin(), X[begin + i].begin() + d, rows.begin() + i * d);
+                }
+                double *out = outputs.data() + begin * K;
+
+                // 2. Each tree, level by level across the rows of the block still inside it
+                for (size_t t = 0; t < this->n_trees_; t++) {
+                    size_t n_active = 0;
+                    for (size_t i = 0; i < count; i++) {
+                        nodes[i] = this->roots_[t];
+                        active[n_active] = i;
+                        n_active += !is_leaf(nodes[i]);
+                    }
+                    for (int32_t level = 0; n_active > 0 && level < this->depths_[t]; level++) {
+                        size_t still_active = 0;
+                        for (size_t a = 0; a < n_active; a++) {
+                            size_t i = active[a];
+                            int32_t node = nodes[i];
+                            int32_t next = this->children_[node] +
+                                           !(rows[i * d + this->features_[node]] <= this->thresholds_[node]);
+                            nodes[i] = next;
+                            active[still_active] = i;
+                            still_active += !is_leaf(next);
+                        }
+                        n_active = still_active;
+                    }
+                    size_t offset = static_cast<size_t>(this->output_offsets_[t]);
+                    for (size_t i = 0; i < count; i++) {
+                        const double *leaf = this->leaf_values_ + this->leaves_[nodes[i]];
+                        for (int32_t o = 0; o < this->widths_[t]; o++) {
+                            out[i * K + offset + o] += leaf[o];
+                        }
+                    }
+                }
+
+                // 3. Base scores, scaling and output transform
+                for (size_t i = 0; i < count; i++) {
+                    for (size_t k = 0; k < K; k++) {
+                        out[i * K + k] = this->base_scores_[k] + this->scale_ * out[i * K + k];
+                    }
+                    finish(out + i * K);
+                }
+            }
+        }, 1);
+        return outputs;
+    }
+
+    bool CompiledEnsemble::save(const string &path) const {
+        if (!this->storage_) {
+            return false;
+        }
+        ofstream file(path, ios::binary | ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(static_cast<const char *>(this->storage_.get()), static_cast<streamsize>(this->size_bytes_));
+        return static_cast<bool>(file);
+    }
+
+    optional<CompiledEnsemble> CompiledEnsemble::load(const string &path) {
+        CompiledEnsemble ensemble;
+#if !defined(_WIN32)
+        // Memory-map the file read-only; the mapping lives as long as any copy of the ensemble
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return {};
+        }
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || info.st_size <= 0) {
+            close(fd);
+            return {};
+        }
+        size_t size = static_cast<size_t>(info.st_size);
+        void *address = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (address != MAP_FAILED) {
+            shared_ptr<const void> mapping(address, [size](const void *p) {
+                munmap(const_cast<void *>(p), size);
+            });
+            if (!ensemble.attach(move(mapping), size)) {
+                return {};
+            }
+            return ensemble;
+        }
+#endif
+        // Fallback: read the file into an aligned buffer
+        ifstream file(path, ios::binary | ios::ate);
+        if (!file.is_open()) {
+            return {};
+        }
+        size_t file_size = static_cast<size_t>(file.tellg());
+        auto buffer = make_shared<vector<uint64_t> >((file_size + 7) / 8, 0);
+        file.seekg(0);
+        if (!file.read(reinterpret_cast<char *>(buffer->data()), static_cast<streamsize>(file_size))) {
+            return {};
+        }
+        if (!ensemble.attach(shared_ptr<const void>(buffer, buffer->data()), file_size)) {
+            return {};
+        }
+        return ensemble;
+    }
+}
@@ -0,0 +1,340 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/supervised/DecisionTree.h"
+#include "../../include/core/Parallel.h"
+#include "../../include/core/Random.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    // Histograms always reserve 256 bins per feature so offsets do not depend on the feature
+    static constexpr size_t HIST_BINS = 256;
+    // Below this many (row, feature) cells a histogram is built on the calling thread
+    static constexpr size_t PARALLEL_CELLS = 1 << 16;
+    // Splits must improve the criterion by more than this
+    static constexpr double MIN_GAIN = 1e-12;
+
+    int FlatTree::depth() const {
+        if (this->nodes.empty()) {
+            return 0;
+        }
+        // Nodes are created parent-first, so a forward pass propagates depths
+        vector<int> depths(this->nodes.size(), 0);
+        int max_depth = 0;
+        for (size_t i = 0; i < this->nodes.size(); i++) {
+            const TreeNode &node = this->nodes[i];
+            max_depth = max(max_depth, depths[i]);
+            if (node.feature >= 0) {
+                depths[node.left] = depths[i] + 1;
+                depths[node.left + 1] = depths[i] + 1;
+            }
+        }
+        return max_depth;
+    }
+
+    DecisionTree::DecisionTree(int max_depth, int min_samples_leaf, int max_bins) {
+        this->max_depth_ = max_depth;
+        this->min_samples_leaf_ = max(min_samples_leaf, 1);
+        this->max_bins_ = max_bins;
+    }
+
+    TreeGrowOptions DecisionTree::grow_options() const {
+        TreeGrowOptions options;
+        options.max_depth = this->max_depth_;
+        options.min_samples_leaf = this->min_samples_leaf_;
+        return options;
+    }
+
+    FlatTree DecisionTree::grow(const BinnedDataset &data, const vector<double> &targets, int n_classes,
+                                const TreeGrowOptions &options) {
+        size_t n = data.size();
+        size_t d = data.num_features();
+        bool classification = n_classes > 0;
+        // Per bin: one statistic per class (or the target sum), then the sample weight
+        size_t n_stats = classification ? static_cast<size_t>(n_classes) : 1;
+        size_t stride = n_stats + 1;
+        size_t feature_size = HIST_BINS * stride;
+        double min_leaf = max(options.min_samples_leaf, 1);
+        const vector<uint32_t> *weights = options.sample_weights;
+
+        // Per-node feature sampling; subtraction needs every feature in every histogram
+        size_t sampled = options.max_features > 0 ? min(d, static_cast<size_t>(options.max_features)) : d;
+        bool subtraction = 2 * sampled >= d;
+        CounterRng rng(options.seed);
+        vector<uint32_t> all_features(d);
+        iota(all_features.begin(), all_features.end(), 0);
+        auto sample_features = [&]() {
+            vector<uint32_t> features = all_features;
+            if (sampled == d) {
+                return features;
+            }
+            // Partial Fisher-Yates shuffle
+            for (size_t i = 0; i < sampled; i++) {
+                swap(features[i], features[i + rng.uniform_index(d - i)]);
+            }
+            features.resize(sampled);
+            return features;
+        };
+
+        FlatTree tree;
+        tree.n_outputs = static_cast<int>(n_stats);
+
+        // Samples with zero weight (e.g. out of the bootstrap) are never scanned
+        vector<uint32_t> rows;
+        rows.reserve(n);
+        for (uint32_t r = 0; r < n; r++) {
+            if (weights == nullptr || (*weights)[r] > 0) {
+                rows.push_back(r);
+            }
+        }
+
+        // 1. Histogram of the rows [begin, end) for the given features, one slice per feature
+        auto build_histogram = [&](size_t begin, size_t end, const vector<uint32_t> &features,
+                                   vector<double> &hist) {
+            hist.assign(d * feature_size, 0.0);
+            auto fill_features = [&](size_t f_begin, size_t f_end, size_t) {
+                for (size_t fi = f_begin; fi < f_end; fi++) {
+                    size_t f = features[fi];
+                    double *h = hist.data() + f * feature_size;
+                    const uint8_t *column = data.column(f);
+                    for (size_t i = begin; i < end; i++) {
+                        uint32_t r = rows[i];
+                        double w = weights == nullptr ? 1.0 : static_cast<double>((*weights)[r]);
+                        double *cell = h + column[r] * stride;
+                        if (classification) {
+                            cell[static_cast<size_t>(targets[r])] += w;
+                        } else {
+                            cell[0] += w * targets[r];
+                        }
+                        cell[n_stats] += w;
+                    }
+                }
+            };
+            if (!options.parallel || (end - begin) * features.size() < PARALLEL_CELLS) {
+                fill_features(0, features.size(), 0);
+            } else {
+                parallel_for(features.size(), fill_features, 1);
+            }
+        };
+
+        // Criterion: sum(stat²) / weight is the Gini purity (classification) or the
+        // explained sum of squares (regression); a split maximizes left + right - parent
+        auto node_score = [&](const double *stats) {
+            double weight = stats[n_stats];
+            if (weight <= 0.0) {
+                return 0.0;
+            }
+            double sum = 0.0;
+            for (size_t s = 0; s < n_stats; s++) {
+                sum += stats[s] * stats[s];
+            }
+            return sum / weight;
+        };
+
+        struct PendingNode {
+            int index;
+            size_t begin;
+            size_t end;
+            int depth;
+            vector<uint32_t> features;
+            vector<double> hist;
+        };
+        vector<PendingNode> stack;
+        tree.nodes.emplace_back();
+        stack.push_back({0, 0, rows.size(), 0, sample_features(), {}});
+        build_histogram(0, rows.size(), subtraction ? all_features : stack.back().features, stack.back().hist);
+
+        vector<double> totals(stride);
+        vector<double> left(stride);
+        vector<double> right(stride);
+        while (!stack.empty()) {
+            PendingNode pending = move(stack.back());
+            stack.pop_back();
+
+            // 2. Node totals from the histogram of any scanned feature
+            fill(totals.begin(), totals.end(), 0.0);
+            if (!pending.features.empty()) {
+                const double *h = pending.hist.data() + pending.features[0] * feature_size;
+                for (size_t b = 0; b < HIST_BINS; b++) {
+                    for (size_t s = 0; s < stride; s++) {
+                        totals[s] += h[b * stride + s];
+                    }
+                }
+            }
+            double weight = totals[n_stats];
+
+            // 3. Best split: cumulative sums over the bins of every candidate feature
+            int best_feature = -1;
+            int best_bin = 0;
+            double best_gain = MIN_GAIN;
+            bool splittable = pending.depth < options.max_depth && weight >= 2.0 * min_leaf;
+            if (splittable) {
+                double parent_score = node_score(totals.data());
+                for (uint32_t f: pending.features) {
+                    const double *h = pending.hist.data() + f * feature_size;
+                    fill(left.begin(), left.end(), 0.0);
+                    int bins = data.num_bins(f);
+                    for (int b = 0; b + 1 < bins; b++) {
+                        for (size_t s = 0; s < stride; s++) {
+                            left[s] += h[b * stride + s];
+                            right[s] = totals[s] - left[s];
+                        }
+                        if (left[n_stats] < min_leaf) {
+                            continue;
+                        }
+                        if (right[n_stats] < min_leaf) {
+                            break;
+                        }
+                        double gain = node_score(left.data()) + node_score(right.data()) - parent_score;
+                        if (gain > best_gain) {
+                            best_gain = gain;
+                            best_feature = static_cast<int>(f);
+                            best_bin = b;
+                        }
+                    }
+                }
+            }
+
+            // 4. Leaf: store class probabilities or the mean target
+            if (best_feature < 0) {
+                TreeNode &node = tree.nodes[pending.index];
+                node.leaf = static_cast<int>(tree.leaf_values.size() / n_stats);
+                for (size_t s = 0; s < n_stats; s++) {
+                    tree.leaf_values.push_back(weight > 0.0 ? totals[s] / weight : 0.0);
+                }
+                continue;
+            }
+
+            // 5. Split: partition the node's rows in place, children stored side by side
+            const uint8_t *column = data.column(best_feature);
+            auto middle = partition(rows.begin() + pending.begin, rows.begin() + pending.end,
+                                    [&](uint32_t r) { return column[r] <= best_bin; });
+            size_t mid = static_cast<size_t>(middle - rows.begin());
+
+            int left_index = static_cast<int>(tree.nodes.size());
+            tree.nodes.emplace_back();
+            tree.nodes.emplace_back();
+            TreeNode &node = tree.nodes[pending.index];
+            node.feature = best_feature;
+            node.bin = static_cast<uint8_t>(best_bin);
+            node.threshold = data.get_upper_edge(best_feature, best_bin);
+            node.left = left_index;
+
+            PendingNode left_child{left_index, pending.begin, mid, pending.depth + 1, {}, {}};
+            PendingNode right_child{left_index + 1, mid, pending.end, pending.depth + 1, {}, {}};
+            if (!subtraction) {
+                // 6a. Each child scans only its own sampled features
+                left_child.features = sample_features();
+                right_child.features = sample_features();
+                build_histogram(left_child.begin, left_child.end, left_child.features, left_child.hist);
+                build_histogram(right_child.begin, right_child.end, right_child.features, right_child.hist);
+            } else {
+                // 6b. Sibling subtraction: scan only the smaller child
+                left_child.features = sample_features();
+                right_child.features = sample_features();
+                bool left_smaller = (mid - pending.begin) <= (pending.end - mid);
+                PendingNode &small = left_smaller ? left_child : right_child;
+                PendingNode &large = left_smaller ? right_child : left_child;
+                build_histogram(small.begin, small.end, all_features, small.hist);
+                large.hist = move(pending.hist);
+                for (size_t i = 0; i < large.hist.size(); i++) {
+                    large.hist[i] -= small.hist[i];
+                }
+            }
+            stack.push_back(move(right_child));
+            stack.push_back(move(left_child));
+        }
+        return tree;
+    }
+
+    // ==================== CLASSIFIER ====================
+
+    DecisionTreeClassifier::DecisionTreeClassifier(int max_depth, int min_samples_leaf, int max_bins)
+        : DecisionTree(max_depth, min_samples_leaf, max_bins) {
+    }
+
+    void DecisionTreeClassifier::fit(const Dataset &dataset) {
+        if (dataset.size() == 0) {
+            throw invalid_argument("Cannot fit a decision tree on an empty dataset.");
+        }
+        // 1. Map labels to class indices 0..n_classes-1
+        const vector<int> &labels = dataset.get_labels();
+        this->classes_ = labels;
+        sort(this->classes_.begin(), this->classes_.end());
+        this->classes_.erase(unique(this->classes_.begin(), this->classes_.end()), this->classes_.end());
+        vector<double> targets(labels.size());
+        for (size_t i = 0; i < labels.size(); i++) {
+            targets[i] = static_cast<double>(
+                lower_bound(this->classes_.begin(), this->classes_.end(), labels[i]) - this->classes_.begin());
+        }
+
+        // 2. Bin once and grow
+        BinnedDataset binned(dataset.get_features(), this->max_bins_);
+        this->tree_ = grow(binned, targets, static_cast<int>(this->classes_.size()), grow_options());
+    }
+
+    vector<double> DecisionTreeClassifier::predict_proba(const vector<double> &sample) const {
+        const double *proba = this->tree_.predict_leaf(sample);
+        return vector<double>(proba, proba + this->tree_.n_outputs);
+    }
+
+    int DecisionTreeClassifier::predict(const vector<double> &sample) const {
+        const double *proba = this->tree_.predict_leaf(sample);
+        size_t best = max_element(proba, proba + this->tree_.n_outputs) - proba;
+        return this->classes_[best];
+    }
+
+    vector<int> DecisionTreeClassifier::predict(const vector<vector<double> > &samples) const {
+        vector<int> predicted_labels(samples.size());
+        for (size_t i = 0; i < samples.size(); i++) {
+            predicted_labels[i] = predict(samples[i]);
+        }
+        return predicted_labels;
+    }
+
+    double DecisionTreeClassifier::score(const Dataset &test_dataset) const {
+        const vector<int> &y_test = test_dataset.get_labels();
+        if (y_test.empty()) {
+            return 0.0;
+        }
+        vector<int> y_pred = predict(test_dataset.get_features());
+        size_t correct = 0;
+        for (size_t i = 0; i < y_test.size(); i++) {
+            if (y_pred[i] == y_test[i]) {
+                correct++;
+            }
+        }
+        return static_cast<double>(correct) / y_test.size();
+    }
+
+    // ==================== REGRESSOR ====================
+
+    DecisionTreeRegressor::DecisionTreeRegressor(int max_depth, int min_samples_leaf, int max_bins)
+        : DecisionTree(max_depth, min_samples_leaf, max_bins) {
+    }
+
+    void DecisionTreeRegressor::fit(const vector<vector<double> > &X_train, const vector<double> &y_train) {
+        if (X_train.empty() || X_train.size() != y_train.size()) {
+            throw invalid_argument("X_train and y_train must be non-empty and have the same size.");
+        }
+        BinnedDataset binned(X_train, this->max_bins_);
+        this->tree_ = grow(binned, y_train, 0, grow_options());
+    }
+
+    double DecisionTreeRegressor::predict(const vector<double> &sample) const {
+        return *this->tree_.predict_leaf(sample);
+    }
+
+    vector<double> DecisionTreeRegressor::predict(const vector<vector<double> > &X_test) const {
+        vector<double> predictions(X_test.size());
+        for (size_t i = 0; i < X_test.size(); i++) {
+            predictions[i] = predict(X_test[i]);
+        }
+        return predictions;
+    }
+}
@@ -0,0 +1,566 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/supervised/GradientBoosting.h"
+#include "../../include/core/Metrics.h"
+#include "../../include/core/Parallel.h"
+#include "../../include/core/Random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    // Histograms always reserve 256 bins per feature so offsets do not depend on the feature
+    static constexpr size_t HIST_BINS = 256;
+    // Below this many (row, feature) cells a histogram is built on the calling thread
+    static constexpr size_t PARALLEL_CELLS = 1 << 16;
+    // Splits must improve the objective by more than this
+    static constexpr double MIN_GAIN = 1e-12;
+    // Rows pushed through every tree together during batch prediction
+    static constexpr size_t PREDICT_BLOCK = 64;
+    // Hessians are clipped to this so saturated probabilities keep leaf values finite
+    static constexpr double MIN_HESSIAN = 1e-16;
+    // Probabilities are clipped to [MIN_PROBABILITY, 1 - MIN_PROBABILITY] for the base scores
+    static constexpr double MIN_PROBABILITY = 1e-15;
+    // Seed offset of the validation split, independent of the per-round sampling streams
+    static constexpr uint64_t VALIDATION_STREAM = 0x5bd1e995u;
+
+    /**
+     * @brief Gradient and hessian sums of the rows falling in one bin.
+     */
+    struct GradientBin {
+        double grad = 0.0;
+        double hess = 0.0;
+        uint32_t count = 0;
+    };
+
+    // Walks a tree with the pre-binned features of a row (training and validation rows)
+    static double binned_leaf_value(const FlatTree &tree, const BinnedDataset &data, size_t row) {
+        const TreeNode *node = &tree.nodes[0];
+        while (node->feature >= 0) {
+            node = &tree.nodes[node->left + (data.get_bin(node->feature, row) <= node->bin ? 0 : 1)];
+        }
+        return tree.leaf_values[node->leaf];
+    }
+
+    // Raw scores to class probabilities: 2 values for the logistic loss, n_outputs for softmax
+    static void scores_to_proba(const double *scores, BoostingLoss loss, size_t n_outputs, double *proba) {
+        if (loss == BoostingLoss::Logistic) {
+            double p = 1.0 / (1.0 + exp(-scores[0]));
+            proba[0] = 1.0 - p;
+            proba[1] = p;
+            return;
+        }
+        double max_score = *max_element(scores, scores + n_outputs);
+        double sum = 0.0;
+        for (size_t k = 0; k < n_outputs; k++) {
+            proba[k] = exp(scores[k] - max_score);
+            sum += proba[k];
+        }
+        for (size_t k = 0; k < n_outputs; k++) {
+            proba[k] /= sum;
+        }
+    }
+
+    // Grows one tree leaf-wise on gradient/hessian histograms of the given rows and features
+    static FlatTree grow_leaf_wise(const BinnedDataset &data, const vector<double> &grad, const vector<double> &hess,
+                                   vector<uint32_t> rows, const vector<uint32_t> &features,
+                                   const BoostingOptions &options) {
+        size_t n_features = features.size();
+        double lambda = options.l2_regularization;
+        size_t min_leaf = static_cast<size_t>(max(options.min_samples_leaf, 1));
+
+        // 1. Histogram of the rows [begin, end), one slice of HIST_BINS per sampled feature
+        auto fill = [&](size_t f_begin, size_t f_end, size_t r_begin, size_t r_end, GradientBin *out) {
+            for (size_t fi = f_begin; fi < f_end; fi++) {
+                GradientBin *h = out + fi * HIST_BINS;
+                const uint8_t *column = data.column(features[fi]);
+                for (size_t i = r_begin; i < r_end; i++) {
+                    uint32_t r = rows[i];
+                    GradientBin &cell = h[column[r]];
+                    cell.grad += grad[r];
+                    cell.hess += hess[r];
+                    cell.count++;
+                }
+            }
+        };
+        auto build_histogram = [&](size_t begin, size_t end, vector<GradientBin> &hist) {
+            hist.assign(n_features * HIST_BINS, GradientBin());
+            size_t m = end - begin;
+            if (m * n_features < PARALLEL_CELLS) {
+                fill(0, n_features, begin, end, hist.data());
+            } else if (n_features >= num_threads()) {
+                parallel_for(n_features, [&](size_t f_begin, size_t f_end, size_t) {
+                    fill(f_begin, f_end, begin, end, hist.data());
+                }, 1);
+            } else {
+                // Fewer features than threads: each row chunk fills a private histogram
+                vector<vector<GradientBin> > partial(num_threads());
+                size_t chunks = parallel_for(m, [&](size_t r_begin, size_t r_end, size_t chunk) {
+                    partial[chunk].assign(hist.size(), GradientBin());
+                    fill(0, n_features, begin + r_begin, begin + r_end, partial[chunk].data());
+                }, 4096);
+                for (size_t c = 0; c < chunks; c++) {
+                    for (size_t i = 0; i < hist.size(); i++) {
+                        hist[i].grad += partial[c][i].grad;
+                        hist[i].hess += partial[c][i].hess;
+                        hist[i].count += partial[c][i].count;
+                    }
+                }
+            }
+        };
+
+        struct LeafCandidate {
+            int index;
+            size_t begin;
+            size_t end;
+            int depth;
+            vector<GradientBin> hist;
+            double grad = 0.0;
+            double hess = 0.0;
+            double gain = 0.0;
+            int feature = -1;
+            int bin = 0;
+        };
+
+        // 2. Totals from the slice of any feature, then the best split of the leaf
+        auto evaluate = [&](LeafCandidate &leaf) {
+            leaf.grad = 0.0;
+            leaf.hess = 0.0;
+            for (size_t b = 0; b < HIST_BINS; b++) {
+                leaf.grad += leaf.hist[b].grad;
+                leaf.hess += leaf.hist[b].hess;
+            }
+            size_t count = leaf.end - leaf.begin;
+            leaf.feature = -1;
+            leaf.gain = MIN_GAIN;
+            bool splittable = count >= 2 * min_leaf && (options.max_depth <= 0 || leaf.depth < options.max_depth);
+            if (splittable) {
+                double parent_score = leaf.grad * leaf.grad / (leaf.hess + lambda);
+                for (size_t fi = 0; fi < n_features; fi++) {
+                    const GradientBin *h = leaf.hist.data() + fi * HIST_BINS;
+                    double grad_left = 0.0;
+                    double hess_left = 0.0;
+                    size_t count_left = 0;
+                    int bins = data.num_bins(features[fi]);
+                    for (int b = 0; b + 1 < bins; b++) {
+                        grad_left += h[b].grad;
+                        hess_left += h[b].hess;
+                        count_left += h[b].count;
+                        if (count_left < min_leaf) {
+                            continue;
+                        }
+                        if (count - count_left < min_leaf) {
+                            break;
+                        }
+                        double grad_right = leaf.grad - grad_left;
+                        double hess_right = leaf.hess - hess_left;
+                        if (hess_left < options.min_hessian_leaf || hess_right < options.min_hessian_leaf) {
+                            continue;
+                        }
+                        double gain = grad_left * grad_left / (hess_left + lambda)
+                                      + grad_right * grad_right / (hess_right + lambda) - parent_score;
+                        if (gain > leaf.gain) {
+                            leaf.gain = gain;
+                            leaf.feature = static_cast<int>(features[fi]);
+                            leaf.bin = b;
+                        }
+                    }
+                }
+            }
+            if (leaf.feature < 0) {
+                // Final leaf: its histogram is no longer needed
+                vector<GradientBin>().swap(leaf.hist);
+            }
+        };
+
+        FlatTree tree;
+        tree.n_outputs = 1;
+        tree.nodes.emplace_back();
+        vector<LeafCandidate> leaves;
+        leaves.push_back({0, 0, rows.size(), 0, {}});
+        build_histogram(0, rows.size(), leaves[0].hist);
+        evaluate(leaves[0]);
+
+        // 3. Leaf-wise growth: always split the open leaf with the largest gain
+        int n_leaves = 1;
+        while (n_leaves < options.max_leaves) {
+            size_t best = leaves.size();
+            for (size_t i = 0; i < leaves.size(); i++) {
+                if (leaves[i].feature >= 0 && (best == leaves.size() || leaves[i].gain > leaves[best].gain)) {
+                    best = i;
+                }
+            }
+            if (best == leaves.size()) {
+                break;
+            }
+            LeafCandidate parent = move(leaves[best]);
+            leaves[best] = move(leaves.back());
+            leaves.pop_back();
+
+            // 4. Partition the rows in place, children stored side by side
+            const uint8_t *column = data.column(parent.feature);
+            auto middle = partition(rows.begin() + parent.begin, rows.begin() + parent.end,
+                                    [&](uint32_t r) { return column[r] <= parent.bin; });
+            size_t mid = static_cast<size_t>(middle - rows.begin());
+
+            int left_index = static_cast<int>(tree.nodes.size());
+            tree.nodes.emplace_back();
+            tree.nodes.emplace_back();
+            TreeNode &node = tree.nodes[parent.index];
+            node.feature = parent.feature;
+            node.bin = static_cast<uint8_t>(parent.bin);
+            node.threshold = data.get_upper_edge(parent.feature, parent.bin);
+            node.left = left_index;
+
+            // 5. Sibling subtraction: scan only the smaller child
+            LeafCandidate left_child{left_index, parent.begin, mid, parent.depth + 1, {}};
+            LeafCandidate right_child{left_index + 1, mid, parent.end, parent.depth + 1, {}};
+            bool left_smaller = (mid - parent.begin) <= (parent.end - mid);
+            LeafCandidate &small = left_smaller ? left_child : right_child;
+            LeafCandidate &large = left_smaller ? right_child : left_child;
+            build_histogram(small.begin, small.end, small.hist);
+            large.hist = move(parent.hist);
+            for (size_t i = 0; i < large.hist.size(); i++) {
+                large.hist[i].grad -= small.hist[i].grad;
+                large.hist[i].hess -= small.hist[i].hess;
+                large.hist[i].count -= small.hist[i].count;
+            }
+            evaluate(left_child);
+            evaluate(right_child);
+            leaves.push_back(move(left_child));
+            leaves.push_back(move(right_child));
+            n_leaves++;
+        }
+
+        // 6. Leaf values: Newton step -G / (H + lambda), shrunk by the learning rate
+        for (const LeafCandidate &leaf: leaves) {
+            TreeNode &node = tree.nodes[leaf.index];
+            node.leaf = static_cast<int>(tree.leaf_values.size());
+            tree.leaf_values.push_back(-options.learning_rate * leaf.grad / (leaf.hess + lambda));
+        }
+        return tree;
+    }
+
+    GradientBoosting::GradientBoosting(const BoostingOptions &options) {
+        if (options.n_estimators < 1) {
+            throw invalid_argument("n_estimators must be at least 1.");
+        }
+        if (options.learning_rate <= 0.0) {
+            throw invalid_argument("learning_rate must be positive.");
+        }
+        if (options.max_leaves < 2) {
+            throw invalid_argument("max_leaves must be at least 2.");
+        }
+        if (options.l2_regularization < 0.0) {
+            throw invalid_argument("l2_regularization must be non-negative.");
+        }
+        if (options.subsample <= 0.0 || options.subsample > 1.0 ||
+            options.colsample <= 0.0 || options.colsample > 1.0) {
+            throw invalid_argument("subsample and colsample must be in (0, 1].");
+        }
+        if (options.validation_fraction < 0.0 || options.validation_fraction >= 1.0) {
+            throw invalid_argument("validation_fraction must be in [0, 1).");
+        }
+        this->options_ = options;
+    }
+
+    void GradientBoosting::boost(const BinnedDataset &data, const vector<double> &targets, BoostingLoss loss,
+                                 int n_outputs) {
+        const BoostingOptions &options = this->options_;
+        size_t n = data.size();
+        size_t d = data.num_features();
+        size_t K = static_cast<size_t>(n_outputs);
+        uint64_t seed = static_cast<uint64_t>(options.seed);
+        this->loss_ = loss;
+        this->n_outputs_ = n_outputs;
+        this->trees_.clear();
+        this->validation_loss_.clear();
+
+        // 1. Hold out a validation split for early stopping
+        bool early_stopping = options.early_stopping_rounds > 0 && options.validation_fraction > 0.0;
+        vector<uint32_t> train_rows;
+        vector<uint32_t> valid_rows;
+        for (uint32_t r = 0; r < n; r++) {
+            bool hold_out = early_stopping &&
+                            CounterRng::to_uniform(CounterRng::at(seed ^ VALIDATION_STREAM, r)) <
+                            options.validation_fraction;
+            (hold_out ? valid_rows : train_rows).push_back(r);
+        }
+        if (train_rows.empty() || valid_rows.empty()) {
+            early_stopping = false;
+            train_rows.resize(n);
+            iota(train_rows.begin(), train_rows.end(), 0);
+            valid_rows.clear();
+        }
+
+        // 2. Base scores: mean target, log-odds or log class priors of the training rows
+        this->base_scores_.assign(K, 0.0);
+        if (loss == BoostingLoss::Squared || loss == BoostingLoss::Logistic) {
+            double mean = 0.0;
+            for (uint32_t r: train_rows) {
+                mean += targets[r];
+            }
+            mean /= static_cast<double>(train_rows.size());
+            if (loss == BoostingLoss::Squared) {
+                this->base_scores_[0] = mean;
+            } else {
+                double p = min(max(mean, MIN_PROBABILITY), 1.0 - MIN_PROBABILITY);
+                this->base_scores_[0] = log(p / (1.0 - p));
+            }
+        } else {
+            vector<double> counts(K, 0.0);
+            for (uint32_t r: train_rows) {
+                counts[static_cast<size_t>(targets[r])] += 1.0;
+            }
+            for (size_t k = 0; k < K; k++) {
+                this->base_scores_[k] = log(max(counts[k] / train_rows.size(), MIN_PROBABILITY));
+            }
+        }
+
+        vector<double> scores(n * K);
+        for (size_t r = 0; r < n; r++) {
+            copy(this->base_scores_.begin(), this->base_scores_.end(), scores.begin() + r * K);
+        }
+        vector<double> grad(n, 0.0);
+        vector<double> hess(n, 0.0);
+        vector<double> proba(loss == BoostingLoss::Softmax ? n * K : 0);
+        size_t n_classes = loss == BoostingLoss::Softmax ? K : 2;
+
+        vector<uint32_t> all_features(d);
+        iota(all_features.begin(), all_features.end(), 0);
+        size_t n_sampled = max<size_t>(1, static_cast<size_t>(llround(options.colsample * d)));
+
+        double best_loss = numeric_limits<double>::infinity();
+        this->best_iteration_ = 0;
+        for (int round = 0; round < options.n_estimators; round++) {
+            CounterRng rng(CounterRng::at(seed, static_cast<uint64_t>(round)));
+
+            // 3. Row subsample of this round
+            vector<uint32_t> rows;
+            if (options.subsample < 1.0) {
+                for (uint32_t r: train_rows) {
+                    if (rng.uniform() < options.subsample) {
+                        rows.push_back(r);
+                    }
+                }
+            }
+            if (rows.empty()) {
+                rows = train_rows;
+            }
+
+            // 4. Class probabilities of the current model (softmax couples the outputs)
+            if (loss == BoostingLoss::Softmax) {
+                parallel_for(rows.size(), [&](size_t begin, size_t end, size_t) {
+                    for (size_t i = begin; i < end; i++) {
+                        uint32_t r = rows[i];
+                        scores_to_proba(scores.data() + r * K, loss, K, proba.data() + r * K);
+                    }
+                });
+            }
+
+            for (size_t k = 0; k < K; k++) {
+                // 5. Gradients and hessians of output k
+                parallel_for(rows.size(), [&](size_t begin, size_t end, size_t) {
+                    for (size_t i = begin; i < end; i++) {
+                        uint32_t r = rows[i];
+                        if (loss == BoostingLoss::Squared) {
+                            grad[r] = scores[r] - targets[r];
+                            hess[r] = 1.0;
+                        } else {
+                            double p = loss == BoostingLoss::Logistic
+                                           ? 1.0 / (1.0 + exp(-scores[r]))
+                                           : proba[r * K + k];
+                            double y = loss == BoostingLoss::Logistic
+                                           ? targets[r]
+                                           : (static_cast<size_t>(targets[r]) == k ? 1.0 : 0.0);
+                            grad[r] = p - y;
+                            hess[r] = max(p * (1.0 - p), MIN_HESSIAN);
+                        }
+                    }
+                });
+
+                // 6. Feature subsample of this tree (partial Fisher-Yates shuffle)
+                vector<uint32_t> features = all_features;
+                if (n_sampled < d) {
+                    for (size_t i = 0; i < n_sampled; i++) {
+                        swap(features[i], features[i + rng.uniform_index(d - i)]);
+                    }
+                    features.resize(n_sampled);
+                    sort(features.begin(), features.end());
+                }
+
+                FlatTree tree = grow_leaf_wise(data, grad, hess, rows, features, options);
+
+                // 7. Update the raw scores of every training and validation row
+                parallel_for(n, [&](size_t begin, size_t end, size_t) {
+                    for (size_t r = begin; r < end; r++) {
+                        scores[r * K + k] += binned_leaf_value(tree, data, r);
+                    }
+                });
+                this->trees_.push_back(move(tree));
+            }
+
+            if (!early_stopping) {
+                this->best_iteration_ = round + 1;
+                continue;
+            }
+
+            // 8. Validation loss with the fused accumulators, one per chunk, then merged
+            double round_loss;
+            if (loss == BoostingLoss::Squared) {
+                vector<RegressionAccumulator> partial(num_threads());
+                size_t chunks = parallel_for(valid_rows.size(), [&](size_t begin, size_t end, size_t chunk) {
+                    for (size_t i = begin; i < end; i++) {
+                        partial[chunk].add(targets[valid_rows[i]], scores[valid_rows[i]]);
+                    }
+                });
+                for (size_t c = 1; c < chunks; c++) {
+                    partial[0].merge(partial[c]);
+                }
+                round_loss = partial[0].mse();
+            } else {
+                vector<ClassificationAccumulator> partial(num_threads());
+                size_t chunks = parallel_for(valid_rows.size(), [&](size_t begin, size_t end, size_t chunk) {
+                    vector<double> row_proba(n_classes);
+                    for (size_t i = begin; i < end; i++) {
+                        uint32_t r = valid_rows[i];
+                        scores_to_proba(scores.data() + r * K, loss, K, row_proba.data());
+                        partial[chunk].add(static_cast<int>(targets[r]), row_proba.data(), n_classes);
+                    }
+                });
+                for (size_t c = 1; c < chunks; c++) {
+                    partial[0].merge(partial[c]);
+                }
+                round_loss = partial[0].log_loss();
+            }
+            this->validation_loss_.push_back(round_loss);
+
+            // 9. Early stopping: keep the best round, stop after too many rounds without improvement
+            if (round_loss < best_loss) {
+                best_loss = round_loss;
+                this->best_iteration_ = round + 1;
+            } else if (round + 1 - this->best_iteration_ >= options.early_stopping_rounds) {
+                break;
+            }
+        }
+        this->trees_.resize(static_cast<size_t>(this->best_iteration_) * K);
+    }
+
+    vector<double> GradientBoosting::decision_function(const vector<vector<double> > &X) const {
+        size_t K = static_cast<size_t>(this->n_outputs_);
+        vector<double> scores(X.size() * K);
+        for (size_t i = 0; i < X.size(); i++) {
+            copy(this->base_scores_.begin(), this->base_scores_.end(), scores.begin() + i * K);
+        }
+
+        size_t n_blocks = (X.size() + PREDICT_BLOCK - 1) / PREDICT_BLOCK;
+        parallel_for(n_blocks, [&](size_t block_begin, size_t block_end, size_t) {
+            for (size_t block = block_begin; block < block_end; block++) {
+                size_t begin = block * PREDICT_BLOCK;
+                size_t end = min(X.size(), begin + PREDICT_BLOCK);
+                // Tree-major order: each tree is applied to the whole block
+                for (size_t t = 0; t < this->trees_.size(); t++) {
+                    const FlatTree &tree = this->trees_[t];
+                    size_t k = t % K;
+                    for (size_t i = begin; i < end; i++) {
+                        scores[i * K + k] += *tree.predict_leaf(X[i]);
+                    }
+                }
+            }
+        }, 1);
+        return scores;
+    }
+
+    // ==================== CLASSIFIER ====================
+
+    GradientBoostingClassifier::GradientBoostingClassifier(const BoostingOptions &options)
+        : GradientBoosting(options) {
+    }
+
+    void GradientBoostingClassifier::fit(const Dataset &dataset) {
+        if (dataset.size() == 0) {
+            throw invalid_argument("Cannot fit gradient boosting on an empty dataset.");
+        }
+        // 1. Map labels to class indices 0..n_classes-1
+        const vector<int> &labels = dataset.get_labels();
+        this->classes_ = labels;
+        sort(this->classes_.begin(), this->classes_.end());
+        this->classes_.erase(unique(this->classes_.begin(), this->classes_.end()), this->classes_.end());
+        vector<double> targets(labels.size());
+        for (size_t i = 0; i < labels.size(); i++) {
+            targets[i] = static_cast<double>(
+                lower_bound(this->classes_.begin(), this->classes_.end(), labels[i]) - this->classes_.begin());
+        }
+
+        // 2. Logistic loss for two classes, softmax with one tree per class otherwise
+        BinnedDataset binned(dataset.get_features(), this->options_.max_bins);
+        if (this->classes_.size() <= 2) {
+            boost(binned, targets, BoostingLoss::Logistic, 1);
+        } else {
+            boost(binned, targets, BoostingLoss::Softmax, static_cast<int>(this->classes_.size()));
+        }
+    }
+
+    vector<vector<double> > GradientBoostingClassifier::predict_proba(const vector<vector<double> > &samples) const {
+        vector<double> scores = decision_function(samples);
+        size_t K = static_cast<size_t>(this->n_outputs_);
+        size_t n_classes = this->classes_.size();
+        vector<double> row_proba(max<size_t>(n_classes, 2));
+        vector<vector<double> > probabilities(samples.size());
+        for (size_t i = 0; i < samples.size(); i++) {
+            scores_to_proba(scores.data() + i * K, this->loss_, K, row_proba.data());
+            probabilities[i].assign(row_proba.begin(), row_proba.begin() + n_classes);
+        }
+        return probabilities;
+    }
+
+    vector<int> GradientBoostingClassifier::predict(const vector<vector<double> > &samples) const {
+        vector<vector<double> > probabilities = predict_proba(samples);
+        vector<int> predicted_labels(samples.size());
+        for (size_t i = 0; i < samples.size(); i++) {
+            const vector<double> &proba = probabilities[i];
+            predicted_labels[i] = this->classes_[max_element(proba.begin(), proba.end()) - proba.begin()];
+        }
+        return predicted_labels;
+    }
+
+    int GradientBoostingClassifier::predict(const vector<double> &sample) const {
+        return predict(vector<vector<double> >{sample})[0];
+    }
+
+    double GradientBoostingClassifier::score(const Dataset &test_dataset) const {
+        const vector<int> &y_test = test_dataset.get_labels();
+        if (y_test.empty()) {
+            return 0.0;
+        }
+        return Metrics::accuracy(y_test, predict(test_dataset.get_features()));
+    }
+
+    // ==================== REGRESSOR ====================
+
+    GradientBoostingRegressor::GradientBoostingRegressor(const BoostingOptions &options)
+        : GradientBoosting(options) {
+    }
+
+    void GradientBoostingRegressor::fit(const vector<vector<double> > &X_train, const vector<double> &y_train) {
+        if (X_train.empty() || X_train.size() != y_train.size()) {
+            throw invalid_argument("X_train and y_train must be non-empty and have the same size.");
+        }
+        BinnedDataset binned(X_train, this->options_.max_bins);
+        boost(binned, y_train, BoostingLoss::Squared, 1);
+    }
+
+    vector<double> GradientBoostingRegressor::predict(const vector<vector<double> > &X_test) const {
+        return decision_function(X_test);
+    }
+
+    double GradientBoostingRegressor::predict(const vector<double> &sample) const {
+        return decision_function(vector<vector<double> >{sample})[0];
+    }
+}
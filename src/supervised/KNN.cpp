@@ -3,44 +3,378 @@
 //
 
 #include "../../include/supervised/KNN.h"
+#include "../../include/core/Parallel.h"
+#include "../../include/core/Random.h"
 
+#include <algorithm>
+#include <cmath>
 #include <map>
+#include <stdexcept>
 using namespace std;
 namespace mlcpp {
+    // Indices of a neighbor list, closest first
+    static vector<size_t> neighbor_indices(const vector<Neighbor> &neighbors) {
+        vector<size_t> indices;
+        indices.reserve(neighbors.size());
+        for (const Neighbor &neighbor: neighbors) {
+            indices.push_back(neighbor.second);
+        }
+        return indices;
+    }
+
+    // Condensed candidates searched against the store at once
+    static constexpr size_t CONDENSE_BLOCK = 1024;
+    // Lloyd iterations for the k-means prototypes
+    static constexpr int KMEANS_ITERATIONS = 20;
+
+    // Keeps the rows at the given indices
+    static void keep_rows(vector<vector<double> > &rows, vector<int> &labels, const vector<size_t> &kept) {
+        vector<vector<double> > kept_rows;
+        vector<int> kept_labels;
+        kept_rows.reserve(kept.size());
+        kept_labels.reserve(kept.size());
+        for (size_t i: kept) {
+            kept_rows.push_back(move(rows[i]));
+            kept_labels.push_back(labels[i]);
+        }
+        rows = move(kept_rows);
+        labels = move(kept_labels);
+    }
+
+    // Hart's condensed nearest neighbor: every row is classified correctly by its 1-NN in the store
+    static void condense(NeighborSearch engine, vector<vector<double> > &rows, vector<int> &labels, uint64_t seed) {
+        size_t n = rows.size();
+        vector<size_t> order(n);
+        for (size_t i = 0; i < n; i++) {
+            order[i] = i;
+        }
+        CounterRng rng(seed);
+        for (size_t i = 0; i + 1 < n; i++) {
+            swap(order[i], order[i + rng.uniform_index(n - i)]);
+        }
+
+        // 1. Seed the store with the first row of each class in the visiting order
+        vector<size_t> store;
+        vector<char> in_store(n, 0);
+        map<int, bool> seen;
+        for (size_t i: order) {
+            if (!seen[labels[i]]) {
+                seen[labels[i]] = true;
+                store.push_back(i);
+                in_store[i] = 1;
+            }
+        }
+
+        // 2. Passes until no row is added. Each block is searched against the store in
+        //    parallel; rows added earlier in the same block are checked one by one.
+        bool added = true;
+        while (added) {
+            added = false;
+            for (size_t b = 0; b < n; b += CONDENSE_BLOCK) {
+                vector<size_t> candidates;
+                for (size_t s = b; s < min(n, b + CONDENSE_BLOCK); s++) {
+                    if (!in_store[order[s]]) {
+                        candidates.push_back(order[s]);
+                    }
+                }
+                if (candidates.empty()) {
+                    continue;
+                }
+                vector<vector<double> > store_rows;
+                store_rows.reserve(store.size());
+                for (size_t i: store) {
+                    store_rows.push_back(rows[i]);
+                }
+                engine.fit(move(store_rows));
+                vector<vector<double> > queries;
+                queries.reserve(candidates.size());
+                for (size_t i: candidates) {
+                    queries.push_back(rows[i]);
+                }
+                vector<vector<Neighbor> > nearest = engine.kneighbors(queries, 1);
+
+                size_t block_start = store.size();
+                for (size_t c = 0; c < candidates.size(); c++) {
+                    size_t i = candidates[c];
+                    double best_distance = nearest[c][0].first;
+                    int best_label = labels[store[nearest[c][0].second]];
+                    for (size_t s = block_start; s < store.size(); s++) {
+                        double distance = engine.distance(rows[i], rows[store[s]]);
+                        if (distance < best_distance) {
+                            best_distance = distance;
+                            best_label = labels[store[s]];
+                        }
+                    }
+                    if (best_label != labels[i]) {
+                        store.push_back(i);
+                        in_store[i] = 1;
+                        added = true;
+                    }
+                }
+            }
+        }
+        keep_rows(rows, labels, store);
+    }
+
+    // Wilson's edited nearest neighbor: drop rows whose k other neighbors vote for another label
+    static void edit(NeighborSearch engine, vector<vector<double> > &rows, vector<int> &labels, size_t k) {
+        size_t n = rows.size();
+        engine.fit(rows);
+        vector<vector<Neighbor> > graph = engine.kneighbors_graph(k);
+        vector<char> keep(n, 0);
+        parallel_for(n, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                map<int, size_t> votes;
+                for (const Neighbor &neighbor: graph[i]) {
+                    votes[labels[neighbor.second]]++;
+                }
+                size_t own = votes[labels[i]];
+                bool majority = true;
+                for (const auto &[label, count]: votes) {
+                    if (label != labels[i] && count >= own) {
+                        majority = false;
+                    }
+                }
+                keep[i] = majority;
+            }
+        });
+        vector<size_t> kept;
+        for (size_t i = 0; i < n; i++) {
+            if (keep[i]) {
+                kept.push_back(i);
+            }
+        }
+        if (!kept.empty()) {
+            keep_rows(rows, labels, kept);
+        }
+    }
+
+    // Replaces each class by k-means centroids (prototype_fraction of its size)
+    static void kmeans_prototypes(vector<vector<double> > &rows, vector<int> &labels,
+                                  double prototype_fraction, uint64_t seed) {
+        map<int, vector<size_t> > members;
+        for (size_t i = 0; i < rows.size(); i++) {
+            members[labels[i]].push_back(i);
+        }
+        size_t d = rows.empty() ? 0 : rows[0].size();
+        vector<vector<double> > prototypes;
+        vector<int> prototype_labels;
+        for (const auto &[label, indices]: members) {
+            size_t n_c = indices.size();
+            size_t m = max<size_t>(1, static_cast<size_t>(llround(prototype_fraction * n_c)));
+            vector<vector<double> > class_rows;
+            class_rows.reserve(n_c);
+            for (size_t i: indices) {
+                class_rows.push_back(rows[i]);
+            }
+
+            // 1. Initialize with m distinct random rows of the class
+            CounterRng rng(CounterRng::at(seed, static_cast<uint64_t>(label)));
+            vector<size_t> order(n_c);
+            for (size_t i = 0; i < n_c; i++) {
+                order[i] = i;
+            }
+            vector<vector<double> > centroids(m);
+            for (size_t c = 0; c < m; c++) {
+                swap(order[c], order[c + rng.uniform_index(n_c - c)]);
+                centroids[c] = class_rows[order[c]];
+            }
+
+            // 2. Lloyd iterations: parallel assignment, per-chunk sums
+            NeighborSearch engine(euclidean_distance);
+            vector<size_t> assignment(n_c, m);
+            for (int iter = 0; iter < KMEANS_ITERATIONS && m < n_c; iter++) {
+                engine.fit(centroids);
+                vector<vector<Neighbor> > nearest = engine.kneighbors(class_rows, 1);
+                bool changed = false;
+                for (size_t i = 0; i < n_c; i++) {
+                    changed |= assignment[i] != nearest[i][0].second;
+                    assignment[i] = nearest[i][0].second;
+                }
+                if (!changed) {
+                    break;
+                }
+                vector<vector<double> > sums(num_threads());
+                vector<vector<size_t> > counts(num_threads());
+                size_t chunks = parallel_for(n_c, [&](size_t begin, size_t end, size_t chunk) {
+                    sums[chunk].assign(m * d, 0.0);
+                    counts[chunk].assign(m, 0);
+                    for (size_t i = begin; i < end; i++) {
+                        counts[chunk][assignment[i]]++;
+                        for (size_t j = 0; j < d; j++) {
+                            sums[chunk][assignment[i] * d + j] += class_rows[i][j];
+                        }
+                    }
+                });
+                for (size_t c = 0; c < m; c++) {
+                    size_t count = 0;
+                    vector<double> sum(d, 0.0);
+                    for (size_t chunk = 0; chunk < chunks; chunk++) {
+                        count += counts[chunk][c];
+                        for (size_t j = 0; j < d; j++) {
+                            sum[j] += sums[chunk][c * d + j];
+                        }
+                    }
+                    // Empty clusters keep their previous centroid
+                    if (count > 0) {
+                        for (size_t j = 0; j < d; j++) {
+                            centroids[c][j] = sum[j] / count;
+                        }
+                    }
+                }
+            }
+            for (vector<double> &centroid: centroids) {
+                prototypes.push_back(move(centroid));
+                prototype_labels.push_back(label);
+            }
+        }
+        rows = move(prototypes);
+        labels = move(prototype_labels);
+    }
+
     // Constructor
     // k: number of neighbors to consider
     // distance: distance metric function
-    KNN::KNN(int k, mlcpp::DistanceMetric distance) {
+    KNN::KNN(int k, mlcpp::DistanceMetric distance) : search_(distance) {
         this->k_ = k;
-        this->distance_ = distance;
+    }
+
+    // Mahalanobis KNN: euclidean search over whitened features
+    KNN KNN::mahalanobis(int k, double regularization) {
+        KNN model(k, euclidean_distance);
+        model.whitening_ = MahalanobisWhitening(regularization);
+        return model;
     }
 
     // Fit the model with training data
-    // This is a "lazy" algorithm - just stores the training data
+    // This is a "lazy" algorithm - stores the training data and caches the row norms
     void KNN::fit(Dataset &dataset) {
-        this->X_train_ = dataset.get_features();
-        this->y_train_ = dataset.get_labels();
+        fit(dataset, PrototypeReduction::None);
+    }
+
+    // Fit the model on a reduced reference set (see PrototypeReduction)
+    void KNN::fit(Dataset &dataset, PrototypeReduction reduction, double prototype_fraction, uint64_t seed) {
+        if (prototype_fraction <= 0.0 || prototype_fraction > 1.0) {
+            throw invalid_argument("prototype_fraction must be in (0, 1].");
+        }
+        // 1. Move to the search space (whitened for Mahalanobis), dropping the previous reference set
+        this->search_.fit({});
+        vector<vector<double> > rows;
+        if (this->whitening_) {
+            this->whitening_->fit(dataset.get_features());
+            rows = this->whitening_->transform(dataset.get_features());
+        } else {
+            rows = dataset.get_features();
+        }
+        vector<int> labels = dataset.get_labels();
+
+        // 2. Reduce the reference set with the same metric as the search
+        size_t k = static_cast<size_t>(max(this->k_, 1));
+        switch (reduction) {
+            case PrototypeReduction::Condensed:
+                condense(this->search_, rows, labels, seed);
+                break;
+            case PrototypeReduction::Edited:
+                edit(this->search_, rows, labels, k);
+                break;
+            case PrototypeReduction::KMeans:
+                kmeans_prototypes(rows, labels, prototype_fraction, seed);
+                break;
+            default:
+                break;
+        }
+
+        this->search_.fit(move(rows));
+        this->y_train_ = move(labels);
+        this->binary_ = false;
+        this->bits_train_ = BitMatrix();
+        this->train_popcounts_.clear();
+    }
+
+    // Fit the model with bit-packed binary features
+    void KNN::fit(const BitMatrix &features, const vector<int> &labels, BinaryMetric metric) {
+        if (features.size() != labels.size()) {
+            throw invalid_argument("features and labels must have the same number of samples.");
+        }
+        this->bits_train_ = features;
+        this->y_train_ = labels;
+        this->binary_metric_ = metric;
+        this->binary_ = true;
+        this->search_.fit({});
+
+        size_t words = features.words_per_row();
+        this->train_popcounts_.assign(features.size(), 0);
+        parallel_for(features.size(), [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                this->train_popcounts_[i] = static_cast<uint32_t>(popcount(this->bits_train_.row(i), words));
+            }
+        });
     }
 
     // Predict label for a single sample
     // Returns the predicted label
     int KNN::predict(const vector<double> &sample) const {
-        vector<size_t> k_nearest_idx = find_k_nearest(sample);
-        return majority_vote(k_nearest_idx);
+        if (this->binary_) {
+            throw logic_error("KNN must be fitted on dense features before predicting dense samples.");
+        }
+        size_t k = static_cast<size_t>(max(this->k_, 0));
+        if (this->whitening_) {
+            return majority_vote(neighbor_indices(this->search_.kneighbors(this->whitening_->transform(sample), k)));
+        }
+        return majority_vote(neighbor_indices(this->search_.kneighbors(sample, k)));
     }
 
     // Predict labels for multiple samples
     // Returns vector of predicted labels
     vector<int> KNN::predict(const vector<vector<double> > &samples) const {
-        vector<int> predicted_labels;
-        predicted_labels.reserve(samples.size());
+        if (this->binary_) {
+            throw logic_error("KNN must be fitted on dense features before predicting dense samples.");
+        }
+        if (this->whitening_) {
+            // Whiten every query once, then search as usual
+            return predict_batch(this->whitening_->transform(samples));
+        }
+        return predict_batch(samples);
+    }
+
+    // Batch prediction on samples already in the space of the training rows
+    vector<int> KNN::predict_batch(const vector<vector<double> > &samples) const {
+        vector<vector<Neighbor> > neighbors = this->search_.kneighbors(samples, static_cast<size_t>(max(this->k_, 0)));
+        vector<int> predicted_labels(samples.size(), 0);
         for (size_t i = 0; i < samples.size(); i++) {
-            vector<size_t> k_nearest_idx = find_k_nearest(samples[i]);
-            predicted_labels.push_back(majority_vote(k_nearest_idx));
+            predicted_labels[i] = majority_vote(neighbor_indices(neighbors[i]));
         }
         return predicted_labels;
     }
 
+    // Predict label for one row of a bit-packed matrix
+    int KNN::predict(const BitMatrix &samples, size_t row) const {
+        check_bit_samples(samples);
+        return majority_vote(find_k_nearest_bits(samples.row(row), true));
+    }
+
+    // Predict labels for all rows of a bit-packed matrix
+    vector<int> KNN::predict(const BitMatrix &samples) const {
+        check_bit_samples(samples);
+        vector<int> predicted_labels(samples.size(), 0);
+        parallel_for(samples.size(), [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                predicted_labels[i] = majority_vote(find_k_nearest_bits(samples.row(i), false));
+            }
+        }, 1);
+        return predicted_labels;
+    }
+
+    // Bit-packed queries are compared word by word with the training rows, so the widths must match
+    void KNN::check_bit_samples(const BitMatrix &samples) const {
+        if (!this->binary_) {
+            throw logic_error("KNN must be fitted on bit-packed features before predicting bit-packed samples.");
+        }
+        if (samples.num_bits() != this->bits_train_.num_bits()) {
+            throw invalid_argument("samples must have the same number of bits as the training data.");
+        }
+    }
+
     // Calculate accuracy on a test dataset
     // Returns accuracy as a value between 0.0 and 1.0
     double KNN::score(const Dataset &test_dataset) const {
@@ -59,7 +393,7 @@ namespace mlcpp {
         // 4. Count correct predictions
         int correct = 0;
         for (size_t i = 0; i < y_test.size(); i++) {
-            if (this->y_train_[i] == y_test[i]) {
+            if (y_pred[i] == y_test[i]) {
                 correct++;
             }
         }
@@ -67,25 +401,170 @@ namespace mlcpp {
         return static_cast<double>(correct) / y_test.size();
     }
 
-    // Find indices of k nearest neighbors for a given sample
-    vector<size_t> KNN::find_k_nearest(const vector<double> &sample) const {
-        //Calculate the distances and their index and save them in vector of pairs
-        vector<pair<double, size_t> > distances;
-        for (size_t i = 0; i < this->X_train_.size(); i++) {
-            distances.push_back({this->distance_(sample, this->X_train_[i]), i});
-        }
-
+    vector<size_t> KNN::select_k_nearest(vector<pair<double, size_t> > &scored) const {
         //Sort it by the distances
-        partial_sort(distances.begin(), distances.begin() + this->k_, distances.end());
+        size_t k = min(static_cast<size_t>(max(this->k_, 0)), scored.size());
+        partial_sort(scored.begin(), scored.begin() + k, scored.end());
 
         //Add the k_nearest to the vector
         vector<size_t> k_nearest;
-        for (size_t i = 0; i < this->k_ - 1; i++) {
-            k_nearest.push_back(distances[i].second);
+        k_nearest.reserve(k);
+        for (size_t i = 0; i < k; i++) {
+            k_nearest.push_back(scored[i].second);
         }
         return k_nearest;
     }
 
+    // Leave-one-out accuracy: one self-excluding all-pairs search
+    double KNN::loo_score() const {
+        return loo_score({this->k_})[0];
+    }
+
+    vector<double> KNN::loo_score(const vector<int> &k_values) const {
+        if (this->binary_ || this->search_.size() == 0) {
+            throw logic_error("KNN must be fitted on dense features before loo_score.");
+        }
+        int max_k = 0;
+        for (int k: k_values) {
+            if (k < 1) {
+                throw invalid_argument("k must be at least 1.");
+            }
+            max_k = max(max_k, k);
+        }
+
+        // 1. Neighbors of every row among the other rows, for the largest k
+        vector<vector<Neighbor> > graph = this->search_.kneighbors_graph(static_cast<size_t>(max_k));
+
+        // 2. Vote with each k by truncating the shared lists
+        size_t n = graph.size();
+        vector<vector<size_t> > correct(num_threads(), vector<size_t>(k_values.size(), 0));
+        size_t chunks = parallel_for(n, [&](size_t begin, size_t end, size_t chunk) {
+            for (size_t i = begin; i < end; i++) {
+                vector<size_t> indices = neighbor_indices(graph[i]);
+                for (size_t v = 0; v < k_values.size(); v++) {
+                    size_t k = min(indices.size(), static_cast<size_t>(k_values[v]));
+                    vector<size_t> nearest(indices.begin(), indices.begin() + k);
+                    correct[chunk][v] += majority_vote(nearest) == this->y_train_[i];
+                }
+            }
+        });
+        vector<double> scores(k_values.size(), 0.0);
+        for (size_t v = 0; v < k_values.size(); v++) {
+            size_t total = 0;
+            for (size_t chunk = 0; chunk < chunks; chunk++) {
+                total += correct[chunk][v];
+            }
+            scores[v] = static_cast<double>(total) / n;
+        }
+        return scores;
+    }
+
+    // K-fold accuracy: shared neighbor lists filtered by fold
+    double KNN::cv_score(int n_folds, uint64_t seed) const {
+        if (this->binary_ || this->search_.size() == 0) {
+            throw logic_error("KNN must be fitted on dense features before cv_score.");
+        }
+        size_t n = this->search_.size();
+        if (n_folds < 2 || static_cast<size_t>(n_folds) > n) {
+            throw invalid_argument("n_folds must be between 2 and the number of rows.");
+        }
+        size_t k = static_cast<size_t>(max(this->k_, 1));
+
+        // 1. Random balanced folds: a permutation dealt round-robin
+        vector<size_t> order(n);
+        for (size_t i = 0; i < n; i++) {
+            order[i] = i;
+        }
+        CounterRng rng(seed);
+        for (size_t i = 0; i + 1 < n; i++) {
+            swap(order[i], order[i + rng.uniform_index(n - i)]);
+        }
+        vector<int> fold(n);
+        for (size_t i = 0; i < n; i++) {
+            fold[order[i]] = static_cast<int>(i % n_folds);
+        }
+
+        // 2. One shared search, long enough that about k rows survive the fold filter
+        double expected = static_cast<double>(k) * n_folds / (n_folds - 1);
+        size_t length = static_cast<size_t>(ceil(expected + 3.0 * sqrt(expected))) + 1;
+        vector<vector<Neighbor> > graph = this->search_.kneighbors_graph(length);
+
+        // 3. Vote with the first k rows of other folds; search again for rows left short
+        const vector<vector<double> > &rows = this->search_.get_data();
+        vector<size_t> correct(num_threads(), 0);
+        size_t chunks = parallel_for(n, [&](size_t begin, size_t end, size_t chunk) {
+            for (size_t i = begin; i < end; i++) {
+                vector<size_t> nearest;
+                for (const Neighbor &neighbor: graph[i]) {
+                    if (nearest.size() < k && fold[neighbor.second] != fold[i]) {
+                        nearest.push_back(neighbor.second);
+                    }
+                }
+                size_t longer = length;
+                while (nearest.size() < k && longer < n) {
+                    longer = min(n, longer * 2);
+                    nearest.clear();
+                    for (const Neighbor &neighbor: this->search_.kneighbors(rows[i], longer)) {
+                        if (nearest.size() < k && fold[neighbor.second] != fold[i]) {
+                            nearest.push_back(neighbor.second);
+                        }
+                    }
+                }
+                correct[chunk] += majority_vote(nearest) == this->y_train_[i];
+            }
+        });
+        size_t total = 0;
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            total += correct[chunk];
+        }
+        return static_cast<double>(total) / n;
+    }
+
+    // Find indices of k nearest bit-packed neighbors for a packed query
+    vector<size_t> KNN::find_k_nearest_bits(const uint64_t *query, bool parallel) const {
+        size_t n_train = this->bits_train_.size();
+        size_t words = this->bits_train_.words_per_row();
+        bool jaccard = this->binary_metric_ != BinaryMetric::Hamming;
+        double query_count = static_cast<double>(popcount(query, words));
+
+        // Each scan keeps a max-heap of its k best rows, so a query needs O(k) memory
+        size_t k = static_cast<size_t>(max(this->k_, 0));
+        auto scan = [&](size_t begin, size_t end, vector<pair<double, size_t> > &best) {
+            best.clear();
+            best.reserve(min(k, end - begin));
+            for (size_t i = begin; i < end; i++) {
+                const uint64_t *row = this->bits_train_.row(i);
+                double score;
+                if (jaccard) {
+                    // |a OR b| = |a| + |b| - |a AND b|, with |b| cached at fit time
+                    double intersection = static_cast<double>(popcount_and(query, row, words));
+                    double unite = query_count + this->train_popcounts_[i] - intersection;
+                    score = unite == 0.0 ? 0.0 : 1.0 - intersection / unite;
+                } else {
+                    score = static_cast<double>(hamming_distance(query, row, words));
+                }
+                offer_neighbor(best, k, {score, i});
+            }
+        };
+
+        if (!parallel) {
+            vector<pair<double, size_t> > best;
+            scan(0, n_train, best);
+            return select_k_nearest(best);
+        }
+
+        // Every chunk keeps its own k best; the global k best are among them
+        vector<vector<pair<double, size_t> > > chunk_best(num_threads());
+        parallel_for(n_train, [&](size_t begin, size_t end, size_t chunk) {
+            scan(begin, end, chunk_best[chunk]);
+        }, 4096);
+        vector<pair<double, size_t> > merged;
+        for (const auto &best: chunk_best) {
+            merged.insert(merged.end(), best.begin(), best.end());
+        }
+        return select_k_nearest(merged);
+    }
+
     // Get majority vote from neighbor labels
     int KNN::majority_vote(const vector<size_t> &neighbor_indices) const {
 
@@ -0,0 +1,184 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/supervised/LinearModelCV.h"
+#include "../../include/core/LinearAlgebra.h"
+#include "../../include/core/Parallel.h"
+#include "../../include/core/Random.h"
+
+#include <limits>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    // Checks the penalties; the sizes of X and y are checked by augmented_gram
+    static void check_ridges(const vector<double> &ridges) {
+        for (double ridge: ridges) {
+            if (!(ridge >= 0.0)) {
+                throw invalid_argument("ridge must be non-negative.");
+            }
+        }
+    }
+
+    // Cholesky factor of ZᵀZ + ridge * R, where R penalizes the weights but not the intercept
+    static vector<vector<double> > factor_system(vector<vector<double> > gram, double ridge) {
+        for (size_t j = 1; j < gram.size(); j++) {
+            gram[j][j] += ridge;
+        }
+        return LinearAlgebra::cholesky_jittered(move(gram), 1);
+    }
+
+    // θ · [1, x]
+    static double predict_row(const vector<double> &theta, const vector<double> &x) {
+        double value = theta[0];
+        for (size_t j = 0; j < x.size(); j++) {
+            value += theta[j + 1] * x[j];
+        }
+        return value;
+    }
+
+    CVResult LinearModelCV::k_fold(const vector<vector<double> > &X, const vector<double> &y,
+                                   int n_folds, uint64_t seed, double ridge) {
+        return k_fold(X, y, vector<double>{ridge}, n_folds, seed)[0];
+    }
+
+    vector<CVResult> LinearModelCV::k_fold(const vector<vector<double> > &X, const vector<double> &y,
+                                           const vector<double> &ridges, int n_folds, uint64_t seed) {
+        size_t n = X.size();
+        if (n_folds < 2 || static_cast<size_t>(n_folds) > n) {
+            throw invalid_argument("n_folds must be between 2 and the number of rows.");
+        }
+        check_ridges(ridges);
+
+        // 1. Random balanced folds: a permutation dealt round-robin
+        vector<size_t> order(n);
+        for (size_t i = 0; i < n; i++) {
+            order[i] = i;
+        }
+        CounterRng rng(seed);
+        for (size_t i = 0; i + 1 < n; i++) {
+            swap(order[i], order[i + rng.uniform_index(n - i)]);
+        }
+        vector<int> fold(n);
+        for (size_t i = 0; i < n; i++) {
+            fold[order[i]] = static_cast<int>(i % n_folds);
+        }
+
+        // 2. One parallel pass: normal equations of every fold, and their total
+        vector<GramBlock> blocks = LinearAlgebra::augmented_gram(X, y, fold, n_folds);
+        size_t p = blocks[0].rhs.size();
+        GramBlock total = blocks[0];
+        for (int f = 1; f < n_folds; f++) {
+            for (size_t a = 0; a < p; a++) {
+                for (size_t b = 0; b < p; b++) {
+                    total.gram[a][b] += blocks[f].gram[a][b];
+                }
+                total.rhs[a] += blocks[f].rhs[a];
+            }
+        }
+
+        // 3. Training system of each fold = total - held-out block, solved per penalty
+        size_t n_ridges = ridges.size();
+        vector<vector<vector<double> > > thetas(n_ridges, vector<vector<double> >(n_folds));
+        for (int f = 0; f < n_folds; f++) {
+            GramBlock train = total;
+            for (size_t a = 0; a < p; a++) {
+                for (size_t b = 0; b < p; b++) {
+                    train.gram[a][b] -= blocks[f].gram[a][b];
+                }
+                train.rhs[a] -= blocks[f].rhs[a];
+            }
+            for (size_t r = 0; r < n_ridges; r++) {
+                thetas[r][f] = LinearAlgebra::cholesky_solve(factor_system(train.gram, ridges[r]), train.rhs);
+            }
+        }
+
+        // 4. Out-of-fold predictions in parallel, then the fold MSEs
+        vector<CVResult> results(n_ridges);
+        for (CVResult &result: results) {
+            result.predictions.assign(n, 0.0);
+            result.fold_scores.assign(n_folds, 0.0);
+        }
+        parallel_for(n, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                for (size_t r = 0; r < n_ridges; r++) {
+                    results[r].predictions[i] = predict_row(thetas[r][fold[i]], X[i]);
+                }
+            }
+        });
+        vector<size_t> fold_sizes(n_folds, 0);
+        for (size_t i = 0; i < n; i++) {
+            fold_sizes[fold[i]]++;
+        }
+        for (CVResult &result: results) {
+            for (size_t i = 0; i < n; i++) {
+                double error = y[i] - result.predictions[i];
+                result.fold_scores[fold[i]] += error * error;
+            }
+            for (int f = 0; f < n_folds; f++) {
+                result.fold_scores[f] /= fold_sizes[f];
+                result.mean_score += result.fold_scores[f];
+            }
+            result.mean_score /= n_folds;
+        }
+        return results;
+    }
+
+    CVResult LinearModelCV::leave_one_out(const vector<vector<double> > &X, const vector<double> &y, double ridge) {
+        return leave_one_out(X, y, vector<double>{ridge})[0];
+    }
+
+    vector<CVResult> LinearModelCV::leave_one_out(const vector<vector<double> > &X, const vector<double> &y,
+                                                  const vector<double> &ridges) {
+        check_ridges(ridges);
+        size_t n = X.size();
+        if (n == 0 || n <= X[0].size() + 1) {
+            throw invalid_argument("leave_one_out needs more rows than parameters (features + 1).");
+        }
+
+        // 1. One parallel pass: normal equations of all rows
+        GramBlock system = LinearAlgebra::augmented_gram(X, y)[0];
+
+        vector<CVResult> results(ridges.size());
+        for (size_t r = 0; r < ridges.size(); r++) {
+            // 2. Full fit with this penalty
+            vector<vector<double> > L = factor_system(system.gram, ridges[r]);
+            vector<double> theta = LinearAlgebra::cholesky_solve(L, system.rhs);
+
+            // 3. Per row: leverage h = |L⁻¹ z|², leave-one-out residual e / (1 - h)
+            CVResult &result = results[r];
+            result.predictions.assign(n, 0.0);
+            result.fold_scores.assign(n, 0.0);
+            size_t p = theta.size();
+            parallel_for(n, [&](size_t begin, size_t end, size_t) {
+                vector<double> v(p);
+                for (size_t i = begin; i < end; i++) {
+                    // Forward substitution L v = [1, x]
+                    for (size_t a = 0; a < p; a++) {
+                        double sum = a == 0 ? 1.0 : X[i][a - 1];
+                        for (size_t b = 0; b < a; b++) {
+                            sum -= L[a][b] * v[b];
+                        }
+                        v[a] = sum / L[a][a];
+                    }
+                    double leverage = 0.0;
+                    for (size_t a = 0; a < p; a++) {
+                        leverage += v[a] * v[a];
+                    }
+                    double residual = y[i] - predict_row(theta, X[i]);
+                    double loo_residual = leverage < 1.0
+                                              ? residual / (1.0 - leverage)
+                                              : numeric_limits<double>::infinity();
+                    result.predictions[i] = y[i] - loo_residual;
+                    result.fold_scores[i] = loo_residual * loo_residual;
+                }
+            }, 64);
+            for (double score: result.fold_scores) {
+                result.mean_score += score;
+            }
+            result.mean_score /= n;
+        }
+        return results;
+    }
+}
@@ -3,60 +3,975 @@
 //
 
 #include "../../include/supervised/LinearRegression.h"
+#include "../../include/core/LinearAlgebra.h"
+#include "../../include/core/Parallel.h"
+#include "../../include/core/Random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
 using namespace std;
 
 namespace mlcpp {
+    // Rows folded together by one Woodbury update in update_batch()
+    static constexpr size_t RLS_BLOCK = 32;
+    // Inverse Gram used when online updates start without a normal-equation fit (weak prior)
+    static constexpr double RLS_INITIAL_SCALE = 1e6;
+    // Default CountSketch rows per parameter of the "sketch" method
+    static constexpr size_t SKETCH_FACTOR = 20;
+    // Model tag of "gradient" checkpoints, so another model's file is never resumed
+    static constexpr uint32_t CHECKPOINT_MODEL = 0x4c524744;
+
+    // Inverse of a symmetric positive definite matrix from its Cholesky factor
+    static vector<vector<double> > inverse_from_cholesky(const vector<vector<double> > &L) {
+        size_t p = L.size();
+        vector<vector<double> > identity(p, vector<double>(p, 0.0));
+        for (size_t i = 0; i < p; i++) {
+            identity[i][i] = 1.0;
+        }
+        return LinearAlgebra::cholesky_solve(L, identity);
+    }
+
+    // Conjugate gradient on the normal equations (CGLS): min |A x - b| with x₀ = 0
+    template<typename Apply, typename ApplyTranspose>
+    static vector<double> cgls(Apply apply, ApplyTranspose apply_transpose, const vector<double> &b,
+                               size_t p, double tol, int max_iter, int &iterations) {
+        vector<double> x(p, 0.0);
+        vector<double> r = b;
+        vector<double> s = apply_transpose(r);
+        vector<double> direction = s;
+        double gamma = 0.0;
+        for (double value: s) {
+            gamma += value * value;
+        }
+        double stop = tol * sqrt(gamma);
+        iterations = 0;
+        while (iterations < max_iter && sqrt(gamma) > stop) {
+            // 1. Step along the direction: α = |s|² / |A p|²
+            vector<double> q = apply(direction);
+            double q_norm = 0.0;
+            for (double value: q) {
+                q_norm += value * value;
+            }
+            if (q_norm == 0.0) {
+                break;
+            }
+            double alpha = gamma / q_norm;
+            for (size_t j = 0; j < p; j++) {
+                x[j] += alpha * direction[j];
+            }
+            for (size_t i = 0; i < r.size(); i++) {
+                r[i] -= alpha * q[i];
+            }
+            iterations++;
+
+            // 2. New normal-equation residual s = Aᵀr and conjugate direction
+            s = apply_transpose(r);
+            double gamma_new = 0.0;
+            for (double value: s) {
+                gamma_new += value * value;
+            }
+            double beta = gamma_new / gamma;
+            for (size_t j = 0; j < p; j++) {
+                direction[j] = s[j] + beta * direction[j];
+            }
+            gamma = gamma_new;
+        }
+        return x;
+    }
+
+    // Scales v to unit norm in place and returns its former norm
+    static double normalize(vector<double> &v) {
+        double norm = 0.0;
+        for (double value: v) {
+            norm += value * value;
+        }
+        norm = sqrt(norm);
+        if (norm > 0.0) {
+            for (double &value: v) {
+                value /= norm;
+            }
+        }
+        return norm;
+    }
+
+    // LSQR (Paige & Saunders): Golub-Kahan bidiagonalization of A, min |A x - b| with x₀ = 0
+    template<typename Apply, typename ApplyTranspose>
+    static vector<double> lsqr(Apply apply, ApplyTranspose apply_transpose, const vector<double> &b,
+                               size_t p, double tol, int max_iter, int &iterations) {
+        vector<double> x(p, 0.0);
+        vector<double> u = b;
+        double beta = normalize(u);
+        double b_norm = beta;
+        vector<double> v = apply_transpose(u);
+        double alpha = normalize(v);
+        vector<double> w = v;
+        double phi_bar = beta;
+        double rho_bar = alpha;
+        double a_norm = 0.0;
+        iterations = 0;
+        while (iterations < max_iter && alpha * beta != 0.0) {
+            // 1. Next bidiagonalization step: β u = A v - α u, α v = Aᵀu - β v
+            vector<double> Av = apply(v);
+            for (size_t i = 0; i < u.size(); i++) {
+                u[i] = Av[i] - alpha * u[i];
+            }
+            beta = normalize(u);
+            vector<double> Atu = apply_transpose(u);
+            for (size_t j = 0; j < p; j++) {
+                v[j] = Atu[j] - beta * v[j];
+            }
+            a_norm = sqrt(a_norm * a_norm + alpha * alpha + beta * beta);
+            double alpha_next = normalize(v);
+
+            // 2. Plane rotation that eliminates β, then update x and w
+            double rho = sqrt(rho_bar * rho_bar + beta * beta);
+            double c = rho_bar / rho;
+            double sn = beta / rho;
+            double theta = sn * alpha_next;
+            rho_bar = -c * alpha_next;
+            double phi = c * phi_bar;
+            phi_bar = sn * phi_bar;
+            for (size_t j = 0; j < p; j++) {
+                x[j] += (phi / rho) * w[j];
+                w[j] = v[j] - (theta / rho) * w[j];
+            }
+            alpha = alpha_next;
+            iterations++;
+
+            // 3. Stop on a small residual |r| = φ̄ or a small |Aᵀr| = φ̄ α |c|
+            if (phi_bar <= tol * b_norm || alpha * fabs(c) <= tol * a_norm) {
+                break;
+            }
+        }
+        return x;
+    }
+
+    // Checks sample weights: one per row, non-negative, not all zero (empty means unit weights)
+    static void check_sample_weight(const vector<double> &sample_weight, size_t n) {
+        if (sample_weight.empty()) {
+            return;
+        }
+        if (sample_weight.size() != n) {
+            throw invalid_argument("sample_weight must have one weight per sample.");
+        }
+        double total = 0.0;
+        for (double weight: sample_weight) {
+            if (!(weight >= 0.0) || isinf(weight)) {
+                throw invalid_argument("sample_weight must be finite and non-negative.");
+            }
+            total += weight;
+        }
+        if (total <= 0.0) {
+            throw invalid_argument("sample_weight must have a positive sum.");
+        }
+    }
+
+    /**
+     * @brief Row kernels over vector-of-rows features, so the Matrix templates also serve fit(vector).
+     */
+    class RowView {
+    public:
+        explicit RowView(const vector<vector<double> > &rows) : rows_(rows) {}
+
+        double row_dot(size_t row, const double *w) const {
+            const vector<double> &x = rows_[row];
+            double sum = 0.0;
+            for (size_t j = 0; j < x.size(); j++) {
+                sum += x[j] * w[j];
+            }
+            return sum;
+        }
+
+        void row_axpy(size_t row, double a, double *w) const {
+            const vector<double> &x = rows_[row];
+            for (size_t j = 0; j < x.size(); j++) {
+                w[j] += a * x[j];
+            }
+        }
+
+        size_t size() const { return rows_.size(); }
+
+        size_t num_features() const { return rows_.empty() ? 0 : rows_[0].size(); }
+
+    private:
+        const vector<vector<double> > &rows_;
+    };
+
+    // Zᵀ W (t - Z v) over the rows z = [1, x] in one parallel pass, with t = y or t = 0 if y is null
+    template<typename Matrix>
+    static vector<double> normal_residual(const Matrix &X, const vector<double> *y, const vector<double> &v,
+                                          const vector<double> &weights) {
+        size_t p = v.size();
+        vector<vector<double> > partial(num_threads());
+        size_t chunks = parallel_for(X.size(), [&](size_t begin, size_t end, size_t chunk) {
+            partial[chunk].assign(p, 0.0);
+            double *acc = partial[chunk].data();
+            for (size_t i = begin; i < end; i++) {
+                double residual = (y == nullptr ? 0.0 : (*y)[i]) - v[0] - X.row_dot(i, v.data() + 1);
+                if (!weights.empty()) {
+                    residual *= weights[i];
+                }
+                acc[0] += residual;
+                X.row_axpy(i, residual, acc + 1);
+            }
+        });
+        vector<double> result(p, 0.0);
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            for (size_t j = 0; j < p; j++) {
+                result[j] += partial[chunk][j];
+            }
+        }
+        return result;
+    }
+
     LinearRegression::LinearRegression(double learning_rate, int epochs, const std::string &method) {
+        if (method != "normal" && method != "gradient" && method != "cg" && method != "lsqr" && method != "sketch") {
+            throw invalid_argument("method must be \"normal\", \"gradient\", \"cg\", \"lsqr\" or \"sketch\".");
+        }
         this->alpha_ = learning_rate;
         this->epochs_ = epochs;
         this->method_ = method;
     }
 
-    void LinearRegression::fit(const std::vector<std::vector<double> > &X_train, const std::vector<double> &y_train) {
+    void LinearRegression::fit(const std::vector<std::vector<double> > &X_train, const std::vector<double> &y_train,
+                               const vector<double> &sample_weight) {
+        if (X_train.empty() || X_train.size() != y_train.size()) {
+            throw invalid_argument("X and y must be non-empty and have the same size.");
+        }
+        check_sample_weight(sample_weight, X_train.size());
+        this->coefficients_.clear();
+        this->intercepts_.clear();
+        this->inverse_gram_.clear();
+        this->n_iter_ = 0;
         if (this->method_ == "gradient") {
-            fit_gradient_descent(X_train,y_train);
+            for (const vector<double> &row: X_train) {
+                if (row.size() != X_train[0].size()) {
+                    throw invalid_argument("All samples must have the same number of features.");
+                }
+            }
+            fit_gradient_descent(RowView(X_train), y_train, sample_weight);
         } else if (this->method_ == "normal") {
-            fit_normal_equation(X_train,y_train);
+            fit_normal_equation(X_train, y_train, sample_weight);
+        } else {
+            fit_matrix(DenseMatrix::from_rows(X_train), y_train, sample_weight);
         }
     }
 
+    void LinearRegression::fit(const DenseMatrix &X_train, const vector<double> &y_train,
+                               const vector<double> &sample_weight) {
+        fit_matrix(X_train, y_train, sample_weight);
+    }
 
-    void LinearRegression::fit_gradient_descent(const std::vector<std::vector<double> > &X,
-                                                const std::vector<double> &y) {
-        // number of datapoints
-        double m = X.size();
+    void LinearRegression::fit(const SparseMatrix &X_train, const vector<double> &y_train,
+                               const vector<double> &sample_weight) {
+        fit_matrix(X_train, y_train, sample_weight);
+    }
 
-        // number of features
-        double n = X[0].size();
+    template<typename Matrix>
+    void LinearRegression::fit_matrix(const Matrix &X, const vector<double> &y, const vector<double> &weights) {
+        if (this->method_ != "cg" && this->method_ != "lsqr" && this->method_ != "sketch") {
+            throw invalid_argument("Fitting a DenseMatrix or SparseMatrix requires the \"cg\", \"lsqr\" or \"sketch\" method.");
+        }
+        if (X.size() == 0 || y.size() != X.size()) {
+            throw invalid_argument("X and y must be non-empty and have the same size.");
+        }
+        check_sample_weight(weights, X.size());
+        this->coefficients_.clear();
+        this->intercepts_.clear();
+        this->inverse_gram_.clear();
+        this->n_iter_ = 0;
+        if (this->method_ == "sketch") {
+            fit_sketch(X, y, weights);
+        } else {
+            fit_iterative(X, y, weights);
+        }
+    }
 
-        // initializating bias and weight at 0
+    template<typename Matrix>
+    void LinearRegression::fit_iterative(const Matrix &X, const vector<double> &y, const vector<double> &weights) {
+        size_t n = X.size();
+        size_t d = X.num_features();
+
+        // 1. Weighted problem min |W^½ (y - Z θ)|: scale the targets and rows by √w
+        vector<double> root(weights.size());
+        vector<double> b = y;
+        double total_weight = static_cast<double>(n);
+        if (!weights.empty()) {
+            total_weight = 0.0;
+            for (size_t i = 0; i < n; i++) {
+                root[i] = sqrt(weights[i]);
+                b[i] *= root[i];
+                total_weight += weights[i];
+            }
+        }
+
+        // 2. Column scaling D of W^½ Z = W^½ [1, X]; the solvers work on A = W^½ Z D
+        vector<double> scale(d + 1, 1.0);
+        if (this->preconditioner_ == LeastSquaresPreconditioner::Jacobi) {
+            vector<double> norms = X.column_squared_norms(weights);
+            scale[0] = 1.0 / sqrt(total_weight);
+            for (size_t j = 0; j < d; j++) {
+                scale[j + 1] = norms[j] > 0.0 ? 1.0 / sqrt(norms[j]) : 1.0;
+            }
+        }
+
+        // 3. Products with A and Aᵀ, each one parallel pass over X (the ones column is implicit)
+        auto apply = [&](const vector<double> &v) {
+            vector<double> w(d);
+            for (size_t j = 0; j < d; j++) {
+                w[j] = scale[j + 1] * v[j + 1];
+            }
+            vector<double> result = X.multiply(w);
+            double intercept = scale[0] * v[0];
+            for (size_t i = 0; i < n; i++) {
+                result[i] += intercept;
+                if (!root.empty()) {
+                    result[i] *= root[i];
+                }
+            }
+            return result;
+        };
+        auto apply_transpose = [&](const vector<double> &u) {
+            vector<double> weighted = u;
+            for (size_t i = 0; i < root.size(); i++) {
+                weighted[i] *= root[i];
+            }
+            vector<double> product = X.multiply_transpose(weighted);
+            vector<double> result(d + 1);
+            double sum = 0.0;
+            for (double value: weighted) {
+                sum += value;
+            }
+            result[0] = scale[0] * sum;
+            for (size_t j = 0; j < d; j++) {
+                result[j + 1] = scale[j + 1] * product[j];
+            }
+            return result;
+        };
+
+        // 4. Solve and undo the scaling: θ = D x
+        vector<double> theta = this->method_ == "cg"
+                                   ? cgls(apply, apply_transpose, b, d + 1, this->tolerance_, this->epochs_, this->n_iter_)
+                                   : lsqr(apply, apply_transpose, b, d + 1, this->tolerance_, this->epochs_, this->n_iter_);
+        for (size_t j = 0; j <= d; j++) {
+            theta[j] *= scale[j];
+        }
+        set_parameters(theta);
+    }
+
+    template<typename Matrix>
+    void LinearRegression::fit_sketch(const Matrix &X, const vector<double> &y, const vector<double> &weights) {
+        size_t n = X.size();
+        size_t p = X.num_features() + 1;
+        size_t m = this->sketch_size_ > 0 ? this->sketch_size_ : SKETCH_FACTOR * p;
+        size_t width = p + 1;
+
+        // 1. One parallel pass: CountSketch S of the rows √w [1, x, y] (each row goes to one
+        //    bucket with a random sign), plus ZᵀWy for the stopping test
+        vector<vector<double> > partial_sketch(num_threads());
+        vector<vector<double> > partial_rhs(num_threads());
+        size_t chunks = parallel_for(n, [&](size_t begin, size_t end, size_t chunk) {
+            vector<double> &sketch = partial_sketch[chunk];
+            vector<double> &rhs = partial_rhs[chunk];
+            sketch.assign(m * width, 0.0);
+            rhs.assign(p, 0.0);
+            for (size_t i = begin; i < end; i++) {
+                uint64_t bits = CounterRng::at(this->sketch_seed_, i);
+                double weight = weights.empty() ? 1.0 : weights[i];
+                double sign = (bits >> 63) != 0 ? -sqrt(weight) : sqrt(weight);
+                double *bucket = sketch.data() + (bits % m) * width;
+                bucket[0] += sign;
+                X.row_axpy(i, sign, bucket + 1);
+                bucket[p] += sign * y[i];
+                rhs[0] += weight * y[i];
+                X.row_axpy(i, weight * y[i], rhs.data() + 1);
+            }
+        });
+        vector<vector<double> > sketch(m, vector<double>(width, 0.0));
+        vector<double> rhs(p, 0.0);
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            const double *values = partial_sketch[chunk].data();
+            for (size_t b = 0; b < m; b++) {
+                for (size_t j = 0; j < width; j++) {
+                    sketch[b][j] += values[b * width + j];
+                }
+            }
+            for (size_t j = 0; j < p; j++) {
+                rhs[j] += partial_rhs[chunk][j];
+            }
+        }
+        partial_sketch.clear();
+
+        // 2. Exact solve of the small sketched system (SZ)ᵀ(SZ) θ = (SZ)ᵀ(Sy)
+        vector<vector<double> > cross = LinearAlgebra::matmul_transpose_a(sketch, sketch);
+        vector<vector<double> > gram(p, vector<double>(p));
+        vector<double> sketched_rhs(p);
+        for (size_t a = 0; a < p; a++) {
+            copy(cross[a].begin(), cross[a].begin() + p, gram[a].begin());
+            sketched_rhs[a] = cross[a][p];
+        }
+        vector<vector<double> > L = LinearAlgebra::cholesky_jittered(move(gram), 1);
+        vector<double> theta = LinearAlgebra::cholesky_solve(L, sketched_rhs);
+
+        // 3. Refinement: CG on ZᵀWZ θ = ZᵀWy preconditioned by the sketched Gram matrix,
+        //    one pass over the data per step
+        if (this->epochs_ > 0) {
+            double rhs_norm = 0.0;
+            for (double value: rhs) {
+                rhs_norm += value * value;
+            }
+            double stop = this->tolerance_ * sqrt(rhs_norm);
+            vector<double> residual = normal_residual(X, &y, theta, weights);
+            vector<double> preconditioned = LinearAlgebra::cholesky_solve(L, residual);
+            vector<double> direction = preconditioned;
+            double rz = 0.0;
+            for (size_t j = 0; j < p; j++) {
+                rz += residual[j] * preconditioned[j];
+            }
+            while (this->n_iter_ < this->epochs_) {
+                double residual_norm = 0.0;
+                for (double value: residual) {
+                    residual_norm += value * value;
+                }
+                if (sqrt(residual_norm) <= stop) {
+                    break;
+                }
+                vector<double> q = normal_residual(X, nullptr, direction, weights);   // -ZᵀWZ d
+                double curvature = 0.0;
+                for (size_t j = 0; j < p; j++) {
+                    curvature -= direction[j] * q[j];
+                }
+                if (curvature <= 0.0) {
+                    break;
+                }
+                double alpha = rz / curvature;
+                for (size_t j = 0; j < p; j++) {
+                    theta[j] += alpha * direction[j];
+                    residual[j] += alpha * q[j];
+                }
+                this->n_iter_++;
+
+                preconditioned = LinearAlgebra::cholesky_solve(L, residual);
+                double rz_new = 0.0;
+                for (size_t j = 0; j < p; j++) {
+                    rz_new += residual[j] * preconditioned[j];
+                }
+                for (size_t j = 0; j < p; j++) {
+                    direction[j] = preconditioned[j] + (rz_new / rz) * direction[j];
+                }
+                rz = rz_new;
+            }
+        }
+        set_parameters(theta);
+    }
+
+    void LinearRegression::set_sketch_size(size_t sketch_rows, uint64_t seed) {
+        this->sketch_size_ = sketch_rows;
+        this->sketch_seed_ = seed;
+    }
+
+    void LinearRegression::set_checkpoint(const string &path, int every_epochs) {
+        if (every_epochs < 1) {
+            throw invalid_argument("every_epochs must be at least 1.");
+        }
+        this->checkpoint_path_ = path;
+        this->checkpoint_every_ = every_epochs;
+    }
+
+    bool LinearRegression::resume_from(const string &path) {
+        optional<TrainingState> state = CheckpointWriter::read(path);
+        if (!state || state->model != CHECKPOINT_MODEL || state->parameters.empty()) {
+            this->resume_.reset();
+            return false;
+        }
+        this->resume_ = move(state);
+        return true;
+    }
+
+    void LinearRegression::set_tolerance(double tol) {
+        if (tol <= 0.0) {
+            throw invalid_argument("tol must be positive.");
+        }
+        this->tolerance_ = tol;
+    }
+
+
+    template<typename Matrix>
+    void LinearRegression::fit_gradient_descent(const Matrix &X, const vector<double> &y,
+                                                const vector<double> &weights) {
+        size_t m = X.size();
+        size_t n = X.num_features();
+        double total_weight = static_cast<double>(m);
+        if (!weights.empty()) {
+            total_weight = 0.0;
+            for (double weight: weights) {
+                total_weight += weight;
+            }
+        }
+
+        // initializating bias and weight at 0, or at the checkpoint being resumed ([b, w])
         double b = 0.0;
         vector<double> w(n, 0.0);
+        int first_epoch = 0;
+        if (this->resume_) {
+            if (this->resume_->parameters.size() != n + 1) {
+                throw invalid_argument("Checkpoint was written for a different number of features.");
+            }
+            b = this->resume_->parameters[0];
+            copy(this->resume_->parameters.begin() + 1, this->resume_->parameters.end(), w.begin());
+            first_epoch = static_cast<int>(min<uint64_t>(this->resume_->epoch, this->epochs_));
+            this->resume_.reset();
+        }
 
-        for (size_t e = 0; e < this->epochs_; e++) {
-            double b_updated = 0.0;
-            vector<double> w_updated(n, 0.0);
+        // Snapshots go to a background writer; the last one is waited for after training
+        optional<CheckpointWriter> writer;
+        if (!this->checkpoint_path_.empty()) {
+            writer.emplace(this->checkpoint_path_);
+        }
+        auto checkpoint = [&](int epochs_done) {
+            TrainingState state;
+            state.model = CHECKPOINT_MODEL;
+            state.epoch = static_cast<uint64_t>(epochs_done);
+            state.parameters.reserve(n + 1);
+            state.parameters.push_back(b);
+            state.parameters.insert(state.parameters.end(), w.begin(), w.end());
+            writer->submit(move(state));
+        };
 
-            for (size_t i = 0; i < m; i++) {
-                double pred = b;
-                for (size_t j = 0; j < n; j++) {
-                    pred += X[i][j] * w[i] + b;
+        vector<vector<double> > partial(num_threads());
+        for (int e = first_epoch; e < this->epochs_; e++) {
+            // 1. Gradient of the (weighted) mean squared error in one parallel pass: [d/db, d/dw]
+            size_t chunks = parallel_for(m, [&](size_t begin, size_t end, size_t chunk) {
+                partial[chunk].assign(n + 1, 0.0);
+                double *gradient = partial[chunk].data();
+                for (size_t i = begin; i < end; i++) {
+                    double pred = b + X.row_dot(i, w.data());
+                    double error = (pred - y[i]) * (weights.empty() ? 1.0 : weights[i]);
+                    gradient[0] += error;
+                    X.row_axpy(i, error, gradient + 1);
                 }
-                double error = y[i] - pred;
-                for (size_t j = 0; j < n; j++) {
-                    w_updated[j] += (-1) * X[i][j] * error / m;
+            });
+
+            // 2. Weights and bias update
+            vector<double> gradient(n + 1, 0.0);
+            for (size_t chunk = 0; chunk < chunks; chunk++) {
+                for (size_t j = 0; j <= n; j++) {
+                    gradient[j] += partial[chunk][j];
                 }
-                b_updated += (-1) * error / m;
             }
-
-            // Weights and bias update
-            for (size_t i = 0; i < n; i++) {
-                w[i] = w[i] - w_updated[i] * this->alpha_;
+            b -= this->alpha_ * gradient[0] / total_weight;
+            for (size_t j = 0; j < n; j++) {
+                w[j] -= this->alpha_ * gradient[j + 1] / total_weight;
+            }
+            if (writer && (e + 1) % this->checkpoint_every_ == 0 && e + 1 < this->epochs_) {
+                checkpoint(e + 1);
             }
-            b += b_updated - this->alpha_;
+        }
+        if (writer) {
+            checkpoint(this->epochs_);
         }
         //Class weights and bias update
         this->weights_ = w;
         this->bias_ = b;
+        if (writer && !writer->flush()) {
+            throw runtime_error("Could not write the final checkpoint to " + this->checkpoint_path_ + ".");
+        }
+    }
+
+    void LinearRegression::fit_normal_equation(const vector<vector<double> > &X, const vector<double> &y,
+                                               const vector<double> &weights) {
+        // One parallel pass: (weighted) normal equations of the rows z = [1, x]
+        GramBlock system = LinearAlgebra::augmented_gram(X, y, {}, 1, weights)[0];
+        solve_normal(RowView(X), y, weights, system.gram, system.rhs);
+    }
+
+    template<typename Matrix>
+    void LinearRegression::solve_normal(const Matrix &X, const vector<double> &y, const vector<double> &weights,
+                                        const vector<vector<double> > &gram, const vector<double> &rhs) {
+        // 1. Cholesky solve, with a tiny ridge on the weights if the Gram matrix is singular
+        vector<vector<double> > L = LinearAlgebra::cholesky_jittered(gram, 1);
+        vector<double> theta = LinearAlgebra::cholesky_solve(L, rhs);
+
+        // 2. Iterative refinement: the residual of the normal equations is recomputed from
+        //    the data in one pass, and the correction reuses the factorization
+        for (int step = 0; step < this->refinement_steps_; step++) {
+            vector<double> correction = LinearAlgebra::cholesky_solve(L, normal_residual(X, &y, theta, weights));
+            for (size_t j = 0; j < theta.size(); j++) {
+                theta[j] += correction[j];
+            }
+        }
+        set_parameters(theta);
+        this->inverse_gram_ = inverse_from_cholesky(L);
+    }
+
+    void LinearRegression::fit(const Float32Matrix &X_train, const vector<double> &y_train,
+                               const vector<double> &sample_weight) {
+        if (this->method_ != "normal" && this->method_ != "gradient") {
+            fit_matrix(X_train, y_train, sample_weight);
+            return;
+        }
+        if (X_train.size() == 0 || y_train.size() != X_train.size()) {
+            throw invalid_argument("X and y must be non-empty and have the same size.");
+        }
+        check_sample_weight(sample_weight, X_train.size());
+        this->coefficients_.clear();
+        this->intercepts_.clear();
+        this->inverse_gram_.clear();
+        this->n_iter_ = 0;
+        if (this->method_ == "gradient") {
+            fit_gradient_descent(X_train, y_train, sample_weight);
+        } else {
+            GramBlock system = LinearAlgebra::augmented_gram(X_train, y_train, sample_weight);
+            solve_normal(X_train, y_train, sample_weight, system.gram, system.rhs);
+        }
+    }
+
+    vector<double> LinearRegression::predict(const Float32Matrix &X_test) const {
+        return predict_matrix(X_test);
+    }
+
+    void LinearRegression::set_refinement_steps(int steps) {
+        if (steps < 0) {
+            throw invalid_argument("steps must be non-negative.");
+        }
+        this->refinement_steps_ = steps;
+    }
+
+    void LinearRegression::fit(const vector<vector<double> > &X_train, const vector<vector<double> > &Y_train) {
+        if (X_train.empty() || X_train.size() != Y_train.size() || X_train[0].empty()) {
+            throw invalid_argument("X and Y must be non-empty and have the same size.");
+        }
+        size_t n_targets = Y_train[0].size();
+        for (const vector<double> &row: Y_train) {
+            if (row.size() != n_targets) {
+                throw invalid_argument("All rows of Y must have the same number of targets.");
+            }
+        }
+
+        // 1. One parallel pass for ZᵀZ (z = [1, x]), factored once
+        vector<vector<double> > gram = LinearAlgebra::augmented_gram(X_train, {})[0].gram;
+        vector<vector<double> > L = LinearAlgebra::cholesky_jittered(move(gram), 1);
+
+        // 2. ZᵀY: column sums of Y on top of XᵀY (one matrix product)
+        vector<vector<double> > rhs = LinearAlgebra::matmul_transpose_a(X_train, Y_train);
+        vector<double> sums(n_targets, 0.0);
+        for (const vector<double> &row: Y_train) {
+            for (size_t t = 0; t < n_targets; t++) {
+                sums[t] += row[t];
+            }
+        }
+        rhs.insert(rhs.begin(), move(sums));
+
+        // 3. Every target in one blocked triangular solve
+        vector<vector<double> > theta = LinearAlgebra::cholesky_solve(L, rhs);
+        this->intercepts_ = move(theta[0]);
+        this->coefficients_.assign(make_move_iterator(theta.begin() + 1), make_move_iterator(theta.end()));
+        this->weights_.clear();
+        this->bias_ = 0.0;
+        this->inverse_gram_.clear();
+    }
+
+    double LinearRegression::predict(const vector<double> &sample) const {
+        if (this->weights_.empty()) {
+            throw logic_error("LinearRegression must be fitted before predict.");
+        }
+        if (sample.size() != this->weights_.size()) {
+            throw invalid_argument("Sample has the wrong number of features.");
+        }
+        double prediction = this->bias_;
+        for (size_t j = 0; j < sample.size(); j++) {
+            prediction += this->weights_[j] * sample[j];
+        }
+        return prediction;
+    }
+
+    vector<double> LinearRegression::predict(const vector<vector<double> > &X_test) const {
+        vector<double> predictions(X_test.size());
+        parallel_for(X_test.size(), [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                predictions[i] = predict(X_test[i]);
+            }
+        });
+        return predictions;
+    }
+
+    template<typename Matrix>
+    vector<double> LinearRegression::predict_matrix(const Matrix &X) const {
+        if (this->weights_.empty()) {
+            throw logic_error("LinearRegression must be fitted before predict.");
+        }
+        if (X.size() != 0 && X.num_features() != this->weights_.size()) {
+            throw invalid_argument("Sample must have the same number of features as the training data.");
+        }
+        vector<double> predictions = X.multiply(this->weights_);
+        for (double &value: predictions) {
+            value += this->bias_;
+        }
+        return predictions;
+    }
+
+    vector<double> LinearRegression::predict(const DenseMatrix &X_test) const {
+        return predict_matrix(X_test);
+    }
+
+    vector<double> LinearRegression::predict(const SparseMatrix &X_test) const {
+        return predict_matrix(X_test);
+    }
+
+    vector<vector<double> > LinearRegression::predict_multi(const vector<vector<double> > &X_test) const {
+        if (this->intercepts_.empty()) {
+            throw logic_error("LinearRegression must be fitted on a target matrix before predict_multi.");
+        }
+        size_t d = this->coefficients_.size();
+        for (const vector<double> &row: X_test) {
+            if (row.size() != d) {
+                throw invalid_argument("Sample must have the same number of features as the training data.");
+            }
+        }
+
+        // One GEMM for all targets, then the intercepts
+        vector<vector<double> > predictions = LinearAlgebra::matmul(X_test, this->coefficients_);
+        parallel_for(predictions.size(), [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                for (size_t t = 0; t < this->intercepts_.size(); t++) {
+                    predictions[i][t] += this->intercepts_[t];
+                }
+            }
+        });
+        return predictions;
+    }
+
+    vector<double> LinearRegression::parameters() const {
+        vector<double> theta(this->weights_.size() + 1);
+        theta[0] = this->bias_;
+        copy(this->weights_.begin(), this->weights_.end(), theta.begin() + 1);
+        return theta;
+    }
+
+    void LinearRegression::set_parameters(const vector<double> &theta) {
+        this->bias_ = theta[0];
+        this->weights_.assign(theta.begin() + 1, theta.end());
+    }
+
+    void LinearRegression::fold_scaler(const vector<double> &mean, const vector<double> &scale) {
+        bool multi_output = !this->intercepts_.empty();
+        if (this->weights_.empty() && !multi_output) {
+            throw logic_error("LinearRegression must be fitted before fold_scaler.");
+        }
+        size_t d = multi_output ? this->coefficients_.size() : this->weights_.size();
+        if (mean.size() != d || scale.size() != d) {
+            throw invalid_argument("mean and scale must have one value per feature.");
+        }
+        for (double value: scale) {
+            if (!(value > 0.0)) {
+                throw invalid_argument("scale must be positive.");
+            }
+        }
+
+        // 1. Single-output weights: w / scale, and the bias absorbs the mean shift
+        for (size_t j = 0; j < this->weights_.size(); j++) {
+            this->weights_[j] /= scale[j];
+            this->bias_ -= this->weights_[j] * mean[j];
+        }
+
+        // 2. Multi-output coefficients, same mapping per target column
+        for (size_t j = 0; j < this->coefficients_.size(); j++) {
+            for (size_t t = 0; t < this->intercepts_.size(); t++) {
+                this->coefficients_[j][t] /= scale[j];
+                this->intercepts_[t] -= this->coefficients_[j][t] * mean[j];
+            }
+        }
+
+        // 3. Inverse Gram: z_std = A z_raw with A = [1, 0; -mean/scale, diag(1/scale)],
+        //    so P_raw = Aᵀ P_std A
+        vector<vector<double> > &P = this->inverse_gram_;
+        if (P.size() == d + 1) {
+            size_t p = d + 1;
+            for (size_t a = 0; a < p; a++) {
+                // Columns: P A
+                double first = P[a][0];
+                for (size_t j = 0; j < d; j++) {
+                    first -= P[a][j + 1] * mean[j] / scale[j];
+                    P[a][j + 1] /= scale[j];
+                }
+                P[a][0] = first;
+            }
+            for (size_t j = 0; j < d; j++) {
+                // Rows: Aᵀ (P A)
+                for (size_t c = 0; c < p; c++) {
+                    P[0][c] -= P[j + 1][c] * mean[j] / scale[j];
+                }
+            }
+            for (size_t j = 0; j < d; j++) {
+                for (size_t c = 0; c < p; c++) {
+                    P[j + 1][c] /= scale[j];
+                }
+            }
+        }
+    }
+
+    void LinearRegression::fold_scaler(const StandardScaler &scaler) {
+        fold_scaler(scaler.get_mean(), scaler.get_scale());
+    }
+
+    // ==================== ONLINE UPDATES (RLS) ====================
+
+    void LinearRegression::set_forgetting_factor(double lambda) {
+        if (!(lambda > 0.0 && lambda <= 1.0)) {
+            throw invalid_argument("The forgetting factor must be in (0, 1].");
+        }
+        this->forgetting_ = lambda;
+    }
+
+    void LinearRegression::update(const vector<double> &x, double y) {
+        if (!this->weights_.empty() && x.size() != this->weights_.size()) {
+            throw invalid_argument("Sample has the wrong number of features.");
+        }
+        size_t p = x.size() + 1;
+        if (this->weights_.empty()) {
+            this->weights_.assign(x.size(), 0.0);
+            this->bias_ = 0.0;
+        }
+        if (this->inverse_gram_.size() != p) {
+            this->inverse_gram_.assign(p, vector<double>(p, 0.0));
+            for (size_t a = 0; a < p; a++) {
+                this->inverse_gram_[a][a] = RLS_INITIAL_SCALE;
+            }
+        }
+        vector<vector<double> > &P = this->inverse_gram_;
+        double lambda = this->forgetting_;
+
+        // Sherman–Morrison: u = P z, k = u / (λ + zᵀu), θ += k e, P = (P - k uᵀ) / λ
+        vector<double> z(p, 1.0);
+        copy(x.begin(), x.end(), z.begin() + 1);
+        vector<double> u(p, 0.0);
+        for (size_t a = 0; a < p; a++) {
+            const double *row = P[a].data();
+            for (size_t b = 0; b < p; b++) {
+                u[a] += row[b] * z[b];
+            }
+        }
+        double denominator = lambda;
+        double error = y - this->bias_;
+        for (size_t a = 0; a < p; a++) {
+            denominator += z[a] * u[a];
+        }
+        for (size_t j = 0; j < x.size(); j++) {
+            error -= this->weights_[j] * x[j];
+        }
+        this->bias_ += u[0] / denominator * error;
+        for (size_t j = 0; j < x.size(); j++) {
+            this->weights_[j] += u[j + 1] / denominator * error;
+        }
+        for (size_t a = 0; a < p; a++) {
+            double *row = P[a].data();
+            double scale = u[a] / denominator;
+            for (size_t b = 0; b < p; b++) {
+                row[b] = (row[b] - scale * u[b]) / lambda;
+            }
+        }
+    }
+
+    void LinearRegression::update_batch(const vector<vector<double> > &X, const vector<double> &y) {
+        if (X.size() != y.size()) {
+            throw invalid_argument("X and y must have the same size.");
+        }
+        if (X.empty()) {
+            return;
+        }
+        size_t d = this->weights_.empty() ? X[0].size() : this->weights_.size();
+        for (const vector<double> &row: X) {
+            if (row.size() != d) {
+                throw invalid_argument("Sample has the wrong number of features.");
+            }
+        }
+        // Work on copies of θ and P, committed together at the end, so a failed block leaves the model untouched
+        size_t p = d + 1;
+        vector<double> theta = this->weights_.empty() ? vector<double>(p, 0.0) : parameters();
+        vector<vector<double> > P = this->inverse_gram_;
+        if (P.size() != p) {
+            // Fresh state, set up as update() does
+            P.assign(p, vector<double>(p, 0.0));
+            for (size_t a = 0; a < p; a++) {
+                P[a][a] = RLS_INITIAL_SCALE;
+            }
+        }
+        double lambda = this->forgetting_;
+
+        for (size_t block = 0; block < X.size(); block += RLS_BLOCK) {
+            size_t m = min(RLS_BLOCK, X.size() - block);
+            // Woodbury with past rows scaled by λ^m and row r of the block by λ^(m-1-r):
+            // P' = P / λ^m, U = P' Zᵀ, S = W⁻¹ + Z U, θ += U S⁻¹ (y - Zθ), P = P' - U S⁻¹ Uᵀ
+            double past_scale = pow(lambda, static_cast<double>(m));
+            vector<vector<double> > Z(m, vector<double>(p, 1.0));
+            for (size_t r = 0; r < m; r++) {
+                copy(X[block + r].begin(), X[block + r].end(), Z[r].begin() + 1);
+            }
+            vector<vector<double> > U(m, vector<double>(p, 0.0));   // Stored transposed: U[r] = P' z_r
+            for (size_t r = 0; r < m; r++) {
+                for (size_t a = 0; a < p; a++) {
+                    const double *row = P[a].data();
+                    double sum = 0.0;
+                    for (size_t b = 0; b < p; b++) {
+                        sum += row[b] * Z[r][b];
+                    }
+                    U[r][a] = sum / past_scale;
+                }
+            }
+            vector<vector<double> > S(m, vector<double>(m, 0.0));
+            vector<double> residual(m);
+            for (size_t r = 0; r < m; r++) {
+                for (size_t s = 0; s <= r; s++) {
+                    double sum = 0.0;
+                    for (size_t a = 0; a < p; a++) {
+                        sum += Z[r][a] * U[s][a];
+                    }
+                    S[r][s] = sum;
+                    S[s][r] = sum;
+                }
+                S[r][r] += pow(lambda, static_cast<double>(r) - static_cast<double>(m - 1));
+                residual[r] = y[block + r];
+                for (size_t a = 0; a < p; a++) {
+                    residual[r] -= Z[r][a] * theta[a];
+                }
+            }
+            vector<vector<double> > L = LinearAlgebra::cholesky_jittered(move(S));
+
+            // θ += U S⁻¹ e
+            vector<double> coefficients = LinearAlgebra::cholesky_solve(L, residual);
+            for (size_t r = 0; r < m; r++) {
+                for (size_t a = 0; a < p; a++) {
+                    theta[a] += U[r][a] * coefficients[r];
+                }
+            }
+
+            // P = P' - Vᵀ V with V = L⁻¹ Uᵀ (forward substitution on every column of Uᵀ)
+            vector<vector<double> > V(m, vector<double>(p));
+            for (size_t r = 0; r < m; r++) {
+                for (size_t a = 0; a < p; a++) {
+                    double value = U[r][a];
+                    for (size_t s = 0; s < r; s++) {
+                        value -= L[r][s] * V[s][a];
+                    }
+                    V[r][a] = value / L[r][r];
+                }
+            }
+            for (size_t a = 0; a < p; a++) {
+                for (size_t b = 0; b <= a; b++) {
+                    double sum = 0.0;
+                    for (size_t r = 0; r < m; r++) {
+                        sum += V[r][a] * V[r][b];
+                    }
+                    double value = P[a][b] / past_scale - sum;
+                    P[a][b] = value;
+                    P[b][a] = value;
+                }
+            }
+        }
+        set_parameters(theta);
+        this->inverse_gram_ = move(P);
     }
 }
@@ -0,0 +1,251 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/supervised/LinearSVC.h"
+#include "../../include/core/Metrics.h"
+#include "../../include/core/Parallel.h"
+#include "../../include/core/Random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    /**
+     * Dual coordinate descent with shrinking for one binary problem (labels ±1).
+     * Fills w and the weight of the constant feature, returns the number of epochs.
+     */
+    template<typename Matrix>
+    static int solve_dual(const Matrix &X, const vector<signed char> &y, double C, SVCLoss loss,
+                          double tol, int max_iter, double bias_feature, uint64_t seed,
+                          vector<double> &w, double &w_bias) {
+        const double INF = numeric_limits<double>::infinity();
+        size_t n = X.size();
+        // Squared hinge adds 1 / (2C) to the dual diagonal and removes the upper bound
+        double diag = loss == SVCLoss::SquaredHinge ? 0.5 / C : 0.0;
+        double upper = loss == SVCLoss::SquaredHinge ? INF : C;
+
+        w.assign(X.num_features(), 0.0);
+        w_bias = 0.0;
+        vector<double> alpha(n, 0.0);
+        vector<double> qd(n);
+        for (size_t i = 0; i < n; i++) {
+            qd[i] = X.row_squared_norm(i) + bias_feature * bias_feature + diag;
+        }
+
+        vector<size_t> index(n);
+        iota(index.begin(), index.end(), 0);
+        size_t active = n;
+        double pg_max_old = INF;
+        double pg_min_old = -INF;
+        CounterRng rng(seed);
+        int iter = 0;
+        while (iter < max_iter) {
+            // 1. Fresh random order over the active set
+            for (size_t s = 0; s + 1 < active; s++) {
+                swap(index[s], index[s + rng.uniform_index(active - s)]);
+            }
+
+            // 2. One closed-form update per active sample, shrinking those stuck at a bound
+            double pg_max = -INF;
+            double pg_min = INF;
+            size_t s = 0;
+            while (s < active) {
+                size_t i = index[s];
+                double yi = y[i];
+                double G = yi * (X.row_dot(i, w.data()) + w_bias * bias_feature) - 1.0 + alpha[i] * diag;
+                double pg = 0.0;
+                if (alpha[i] == 0.0) {
+                    if (G > pg_max_old) {
+                        swap(index[s], index[--active]);
+                        continue;
+                    }
+                    pg = min(G, 0.0);
+                } else if (alpha[i] == upper) {
+                    if (G < pg_min_old) {
+                        swap(index[s], index[--active]);
+                        continue;
+                    }
+                    pg = max(G, 0.0);
+                } else {
+                    pg = G;
+                }
+                pg_max = max(pg_max, pg);
+                pg_min = min(pg_min, pg);
+                if (fabs(pg) > 1e-12 && qd[i] > 0.0) {
+                    double old_alpha = alpha[i];
+                    alpha[i] = min(max(old_alpha - G / qd[i], 0.0), upper);
+                    double delta = (alpha[i] - old_alpha) * yi;
+                    X.row_axpy(i, delta, w.data());
+                    w_bias += delta * bias_feature;
+                }
+                s++;
+            }
+            iter++;
+
+            // 3. Converged on the active set: stop only if no sample was shrunk
+            if (pg_max - pg_min <= tol) {
+                if (active == n) {
+                    break;
+                }
+                active = n;
+                pg_max_old = INF;
+                pg_min_old = -INF;
+                continue;
+            }
+            pg_max_old = pg_max <= 0.0 ? INF : pg_max;
+            pg_min_old = pg_min >= 0.0 ? -INF : pg_min;
+        }
+        return iter;
+    }
+
+    LinearSVC::LinearSVC(double C, SVCLoss loss, double tol, int max_iter, bool fit_intercept,
+                         double intercept_scaling, uint64_t seed) {
+        if (C <= 0.0 || tol <= 0.0 || intercept_scaling <= 0.0) {
+            throw invalid_argument("C, tol and intercept_scaling must be positive.");
+        }
+        this->C_ = C;
+        this->loss_ = loss;
+        this->tol_ = tol;
+        this->max_iter_ = max_iter;
+        this->fit_intercept_ = fit_intercept;
+        this->intercept_scaling_ = intercept_scaling;
+        this->seed_ = seed;
+    }
+
+    template<typename Matrix>
+    void LinearSVC::fit_matrix(const Matrix &X, const vector<int> &labels) {
+        if (X.size() != labels.size()) {
+            throw invalid_argument("X and labels must have the same size.");
+        }
+        if (X.size() == 0) {
+            throw invalid_argument("Cannot fit LinearSVC on an empty dataset.");
+        }
+        vector<int> classes = labels;
+        sort(classes.begin(), classes.end());
+        classes.erase(unique(classes.begin(), classes.end()), classes.end());
+        if (classes.size() < 2) {
+            throw invalid_argument("LinearSVC needs at least two classes.");
+        }
+
+        // One binary problem for two classes (second class positive), one-vs-rest otherwise
+        size_t problems = classes.size() == 2 ? 1 : classes.size();
+        double bias_feature = this->fit_intercept_ ? this->intercept_scaling_ : 0.0;
+        vector<vector<double> > weights(problems);
+        vector<double> bias(problems, 0.0);
+        vector<int> iterations(problems, 0);
+        parallel_for(problems, [&](size_t begin, size_t end, size_t) {
+            vector<signed char> y(labels.size());
+            for (size_t p = begin; p < end; p++) {
+                int positive = classes[problems == 1 ? 1 : p];
+                for (size_t i = 0; i < labels.size(); i++) {
+                    y[i] = labels[i] == positive ? 1 : -1;
+                }
+                double w_bias = 0.0;
+                iterations[p] = solve_dual(X, y, this->C_, this->loss_, this->tol_, this->max_iter_,
+                                           bias_feature, CounterRng::at(this->seed_, p), weights[p], w_bias);
+                bias[p] = w_bias * bias_feature;
+            }
+        }, 1);
+
+        this->classes_ = move(classes);
+        this->weights_ = move(weights);
+        this->bias_ = move(bias);
+        this->n_iter_ = *max_element(iterations.begin(), iterations.end());
+    }
+
+    void LinearSVC::fit(const Dataset &dataset) {
+        fit_matrix(DenseMatrix::from_rows(dataset.get_features()), dataset.get_labels());
+    }
+
+    void LinearSVC::fit(const DenseMatrix &X, const vector<int> &labels) {
+        fit_matrix(X, labels);
+    }
+
+    void LinearSVC::fit(const SparseMatrix &X, const vector<int> &labels) {
+        fit_matrix(X, labels);
+    }
+
+    template<typename Matrix>
+    vector<double> LinearSVC::decision_matrix(const Matrix &X) const {
+        if (this->classes_.empty()) {
+            throw logic_error("LinearSVC must be fitted before predict.");
+        }
+        if (X.size() != 0 && X.num_features() != this->weights_[0].size()) {
+            throw invalid_argument("Samples have the wrong number of features.");
+        }
+        size_t problems = this->weights_.size();
+        vector<double> scores(X.size() * problems);
+        parallel_for(X.size(), [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                for (size_t p = 0; p < problems; p++) {
+                    scores[i * problems + p] = X.row_dot(i, this->weights_[p].data()) + this->bias_[p];
+                }
+            }
+        });
+        return scores;
+    }
+
+    vector<double> LinearSVC::decision_function(const DenseMatrix &X) const {
+        return decision_matrix(X);
+    }
+
+    vector<double> LinearSVC::decision_function(const SparseMatrix &X) const {
+        return decision_matrix(X);
+    }
+
+    vector<int> LinearSVC::scores_to_labels(const vector<double> &scores) const {
+        size_t problems = this->weights_.size();
+        vector<int> predicted_labels(scores.size() / problems);
+        for (size_t i = 0; i < predicted_labels.size(); i++) {
+            const double *s = scores.data() + i * problems;
+            if (problems == 1) {
+                predicted_labels[i] = this->classes_[s[0] > 0.0 ? 1 : 0];
+            } else {
+                predicted_labels[i] = this->classes_[max_element(s, s + problems) - s];
+            }
+        }
+        return predicted_labels;
+    }
+
+    int LinearSVC::predict(const vector<double> &sample) const {
+        if (this->classes_.empty()) {
+            throw logic_error("LinearSVC must be fitted before predict.");
+        }
+        if (sample.size() != this->weights_[0].size()) {
+            throw invalid_argument("Sample has the wrong number of features.");
+        }
+        vector<double> scores(this->weights_.size());
+        for (size_t p = 0; p < scores.size(); p++) {
+            scores[p] = this->bias_[p];
+            for (size_t j = 0; j < sample.size(); j++) {
+                scores[p] += this->weights_[p][j] * sample[j];
+            }
+        }
+        return scores_to_labels(scores)[0];
+    }
+
+    vector<int> LinearSVC::predict(const vector<vector<double> > &samples) const {
+        return predict(DenseMatrix::from_rows(samples));
+    }
+
+    vector<int> LinearSVC::predict(const DenseMatrix &X) const {
+        return scores_to_labels(decision_matrix(X));
+    }
+
+    vector<int> LinearSVC::predict(const SparseMatrix &X) const {
+        return scores_to_labels(decision_matrix(X));
+    }
+
+    double LinearSVC::score(const Dataset &test_dataset) const {
+        const vector<int> &y_test = test_dataset.get_labels();
+        if (y_test.empty()) {
+            return 0.0;
+        }
+        return Metrics::accuracy(y_test, predict(test_dataset.get_features()));
+    }
+}
@@ -0,0 +1,427 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/supervised/NaiveBayes.h"
+#include "../../include/core/Metrics.h"
+#include "../../include/core/Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    static constexpr double TWO_PI = 6.283185307179586;
+    // Smallest multinomial smoothing: keeps log(count + alpha) finite for features unseen in a class
+    static constexpr double MIN_ALPHA = 1e-10;
+
+    // Distinct labels of a batch (sorted) and the index of each sample's label among them
+    static vector<int> batch_classes(const vector<int> &labels, vector<size_t> &index) {
+        vector<int> classes = labels;
+        sort(classes.begin(), classes.end());
+        classes.erase(unique(classes.begin(), classes.end()), classes.end());
+        index.resize(labels.size());
+        for (size_t i = 0; i < labels.size(); i++) {
+            index[i] = lower_bound(classes.begin(), classes.end(), labels[i]) - classes.begin();
+        }
+        return classes;
+    }
+
+    // Moves per-class rows of width d to their new class slots after merge_classes()
+    static void remap_rows(vector<double> &rows, const vector<size_t> &old_to_new, size_t n_classes, size_t d) {
+        vector<double> remapped(n_classes * d, 0.0);
+        for (size_t c = 0; c < old_to_new.size(); c++) {
+            copy(rows.begin() + c * d, rows.begin() + (c + 1) * d, remapped.begin() + old_to_new[c] * d);
+        }
+        rows = move(remapped);
+    }
+
+    // Validates a batch and returns its number of features
+    static size_t check_batch(const vector<vector<double> > &X, const vector<int> &labels, size_t n_features) {
+        if (X.size() != labels.size()) {
+            throw invalid_argument("X and labels must have the same size.");
+        }
+        size_t d = X.empty() ? n_features : X[0].size();
+        if (n_features != 0 && d != n_features) {
+            throw invalid_argument("The number of features differs from the fitted model.");
+        }
+        for (const vector<double> &row: X) {
+            if (row.size() != d) {
+                throw invalid_argument("All samples must have the same number of features.");
+            }
+        }
+        return d;
+    }
+
+    // ==================== SHARED ENGINE ====================
+
+    vector<size_t> NaiveBayes::merge_classes(const vector<int> &labels) {
+        vector<int> merged = this->classes_;
+        merged.insert(merged.end(), labels.begin(), labels.end());
+        sort(merged.begin(), merged.end());
+        merged.erase(unique(merged.begin(), merged.end()), merged.end());
+
+        vector<size_t> old_to_new(this->classes_.size());
+        vector<double> counts(merged.size(), 0.0);
+        for (size_t c = 0; c < this->classes_.size(); c++) {
+            old_to_new[c] = lower_bound(merged.begin(), merged.end(), this->classes_[c]) - merged.begin();
+            counts[old_to_new[c]] = this->class_counts_[c];
+        }
+        this->classes_ = move(merged);
+        this->class_counts_ = move(counts);
+        return old_to_new;
+    }
+
+    size_t NaiveBayes::class_index(int label) const {
+        return lower_bound(this->classes_.begin(), this->classes_.end(), label) - this->classes_.begin();
+    }
+
+    void NaiveBayes::joint_log_likelihood(const double *sample, double *scores) const {
+        size_t C = this->classes_.size();
+        copy(this->bias_.begin(), this->bias_.end(), scores);
+        // GEMV: scores += Wᵀ x (+ Qᵀ x²), weights contiguous over classes
+        for (size_t j = 0; j < this->n_features_; j++) {
+            double x = this->shift_.empty() ? sample[j] : sample[j] - this->shift_[j];
+            const double *w = this->linear_.data() + j * C;
+            if (this->quadratic_.empty()) {
+                for (size_t c = 0; c < C; c++) {
+                    scores[c] += x * w[c];
+                }
+            } else {
+                const double *q = this->quadratic_.data() + j * C;
+                for (size_t c = 0; c < C; c++) {
+                    scores[c] += x * (w[c] + x * q[c]);
+                }
+            }
+        }
+    }
+
+    vector<double> NaiveBayes::joint_log_likelihood(const vector<vector<double> > &samples) const {
+        if (this->classes_.empty()) {
+            throw logic_error("Naive Bayes must be fitted before predict.");
+        }
+        for (const vector<double> &sample: samples) {
+            if (sample.size() != this->n_features_) {
+                throw invalid_argument("Sample has the wrong number of features.");
+            }
+        }
+        size_t C = this->classes_.size();
+        vector<double> scores(samples.size() * C);
+        parallel_for(samples.size(), [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                joint_log_likelihood(samples[i].data(), scores.data() + i * C);
+            }
+        });
+        return scores;
+    }
+
+    vector<vector<double> > NaiveBayes::predict_proba(const vector<vector<double> > &samples) const {
+        vector<double> scores = joint_log_likelihood(samples);
+        size_t C = this->classes_.size();
+        vector<vector<double> > probabilities(samples.size(), vector<double>(C));
+        for (size_t i = 0; i < samples.size(); i++) {
+            // Log-sum-exp normalization
+            const double *s = scores.data() + i * C;
+            double max_score = *max_element(s, s + C);
+            double sum = 0.0;
+            for (size_t c = 0; c < C; c++) {
+                probabilities[i][c] = exp(s[c] - max_score);
+                sum += probabilities[i][c];
+            }
+            for (size_t c = 0; c < C; c++) {
+                probabilities[i][c] /= sum;
+            }
+        }
+        return probabilities;
+    }
+
+    vector<int> NaiveBayes::predict(const vector<vector<double> > &samples) const {
+        vector<double> scores = joint_log_likelihood(samples);
+        size_t C = this->classes_.size();
+        vector<int> predicted_labels(samples.size());
+        for (size_t i = 0; i < samples.size(); i++) {
+            const double *s = scores.data() + i * C;
+            predicted_labels[i] = this->classes_[max_element(s, s + C) - s];
+        }
+        return predicted_labels;
+    }
+
+    int NaiveBayes::predict(const vector<double> &sample) const {
+        if (this->classes_.empty()) {
+            throw logic_error("Naive Bayes must be fitted before predict.");
+        }
+        if (sample.size() != this->n_features_) {
+            throw invalid_argument("Sample has the wrong number of features.");
+        }
+        vector<double> scores(this->classes_.size());
+        joint_log_likelihood(sample.data(), scores.data());
+        return this->classes_[max_element(scores.begin(), scores.end()) - scores.begin()];
+    }
+
+    double NaiveBayes::score(const Dataset &test_dataset) const {
+        const vector<int> &y_test = test_dataset.get_labels();
+        if (y_test.empty()) {
+            return 0.0;
+        }
+        return Metrics::accuracy(y_test, predict(test_dataset.get_features()));
+    }
+
+    // ==================== GAUSSIAN ====================
+
+    // Chan et al. merge of (count, mean, M2) over d features into the first set
+    static void merge_moments(double &count, double *mean, double *m2,
+                              double other_count, const double *other_mean, const double *other_m2, size_t d) {
+        if (other_count == 0.0) {
+            return;
+        }
+        double total = count + other_count;
+        for (size_t j = 0; j < d; j++) {
+            double delta = other_mean[j] - mean[j];
+            m2[j] += other_m2[j] + delta * delta * count * other_count / total;
+            mean[j] += delta * other_count / total;
+        }
+        count = total;
+    }
+
+    GaussianNB::GaussianNB(double var_smoothing) {
+        if (var_smoothing < 0.0) {
+            throw invalid_argument("var_smoothing must be non-negative.");
+        }
+        this->var_smoothing_ = var_smoothing;
+    }
+
+    void GaussianNB::fit(const Dataset &dataset) {
+        if (dataset.size() == 0) {
+            throw invalid_argument("Cannot fit Naive Bayes on an empty dataset.");
+        }
+        this->classes_.clear();
+        this->class_counts_.clear();
+        this->n_features_ = 0;
+        this->means_.clear();
+        this->m2_.clear();
+        partial_fit(dataset.get_features(), dataset.get_labels());
+    }
+
+    void GaussianNB::partial_fit(const Dataset &dataset) {
+        partial_fit(dataset.get_features(), dataset.get_labels());
+    }
+
+    void GaussianNB::partial_fit(const vector<vector<double> > &X, const vector<int> &labels) {
+        size_t d = check_batch(X, labels, this->n_features_);
+        if (X.empty()) {
+            return;
+        }
+
+        // 1. One pass: Welford accumulators per chunk and per batch class
+        vector<size_t> index;
+        vector<int> classes = batch_classes(labels, index);
+        size_t B = classes.size();
+        vector<vector<double> > counts(num_threads());
+        vector<vector<double> > means(num_threads());
+        vector<vector<double> > m2s(num_threads());
+        size_t chunks = parallel_for(X.size(), [&](size_t begin, size_t end, size_t chunk) {
+            vector<double> &count = counts[chunk];
+            vector<double> &mean = means[chunk];
+            vector<double> &m2 = m2s[chunk];
+            count.assign(B, 0.0);
+            mean.assign(B * d, 0.0);
+            m2.assign(B * d, 0.0);
+            for (size_t i = begin; i < end; i++) {
+                size_t k = index[i];
+                double n = ++count[k];
+                double *mu = mean.data() + k * d;
+                double *s = m2.data() + k * d;
+                const double *x = X[i].data();
+                for (size_t j = 0; j < d; j++) {
+                    double delta = x[j] - mu[j];
+                    mu[j] += delta / n;
+                    s[j] += delta * (x[j] - mu[j]);
+                }
+            }
+        });
+
+        // 2. Register new classes, then merge every chunk into the model (Chan et al.)
+        vector<size_t> old_to_new = merge_classes(classes);
+        size_t C = this->classes_.size();
+        remap_rows(this->means_, old_to_new, C, d);
+        remap_rows(this->m2_, old_to_new, C, d);
+        this->n_features_ = d;
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            for (size_t k = 0; k < B; k++) {
+                size_t c = class_index(classes[k]);
+                merge_moments(this->class_counts_[c], this->means_.data() + c * d, this->m2_.data() + c * d,
+                              counts[chunk][k], means[chunk].data() + k * d, m2s[chunk].data() + k * d, d);
+            }
+        }
+        update_weights();
+    }
+
+    void GaussianNB::update_weights() {
+        size_t C = this->classes_.size();
+        size_t d = this->n_features_;
+
+        // 1. Overall moments: the smoothing scale and a shift that keeps x² terms well conditioned
+        double total = 0.0;
+        vector<double> mean(d, 0.0);
+        vector<double> m2(d, 0.0);
+        for (size_t c = 0; c < C; c++) {
+            merge_moments(total, mean.data(), m2.data(), this->class_counts_[c],
+                          this->means_.data() + c * d, this->m2_.data() + c * d, d);
+        }
+        double max_variance = 0.0;
+        for (size_t j = 0; j < d; j++) {
+            max_variance = max(max_variance, m2[j] / total);
+        }
+        this->epsilon_ = this->var_smoothing_ * (max_variance > 0.0 ? max_variance : 1.0);
+        this->shift_ = mean;
+
+        // 2. log P(c) - ½ Σ log(2π σ²) - ½ Σ (x - μ)² / σ², expanded in x
+        this->bias_.assign(C, 0.0);
+        this->linear_.assign(d * C, 0.0);
+        this->quadratic_.assign(d * C, 0.0);
+        for (size_t c = 0; c < C; c++) {
+            double count = this->class_counts_[c];
+            double bias = log(count / total);
+            for (size_t j = 0; j < d; j++) {
+                double variance = this->m2_[c * d + j] / count + this->epsilon_;
+                double mu = this->means_[c * d + j] - this->shift_[j];
+                this->linear_[j * C + c] = mu / variance;
+                this->quadratic_[j * C + c] = -0.5 / variance;
+                bias -= 0.5 * (log(TWO_PI * variance) + mu * mu / variance);
+            }
+            this->bias_[c] = bias;
+        }
+    }
+
+    vector<vector<double> > GaussianNB::get_means() const {
+        size_t d = this->n_features_;
+        vector<vector<double> > means(this->classes_.size());
+        for (size_t c = 0; c < means.size(); c++) {
+            means[c].assign(this->means_.begin() + c * d, this->means_.begin() + (c + 1) * d);
+        }
+        return means;
+    }
+
+    vector<vector<double> > GaussianNB::get_variances() const {
+        size_t d = this->n_features_;
+        vector<vector<double> > variances(this->classes_.size(), vector<double>(d));
+        for (size_t c = 0; c < variances.size(); c++) {
+            for (size_t j = 0; j < d; j++) {
+                variances[c][j] = this->m2_[c * d + j] / this->class_counts_[c] + this->epsilon_;
+            }
+        }
+        return variances;
+    }
+
+    // ==================== MULTINOMIAL ====================
+
+    MultinomialNB::MultinomialNB(double alpha) {
+        if (!(alpha >= 0.0)) {
+            throw invalid_argument("alpha must be non-negative.");
+        }
+        this->alpha_ = max(alpha, MIN_ALPHA);
+    }
+
+    void MultinomialNB::fit(const Dataset &dataset) {
+        if (dataset.size() == 0) {
+            throw invalid_argument("Cannot fit Naive Bayes on an empty dataset.");
+        }
+        this->classes_.clear();
+        this->class_counts_.clear();
+        this->n_features_ = 0;
+        this->feature_counts_.clear();
+        partial_fit(dataset.get_features(), dataset.get_labels());
+    }
+
+    void MultinomialNB::partial_fit(const Dataset &dataset) {
+        partial_fit(dataset.get_features(), dataset.get_labels());
+    }
+
+    void MultinomialNB::partial_fit(const vector<vector<double> > &X, const vector<int> &labels) {
+        size_t d = check_batch(X, labels, this->n_features_);
+        if (X.empty()) {
+            return;
+        }
+
+        // 1. One pass: per-chunk sample counts and feature totals per batch class
+        vector<size_t> index;
+        vector<int> classes = batch_classes(labels, index);
+        size_t B = classes.size();
+        vector<vector<double> > counts(num_threads());
+        vector<vector<double> > totals(num_threads());
+        vector<char> negative(num_threads(), 0);
+        size_t chunks = parallel_for(X.size(), [&](size_t begin, size_t end, size_t chunk) {
+            counts[chunk].assign(B, 0.0);
+            totals[chunk].assign(B * d, 0.0);
+            double min_value = 0.0;
+            for (size_t i = begin; i < end; i++) {
+                size_t k = index[i];
+                counts[chunk][k] += 1.0;
+                double *total = totals[chunk].data() + k * d;
+                const double *x = X[i].data();
+                for (size_t j = 0; j < d; j++) {
+                    total[j] += x[j];
+                    min_value = min(min_value, x[j]);
+                }
+            }
+            negative[chunk] = min_value < 0.0;
+        });
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            if (negative[chunk]) {
+                throw invalid_argument("MultinomialNB requires non-negative features.");
+            }
+        }
+
+        // 2. Register new classes, then add the chunk totals to the model
+        vector<size_t> old_to_new = merge_classes(classes);
+        remap_rows(this->feature_counts_, old_to_new, this->classes_.size(), d);
+        this->n_features_ = d;
+        for (size_t chunk = 0; chunk < chunks; chunk++) {
+            for (size_t k = 0; k < B; k++) {
+                size_t c = class_index(classes[k]);
+                this->class_counts_[c] += counts[chunk][k];
+                for (size_t j = 0; j < d; j++) {
+                    this->feature_counts_[c * d + j] += totals[chunk][k * d + j];
+                }
+            }
+        }
+        update_weights();
+    }
+
+    void MultinomialNB::update_weights() {
+        size_t C = this->classes_.size();
+        size_t d = this->n_features_;
+        double total = 0.0;
+        for (double count: this->class_counts_) {
+            total += count;
+        }
+
+        // log P(c) + Σ x_j log θ_cj, with θ_cj = (N_cj + α) / (N_c + α d)
+        this->bias_.assign(C, 0.0);
+        this->linear_.assign(d * C, 0.0);
+        this->quadratic_.clear();
+        this->shift_.clear();
+        for (size_t c = 0; c < C; c++) {
+            double class_total = 0.0;
+            for (size_t j = 0; j < d; j++) {
+                class_total += this->feature_counts_[c * d + j];
+            }
+            double log_denominator = log(class_total + this->alpha_ * d);
+            for (size_t j = 0; j < d; j++) {
+                this->linear_[j * C + c] = log(this->feature_counts_[c * d + j] + this->alpha_) - log_denominator;
+            }
+            this->bias_[c] = log(this->class_counts_[c] / total);
+        }
+    }
+
+    vector<vector<double> > MultinomialNB::get_feature_counts() const {
+        size_t d = this->n_features_;
+        vector<vector<double> > feature_counts(this->classes_.size());
+        for (size_t c = 0; c < feature_counts.size(); c++) {
+            feature_counts[c].assign(this->feature_counts_.begin() + c * d,
+                                     this->feature_counts_.begin() + (c + 1) * d);
+        }
+        return feature_counts;
+    }
+}
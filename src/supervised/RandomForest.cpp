@@ -0,0 +1,182 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/supervised/RandomForest.h"
+#include "../../include/core/Parallel.h"
+#include "../../include/core/Random.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    // Rows pushed through every tree together during batch prediction
+    static constexpr size_t PREDICT_BLOCK = 64;
+
+    RandomForest::RandomForest(int n_estimators, int max_depth, int max_features, int min_samples_leaf,
+                               bool bootstrap, int max_bins, int seed) {
+        this->n_estimators_ = n_estimators;
+        this->max_depth_ = max_depth;
+        this->max_features_ = max_features;
+        this->min_samples_leaf_ = min_samples_leaf;
+        this->bootstrap_ = bootstrap;
+        this->max_bins_ = max_bins;
+        this->seed_ = seed;
+    }
+
+    void RandomForest::grow_forest(const BinnedDataset &data, const vector<double> &targets, int n_classes,
+                                   int default_max_features) {
+        size_t n = data.size();
+        int max_features = this->max_features_ > 0 ? this->max_features_ : default_max_features;
+        this->trees_.assign(max(this->n_estimators_, 0), FlatTree());
+
+        // One tree per task; histograms stay serial inside a tree to avoid oversubscription
+        parallel_for(this->trees_.size(), [&](size_t begin, size_t end, size_t) {
+            vector<uint32_t> weights;
+            for (size_t t = begin; t < end; t++) {
+                CounterRng rng(CounterRng::at(static_cast<uint64_t>(this->seed_), t));
+                TreeGrowOptions options;
+                options.max_depth = this->max_depth_;
+                options.min_samples_leaf = this->min_samples_leaf_;
+                options.max_features = max_features;
+                options.parallel = false;
+
+                // Bootstrap sample as draw counts: no rows are copied
+                if (this->bootstrap_) {
+                    weights.assign(n, 0);
+                    for (size_t i = 0; i < n; i++) {
+                        weights[rng.uniform_index(n)]++;
+                    }
+                    options.sample_weights = &weights;
+                }
+                options.seed = rng.next();
+                this->trees_[t] = DecisionTree::grow(data, targets, n_classes, options);
+            }
+        }, 1);
+    }
+
+    vector<double> RandomForest::predict_outputs(const vector<vector<double> > &X) const {
+        size_t n_outputs = this->trees_.empty() ? 1 : static_cast<size_t>(this->trees_[0].n_outputs);
+        vector<double> outputs(X.size() * n_outputs, 0.0);
+        if (this->trees_.empty()) {
+            return outputs;
+        }
+        double scale = 1.0 / this->trees_.size();
+
+        size_t n_blocks = (X.size() + PREDICT_BLOCK - 1) / PREDICT_BLOCK;
+        parallel_for(n_blocks, [&](size_t block_begin, size_t block_end, size_t) {
+            for (size_t block = block_begin; block < block_end; block++) {
+                size_t begin = block * PREDICT_BLOCK;
+                size_t end = min(X.size(), begin + PREDICT_BLOCK);
+                // Tree-major order: each tree is applied to the whole block
+                for (const FlatTree &tree: this->trees_) {
+                    for (size_t i = begin; i < end; i++) {
+                        const double *leaf = tree.predict_leaf(X[i]);
+                        double *out = outputs.data() + i * n_outputs;
+                        for (size_t o = 0; o < n_outputs; o++) {
+                            out[o] += leaf[o];
+                        }
+                    }
+                }
+                for (size_t i = begin * n_outputs; i < end * n_outputs; i++) {
+                    outputs[i] *= scale;
+                }
+            }
+        }, 1);
+        return outputs;
+    }
+
+    // ==================== CLASSIFIER ====================
+
+    RandomForestClassifier::RandomForestClassifier(int n_estimators, int max_depth, int max_features,
+                                                   int min_samples_leaf, bool bootstrap, int max_bins, int seed)
+        : RandomForest(n_estimators, max_depth, max_features, min_samples_leaf, bootstrap, max_bins, seed) {
+    }
+
+    void RandomForestClassifier::fit(const Dataset &dataset) {
+        if (dataset.size() == 0) {
+            throw invalid_argument("Cannot fit a random forest on an empty dataset.");
+        }
+        // 1. Map labels to class indices 0..n_classes-1
+        const vector<int> &labels = dataset.get_labels();
+        this->classes_ = labels;
+        sort(this->classes_.begin(), this->classes_.end());
+        this->classes_.erase(unique(this->classes_.begin(), this->classes_.end()), this->classes_.end());
+        vector<double> targets(labels.size());
+        for (size_t i = 0; i < labels.size(); i++) {
+            targets[i] = static_cast<double>(
+                lower_bound(this->classes_.begin(), this->classes_.end(), labels[i]) - this->classes_.begin());
+        }
+
+        // 2. Bin once, share the binned copy with every tree
+        BinnedDataset binned(dataset.get_features(), this->max_bins_);
+        int default_features = max(1, static_cast<int>(sqrt(static_cast<double>(dataset.num_features()))));
+        grow_forest(binned, targets, static_cast<int>(this->classes_.size()), default_features);
+    }
+
+    vector<vector<double> > RandomForestClassifier::predict_proba(const vector<vector<double> > &samples) const {
+        vector<double> outputs = predict_outputs(samples);
+        size_t k = this->classes_.size();
+        vector<vector<double> > probabilities(samples.size());
+        for (size_t i = 0; i < samples.size(); i++) {
+            probabilities[i].assign(outputs.begin() + i * k, outputs.begin() + (i + 1) * k);
+        }
+        return probabilities;
+    }
+
+    vector<int> RandomForestClassifier::predict(const vector<vector<double> > &samples) const {
+        vector<double> outputs = predict_outputs(samples);
+        size_t k = this->classes_.size();
+        vector<int> predicted_labels(samples.size());
+        for (size_t i = 0; i < samples.size(); i++) {
+            const double *proba = outputs.data() + i * k;
+            predicted_labels[i] = this->classes_[max_element(proba, proba + k) - proba];
+        }
+        return predicted_labels;
+    }
+
+    int RandomForestClassifier::predict(const vector<double> &sample) const {
+        return predict(vector<vector<double> >{sample})[0];
+    }
+
+    double RandomForestClassifier::score(const Dataset &test_dataset) const {
+        const vector<int> &y_test = test_dataset.get_labels();
+        if (y_test.empty()) {
+            return 0.0;
+        }
+        vector<int> y_pred = predict(test_dataset.get_features());
+        size_t correct = 0;
+        for (size_t i = 0; i < y_test.size(); i++) {
+            if (y_pred[i] == y_test[i]) {
+                correct++;
+            }
+        }
+        return static_cast<double>(correct) / y_test.size();
+    }
+
+    // ==================== REGRESSOR ====================
+
+    RandomForestRegressor::RandomForestRegressor(int n_estimators, int max_depth, int max_features,
+                                                 int min_samples_leaf, bool bootstrap, int max_bins, int seed)
+        : RandomForest(n_estimators, max_depth, max_features, min_samples_leaf, bootstrap, max_bins, seed) {
+    }
+
+    void RandomForestRegressor::fit(const vector<vector<double> > &X_train, const vector<double> &y_train) {
+        if (X_train.empty() || X_train.size() != y_train.size()) {
+            throw invalid_argument("X_train and y_train must be non-empty and have the same size.");
+        }
+        BinnedDataset binned(X_train, this->max_bins_);
+        int default_features = max(1, static_cast<int>(X_train[0].size() / 3));
+        grow_forest(binned, y_train, 0, default_features);
+    }
+
+    vector<double> RandomForestRegressor::predict(const vector<vector<double> > &X_test) const {
+        return predict_outputs(X_test);
+    }
+
+    double RandomForestRegressor::predict(const vector<double> &sample) const {
+        return predict_outputs(vector<vector<double> >{sample})[0];
+    }
+}
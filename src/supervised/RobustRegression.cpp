@@ -0,0 +1,144 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/supervised/RobustRegression.h"
+#include "../../include/core/Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    // MAD of Gaussian noise divided by this constant estimates its standard deviation
+    static constexpr double MAD_TO_SIGMA = 0.6745;
+
+    RobustRegression::RobustRegression(RobustLoss loss, double tuning, int max_iter, double tol,
+                                       const std::string &solver) {
+        if (tuning < 0.0) {
+            throw invalid_argument("tuning must be non-negative.");
+        }
+        if (max_iter < 1) {
+            throw invalid_argument("max_iter must be at least 1.");
+        }
+        if (tol <= 0.0) {
+            throw invalid_argument("tol must be positive.");
+        }
+        if (solver != "normal" && solver != "cg" && solver != "lsqr") {
+            throw invalid_argument("solver must be \"normal\", \"cg\" or \"lsqr\".");
+        }
+        this->loss_ = loss;
+        if (tuning > 0.0) {
+            this->tuning_ = tuning;
+        } else if (loss == RobustLoss::Huber) {
+            this->tuning_ = 1.345;
+        } else if (loss == RobustLoss::Bisquare) {
+            this->tuning_ = 4.685;
+        } else {
+            this->tuning_ = 2.385;
+        }
+        this->max_iter_ = max_iter;
+        this->tol_ = tol;
+        this->solver_ = solver;
+        this->model_ = LinearRegression(0.01, 1000, solver);
+    }
+
+    void RobustRegression::fit(const vector<vector<double> > &X, const vector<double> &y,
+                               const vector<double> &sample_weight) {
+        if (X.empty() || X.size() != y.size()) {
+            throw invalid_argument("X and y must be non-empty and have the same size.");
+        }
+        size_t n = X.size();
+
+        // The iterative solvers work on contiguous rows: copy them once for all refits
+        DenseMatrix dense;
+        if (this->solver_ != "normal") {
+            dense = DenseMatrix::from_rows(X);
+        }
+        auto refit = [&](const vector<double> &weights) {
+            if (this->solver_ == "normal") {
+                this->model_.fit(X, y, weights);
+            } else {
+                this->model_.fit(dense, y, weights);
+            }
+        };
+
+        // 1. Start from the (weighted) least-squares fit
+        this->fitted_ = false;
+        refit(sample_weight);
+        this->robust_weights_.assign(n, 1.0);
+        this->n_iter_ = 0;
+        vector<double> weights(n);
+        vector<double> residuals(n);
+        vector<double> deviations;
+        while (this->n_iter_ < this->max_iter_) {
+            // 2. Residuals and their robust scale (over rows with a positive sample weight)
+            vector<double> predictions = this->solver_ == "normal" ? this->model_.predict(X)
+                                                                   : this->model_.predict(dense);
+            deviations.clear();
+            for (size_t i = 0; i < n; i++) {
+                residuals[i] = y[i] - predictions[i];
+                if (sample_weight.empty() || sample_weight[i] > 0.0) {
+                    deviations.push_back(fabs(residuals[i]));
+                }
+            }
+            size_t middle = deviations.size() / 2;
+            nth_element(deviations.begin(), deviations.begin() + middle, deviations.end());
+            this->scale_ = deviations[middle] / MAD_TO_SIGMA;
+            if (this->scale_ == 0.0) {
+                break;  // At least half the rows are fitted exactly
+            }
+
+            // 3. Robust weights, combined with the sample weights
+            parallel_for(n, [&](size_t begin, size_t end, size_t) {
+                for (size_t i = begin; i < end; i++) {
+                    this->robust_weights_[i] = weight(residuals[i] / this->scale_);
+                    weights[i] = this->robust_weights_[i] * (sample_weight.empty() ? 1.0 : sample_weight[i]);
+                }
+            });
+
+            // 4. Weighted refit; stop once the parameters settle
+            vector<double> previous = this->model_.get_weights();
+            previous.push_back(this->model_.get_bias());
+            refit(weights);
+            this->n_iter_++;
+            double change = fabs(this->model_.get_bias() - previous.back());
+            double size = max(1.0, fabs(previous.back()));
+            for (size_t j = 0; j + 1 < previous.size(); j++) {
+                change = max(change, fabs(this->model_.get_weights()[j] - previous[j]));
+                size = max(size, fabs(previous[j]));
+            }
+            if (change <= this->tol_ * size) {
+                break;
+            }
+        }
+        this->fitted_ = true;
+    }
+
+    double RobustRegression::predict(const vector<double> &sample) const {
+        if (!this->fitted_) {
+            throw logic_error("RobustRegression must be fitted before predict.");
+        }
+        return this->model_.predict(sample);
+    }
+
+    vector<double> RobustRegression::predict(const vector<vector<double> > &X) const {
+        if (!this->fitted_) {
+            throw logic_error("RobustRegression must be fitted before predict.");
+        }
+        return this->model_.predict(X);
+    }
+
+    double RobustRegression::weight(double u) const {
+        double a = fabs(u) / this->tuning_;
+        switch (this->loss_) {
+            case RobustLoss::Huber:
+                return a <= 1.0 ? 1.0 : 1.0 / a;
+            case RobustLoss::Bisquare:
+                return a < 1.0 ? (1.0 - a * a) * (1.0 - a * a) : 0.0;
+            default:
+                return 1.0 / (1.0 + a * a);
+        }
+    }
+}
@@ -0,0 +1,130 @@
+//
+// Created by danie on 18/10/2026.
+//
+
+#include "../../include/unsupervised/LocalOutlierFactor.h"
+#include "../../include/core/Parallel.h"
+
+#include <algorithm>
+#include <stdexcept>
+using namespace std;
+
+namespace mlcpp {
+    // Added to the mean reachability distance so duplicated points keep a finite density
+    static constexpr double DENSITY_EPSILON = 1e-10;
+
+    LocalOutlierFactor::LocalOutlierFactor(int n_neighbors, double contamination, DistanceMetric distance)
+        : search_(distance) {
+        if (n_neighbors < 1) {
+            throw invalid_argument("n_neighbors must be at least 1.");
+        }
+        if (contamination <= 0.0 || contamination > 0.5) {
+            throw invalid_argument("contamination must be in (0, 0.5].");
+        }
+        this->k_ = n_neighbors;
+        this->contamination_ = contamination;
+    }
+
+    void LocalOutlierFactor::fit(const vector<vector<double> > &X) {
+        if (X.size() <= static_cast<size_t>(this->k_)) {
+            throw invalid_argument("LocalOutlierFactor needs more samples than n_neighbors.");
+        }
+        size_t n = X.size();
+
+        // 1. One all-pairs search: the k nearest other rows of every reference row
+        this->search_.fit(X);
+        vector<vector<Neighbor> > graph = this->search_.kneighbors_graph(this->k_);
+
+        // 2. k-distances, then densities (they read the k-distances of the neighbors)
+        this->k_distances_.assign(n, 0.0);
+        this->densities_.assign(n, 0.0);
+        this->scores_.assign(n, 0.0);
+        parallel_for(n, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                this->k_distances_[i] = graph[i].back().first;
+            }
+        });
+        parallel_for(n, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                this->densities_[i] = density(graph[i]);
+            }
+        });
+
+        // 3. LOF (reads the densities of the neighbors)
+        parallel_for(n, [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                this->scores_[i] = outlier_factor(graph[i], this->densities_[i]);
+            }
+        });
+
+        // 4. Threshold at the (1 - contamination) quantile of the reference scores
+        vector<double> sorted = this->scores_;
+        size_t position = min(n - 1, static_cast<size_t>((1.0 - this->contamination_) * n));
+        nth_element(sorted.begin(), sorted.begin() + position, sorted.end());
+        this->threshold_ = sorted[position];
+    }
+
+    void LocalOutlierFactor::fit(const Dataset &dataset) {
+        fit(dataset.get_features());
+    }
+
+    vector<int> LocalOutlierFactor::fit_predict(const vector<vector<double> > &X) {
+        fit(X);
+        vector<int> labels(this->scores_.size());
+        for (size_t i = 0; i < labels.size(); i++) {
+            labels[i] = this->scores_[i] > this->threshold_ ? -1 : 1;
+        }
+        return labels;
+    }
+
+    vector<double> LocalOutlierFactor::score_samples(const vector<vector<double> > &X) const {
+        if (this->scores_.empty()) {
+            throw logic_error("LocalOutlierFactor must be fitted before scoring.");
+        }
+        vector<vector<Neighbor> > neighbors = this->search_.kneighbors(X, this->k_);
+        vector<double> scores(X.size());
+        parallel_for(X.size(), [&](size_t begin, size_t end, size_t) {
+            for (size_t i = begin; i < end; i++) {
+                scores[i] = outlier_factor(neighbors[i], density(neighbors[i]));
+            }
+        });
+        return scores;
+    }
+
+    vector<double> LocalOutlierFactor::knn_scores(const vector<vector<double> > &X) const {
+        if (this->scores_.empty()) {
+            throw logic_error("LocalOutlierFactor must be fitted before scoring.");
+        }
+        vector<vector<Neighbor> > neighbors = this->search_.kneighbors(X, this->k_);
+        vector<double> scores(X.size());
+        for (size_t i = 0; i < X.size(); i++) {
+            scores[i] = neighbors[i].back().first;
+        }
+        return scores;
+    }
+
+    vector<int> LocalOutlierFactor::predict(const vector<vector<double> > &X) const {
+        vector<double> scores = score_samples(X);
+        vector<int> labels(scores.size());
+        for (size_t i = 0; i < labels.size(); i++) {
+            labels[i] = scores[i] > this->threshold_ ? -1 : 1;
+        }
+        return labels;
+    }
+
+    double LocalOutlierFactor::density(const vector<Neighbor> &neighbors) const {
+        double reach = 0.0;
+        for (const auto &[distance, o]: neighbors) {
+            reach += max(this->k_distances_[o], distance);
+        }
+        return 1.0 / (reach / neighbors.size() + DENSITY_EPSILON);
+    }
+
+    double LocalOutlierFactor::outlier_factor(const vector<Neighbor> &neighbors, double density) const {
+        double sum = 0.0;
+        for (const Neighbor &neighbor: neighbors) {
+            sum += this->densities_[neighbor.second];
+        }
+        return sum / neighbors.size() / density;
+    }
+}